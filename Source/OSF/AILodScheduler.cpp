@@ -0,0 +1,74 @@
+#include "AILodScheduler.h"
+
+#include "MatchSnapshot.h"
+
+void FAILodScheduler::Reset()
+{
+    NextDue.Reset();
+    Interval.Reset();
+    LastUpdated = LastDeferred = 0;
+}
+
+void FAILodScheduler::Select(const FMatchSnapshot& Snap, TConstArrayView<int32> Forced, double Now, int32 Budget,
+                             TArray<int32, TInlineAllocator<64>>& OutSelected)
+{
+    OutSelected.Reset();
+
+    // Roster changed: restart with phases spread over one full interval
+    if (NextDue.Num() != Snap.Num)
+    {
+        NextDue.SetNumUninitialized(Snap.Num);
+        Interval.SetNumUninitialized(Snap.Num);
+        for (int32 i = 0; i < Snap.Num; ++i)
+        {
+            NextDue[i] = Now + FullInterval * (double(i) / FMath::Max(Snap.Num, 1));
+            Interval[i] = FullInterval;
+        }
+    }
+
+    struct FDue { int32 Idx; double Priority; };
+    TArray<FDue, TInlineAllocator<64>> Due;
+
+    const float Near2 = NearRadius * NearRadius;
+    const float Mid2 = MidRadius * MidRadius;
+
+    for (int32 i = 0; i < Snap.Num; ++i)
+    {
+        if (!Snap.Valid[i]) continue;
+
+        const bool bForced = Forced.Contains(i);
+        float NewInterval;
+        if (bForced)             NewInterval = FullInterval;
+        else if (Snap.Human[i])  NewInterval = FarInterval;
+        else
+        {
+            const float DX = Snap.PosX[i] - Snap.BallPos.X;
+            const float DY = Snap.PosY[i] - Snap.BallPos.Y;
+            const float D2 = DX * DX + DY * DY;
+            NewInterval = (D2 <= Near2) ? FullInterval : (D2 <= Mid2) ? MidInterval : FarInterval;
+        }
+
+        // Promotion takes effect now, demotion at the next update
+        if (NewInterval < Interval[i]) NextDue[i] = FMath::Min(NextDue[i], Now + NewInterval);
+        Interval[i] = NewInterval;
+
+        if (Now < NextDue[i]) continue;
+
+        // Lateness in periods; forced players jump the queue
+        const double Priority = (Now - NextDue[i]) / Interval[i] + (bForced ? 1000.0 : 0.0);
+        Due.Add({ i, Priority });
+    }
+
+    Due.Sort([](const FDue& A, const FDue& B) { return A.Priority > B.Priority; });
+
+    const int32 Take = (Budget > 0) ? FMath::Min(Budget, Due.Num()) : Due.Num();
+    for (int32 k = 0; k < Take; ++k)
+    {
+        const int32 i = Due[k].Idx;
+        OutSelected.Add(i);
+        NextDue[i] = Now + Interval[i];
+    }
+
+    LastUpdated = Take;
+    LastDeferred = Due.Num() - Take;
+}
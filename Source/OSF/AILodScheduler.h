@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMatchSnapshot;
+
+/**
+ * Decides which footballers run their AI decision on a given frame.
+ *
+ * Each player gets an update interval from its tier: forced entries (keepers,
+ * the two chasers per team) run at FullInterval, the rest by distance to the
+ * ball; human-controlled players drop to FarInterval since AI only nudges them.
+ * Due players are served most-overdue first, at most Budget per frame, so the
+ * per-frame AI cost stays flat instead of spiking every 100 ms.
+ */
+struct OSF_API FAILodScheduler
+{
+    float FullInterval = 0.1f;
+    float MidInterval = 0.2f;
+    float FarInterval = 0.4f;
+
+    float NearRadius = 2500.f; // within: full rate
+    float MidRadius = 5000.f;  // within: mid rate, beyond: far rate
+
+    /** Fills OutSelected with snapshot indices to update now. Budget <= 0 means no cap. */
+    void Select(const FMatchSnapshot& Snap, TConstArrayView<int32> Forced, double Now, int32 Budget,
+                TArray<int32, TInlineAllocator<64>>& OutSelected);
+
+    void Reset();
+
+    /** Current interval for Idx (seconds); FullInterval if unknown. */
+    float GetInterval(int32 Idx) const { return Interval.IsValidIndex(Idx) ? Interval[Idx] : FullInterval; }
+
+    // ---------- Last frame ----------
+    int32 LastUpdated = 0;
+    int32 LastDeferred = 0;
+
+private:
+    TArray<double> NextDue;
+    TArray<float>  Interval;
+};
@@ -0,0 +1,196 @@
+#include "BallFlightComponent.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+#include "Goal.h"
+#include "OSFStats.h"
+#include "MatchRegistrySubsystem.h"
+
+namespace
+{
+    /** Capsule along the longest axis of a post/bar's bounds. */
+    FBallCapsule CapsuleFromBounds(const FBoxSphereBounds& Bounds)
+    {
+        const FVector E = Bounds.BoxExtent;
+        const int32 Axis = (E.X >= E.Y && E.X >= E.Z) ? 0 : (E.Y >= E.Z ? 1 : 2);
+
+        FBallCapsule Cap;
+        Cap.Radius = FMath::Min3(E.X, E.Y, E.Z);
+        FVector Half = FVector::ZeroVector;
+        Half[Axis] = FMath::Max(E[Axis] - Cap.Radius, 0.f);
+        Cap.A = Bounds.Origin - Half;
+        Cap.B = Bounds.Origin + Half;
+        return Cap;
+    }
+}
+
+UBallFlightComponent::UBallFlightComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UBallFlightComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    AActor* Owner = GetOwner();
+    Body = Owner ? Cast<UPrimitiveComponent>(Owner->GetRootComponent()) : nullptr;
+    if (!bDriveBall || !Body)
+    {
+        SetComponentTickEnabled(false);
+        return;
+    }
+
+    // Kinematic from here on; players reach it through possession, not by pushing
+    Body->SetSimulatePhysics(false);
+    Body->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+    bDriving = true;
+
+    // Flat pitch at the height under the ball
+    const FVector Start = Owner->GetActorLocation();
+    FHitResult Hit;
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(BallGround), false, Owner);
+    Model.GroundZ = GetWorld()->LineTraceSingleByChannel(Hit, Start + FVector(0, 0, 100.f), Start - FVector(0, 0, 5000.f), ECC_Visibility, Params)
+        ? Hit.ImpactPoint.Z : 0.f;
+
+    SyncModel();
+    if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this))
+    {
+        Registry->OnGoalsChanged.AddUObject(this, &UBallFlightComponent::RebuildGoalFrames);
+    }
+
+    ResetAt(Start);
+}
+
+void UBallFlightComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this)) Registry->OnGoalsChanged.RemoveAll(this);
+    Super::EndPlay(EndPlayReason);
+}
+
+void UBallFlightComponent::SyncModel()
+{
+    FBallParams& P = Model.Params;
+    P.Radius = Radius;
+    P.Mass = FMath::Max(Mass, 0.01f);
+    P.DragCoeff = DragCoeff;
+    P.MagnusCoeff = MagnusCoeff;
+    P.SpinDecay = SpinDecay;
+    P.Restitution = Restitution;
+    P.GroundFriction = GroundFriction;
+    P.RollingResistance = RollingResistance;
+    P.PostRestitution = PostRestitution;
+
+    RebuildGoalFrames();
+}
+
+void UBallFlightComponent::RebuildGoalFrames()
+{
+    Model.Obstacles.Reset();
+    const UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this);
+    if (!Registry) return;
+
+    for (const AGoal* Goal : Registry->GetGoals())
+    {
+        if (!IsValid(Goal)) continue;
+        for (const UStaticMeshComponent* Part : { Goal->LeftPost, Goal->RightPost, Goal->Crossbar })
+        {
+            if (Part) Model.Obstacles.Add(CapsuleFromBounds(Part->Bounds));
+        }
+    }
+}
+
+void UBallFlightComponent::ResetAt(const FVector& Location)
+{
+    // On the pitch at rest, or dropped from where it was put
+    Model.PlaceAtRest(State, Location);
+    if (Location.Z > State.Pos.Z + 1.f)
+    {
+        State.Pos = Location;
+        State.bRolling = false;
+    }
+    LastWrittenPos = Location;
+}
+
+// ---------------- Control ----------------
+void UBallFlightComponent::Hold(FVector Location)
+{
+    if (!bHeld)
+    {
+        bHeld = true;
+        HeldPrevPos = Location;
+    }
+    State.Pos = Location;
+    State.bRolling = false;
+    if (AActor* Owner = GetOwner()) Owner->SetActorLocation(Location, false, nullptr, ETeleportType::TeleportPhysics);
+    LastWrittenPos = Location;
+}
+
+void UBallFlightComponent::Release()
+{
+    bHeld = false;
+    State.Spin = FVector::ZeroVector;
+}
+
+void UBallFlightComponent::Launch(FVector Velocity, FVector Spin)
+{
+    bHeld = false;
+    State.Vel = Velocity;
+    State.Spin = Spin;
+    State.bRolling = false;
+}
+
+// ---------------- Tick ----------------
+void UBallFlightComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    OSF_SCOPE(BallFlight);
+
+    AActor* Owner = GetOwner();
+    if (!Owner || DeltaTime <= 0.f) return;
+
+    if (bHeld)
+    {
+        // Carried: velocity from the motion, so a release rolls on naturally
+        State.Vel = (State.Pos - HeldPrevPos) / DeltaTime;
+        HeldPrevPos = State.Pos;
+        if (Body) Body->ComponentVelocity = State.Vel;
+        return;
+    }
+
+    // Someone teleported the ball (restart, kick-off): start again at rest there
+    const FVector Current = Owner->GetActorLocation();
+    if (!Current.Equals(LastWrittenPos, 0.1f))
+    {
+        ResetAt(Current);
+    }
+
+    if (State.IsAtRest())
+    {
+        if (Body) Body->ComponentVelocity = FVector::ZeroVector;
+        return;
+    }
+
+    Model.Advance(State, DeltaTime);
+    WriteToOwner(DeltaTime);
+}
+
+void UBallFlightComponent::WriteToOwner(float DeltaTime)
+{
+    AActor* Owner = GetOwner();
+
+    const float Angle = State.Spin.Size() * DeltaTime;
+    if (Angle > KINDA_SMALL_NUMBER)
+    {
+        Owner->AddActorWorldRotation(FQuat(State.Spin.GetUnsafeNormal(), Angle), false, nullptr, ETeleportType::TeleportPhysics);
+    }
+    Owner->SetActorLocation(State.Pos, false, nullptr, ETeleportType::TeleportPhysics);
+    LastWrittenPos = Owner->GetActorLocation();
+
+    // GetVelocity() readers (snapshot, possession) see the model's velocity
+    if (Body) Body->ComponentVelocity = State.Vel;
+}
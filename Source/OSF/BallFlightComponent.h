@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Sim/BallFlight.h"
+#include "BallFlightComponent.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Moves the ball with FBallFlight instead of Chaos.
+ *
+ * At BeginPlay the owner's root stops simulating physics and becomes a
+ * kinematic body this component places every frame; the pitch height comes
+ * from one trace under the ball and the goal frames from the registered goals.
+ * While a player carries the ball, Hold() places it; Release() or Launch()
+ * hand it back to the flight model. A teleport from elsewhere (restarts,
+ * kick-off) is noticed and the ball starts again at rest there.
+ *
+ * The model is deterministic and cheap, so the AI can run GetModel().Predict
+ * from GetState() as often as it likes.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class OSF_API UBallFlightComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UBallFlightComponent();
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    // ---------- Control ----------
+    /** Carried: put the ball at Location this frame; its velocity follows from the motion. */
+    UFUNCTION(BlueprintCallable, Category = "Ball")
+    void Hold(FVector Location);
+
+    /** Stop carrying; the ball keeps the velocity it was carried with. */
+    UFUNCTION(BlueprintCallable, Category = "Ball")
+    void Release();
+
+    /** Kick: free flight from the current position. Spin in rad/s, world axes. */
+    UFUNCTION(BlueprintCallable, Category = "Ball")
+    void Launch(FVector Velocity, FVector Spin);
+
+    UFUNCTION(BlueprintPure, Category = "Ball")
+    bool IsHeld() const { return bHeld; }
+
+    /** False when bDriveBall is off or the owner has no primitive root; Chaos moves the ball then. */
+    bool IsDriving() const { return bDriving; }
+
+    UFUNCTION(BlueprintPure, Category = "Ball")
+    FVector GetBallVelocity() const { return State.Vel; }
+
+    const FBallState& GetState() const { return State; }
+    const FBallFlight& GetModel() const { return Model; }
+
+    /** Re-reads the tunables and goal frames into the model (after editing them live). */
+    void SyncModel();
+
+protected:
+    // ---------- Tunables (see FBallParams) ----------
+    UPROPERTY(EditAnywhere, Category = "Ball|Flight") float Radius = 11.f;
+    UPROPERTY(EditAnywhere, Category = "Ball|Flight") float Mass = 0.43f;
+    UPROPERTY(EditAnywhere, Category = "Ball|Flight") float DragCoeff = 0.25f;
+    UPROPERTY(EditAnywhere, Category = "Ball|Flight") float MagnusCoeff = 1.f;
+    UPROPERTY(EditAnywhere, Category = "Ball|Flight") float SpinDecay = 0.1f;
+    UPROPERTY(EditAnywhere, Category = "Ball|Pitch") float Restitution = 0.65f;
+    UPROPERTY(EditAnywhere, Category = "Ball|Pitch") float GroundFriction = 0.4f;
+    UPROPERTY(EditAnywhere, Category = "Ball|Pitch") float RollingResistance = 0.08f;
+    UPROPERTY(EditAnywhere, Category = "Ball|Pitch") float PostRestitution = 0.7f;
+
+    // Off: leave the ball to Chaos (the component does nothing)
+    UPROPERTY(EditAnywhere, Category = "Ball") bool bDriveBall = true;
+
+private:
+    void RebuildGoalFrames();
+    void ResetAt(const FVector& Location);
+    void WriteToOwner(float DeltaTime);
+
+    FBallFlight Model;
+    FBallState State;
+
+    UPROPERTY() UPrimitiveComponent* Body = nullptr;
+
+    bool bDriving = false;
+    bool bHeld = false;
+    FVector HeldPrevPos = FVector::ZeroVector;
+    FVector LastWrittenPos = FVector::ZeroVector;
+};
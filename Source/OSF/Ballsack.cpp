@@ -1,10 +1,25 @@
 #include "Ballsack.h"
 #include "Footballer.h"                     // to read TeamID
 #include "Components/PrimitiveComponent.h"
+#include "MatchRegistrySubsystem.h"
+#include "BallFlightComponent.h"
 
 ABallsack::ABallsack()
 {
 	PrimaryActorTick.bCanEverTick = false;
+	Flight = CreateDefaultSubobject<UBallFlightComponent>(TEXT("Flight"));
+}
+
+void ABallsack::BeginPlay()
+{
+	Super::BeginPlay();
+	if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this)) Registry->RegisterBall(this);
+}
+
+void ABallsack::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this)) Registry->UnregisterBall(this);
+	Super::EndPlay(EndPlayReason);
 }
 
 void ABallsack::SetPossessingFootballer(AFootballer* Footballer)
@@ -5,6 +5,7 @@
 #include "Ballsack.generated.h"
 
 class AFootballer;   // only pointer, so forward declaration is enough
+class UBallFlightComponent;
 
 UCLASS()
 class OSF_API ABallsack : public AActor
@@ -19,4 +20,12 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Ball")
 	void SetPossessingFootballer(AFootballer* Footballer);
+
+	/** Moves the ball instead of Chaos (turn off bDriveBall on it to go back to rigid-body physics). */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ball")
+	UBallFlightComponent* Flight = nullptr;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
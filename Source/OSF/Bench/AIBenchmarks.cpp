@@ -0,0 +1,488 @@
+#include "Bench/BenchHarness.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+
+#include "MatchSnapshot.h"
+#include "SpatialHashGrid.h"
+#include "MarkingAssignment.h"
+#include "Goal.h"
+#include "GameplayComponent.h"
+#include "Sim/MatchKernel.h"
+#include "Sim/PitchRules.h"
+#include "Sim/BallFlight.h"
+#include "Sim/InterceptSolver.h"
+#include "Sim/KickSolver.h"
+#include "Sim/PassEvaluator.h"
+#include "Sim/PitchControl.h"
+#include "Sim/FormationSet.h"
+#include "Sim/FormationZones.h"
+#include "Sim/ShotEvaluator.h"
+#include "Sim/MatchReplay.h"
+
+// Hot paths of the team AI and the ball/goal helpers, measured at several squad sizes.
+//
+//   osf.Bench [Filter=Separation] [Iterations=20000] [Tolerance=0.1] [WriteBaseline]
+//
+// Layouts are random but seeded per squad size, so every run measures the same positions.
+
+namespace
+{
+    constexpr int32 NumInputs = 1024; // cycled through by index; power of two
+    const int32 SquadSizes[] = { 11, 30, 100 };
+
+    /** Seeded players and ball on a default pitch, plus a pool of query points. */
+    struct FBenchLayout
+    {
+        FMatchKernel Kernel;
+        FMatchSnapshot Snap;
+        FSpatialHashGrid Grid;
+        TArray<FVector> Points;
+
+        FBenchLayout(int32 Squad, int32 Seed)
+        {
+            FRandomStream Rng(Seed);
+            FMatchKernel::MakeDefaultFormation(Kernel.Tactics.HalfLength, Kernel.Formation);
+
+            const FTacticParams& T = Kernel.Tactics;
+            auto RandomOnPitch = [&]()
+                {
+                    return FVector(Rng.FRandRange(-T.HalfLength, T.HalfLength), Rng.FRandRange(-T.HalfWidth, T.HalfWidth), 0.f);
+                };
+
+            Snap.InitPoints(Squad, Squad);
+            for (int32 i = 0; i < Snap.Num; ++i)
+            {
+                const FVector P = RandomOnPitch();
+                Snap.PosX[i] = P.X; Snap.PosY[i] = P.Y;
+                Snap.VelX[i] = Rng.FRandRange(-500.f, 500.f); Snap.VelY[i] = Rng.FRandRange(-500.f, 500.f);
+            }
+            Snap.BallPos = RandomOnPitch();
+
+            Grid.Build(Snap, T.FieldCentre,
+                FVector2D(T.HalfLength + T.SeparationRadius, T.HalfWidth + T.SeparationRadius), T.SeparationRadius);
+
+            // Slightly beyond the lines too, so clamping has work to do
+            Points.SetNumUninitialized(NumInputs);
+            for (FVector& P : Points) P = RandomOnPitch() * 1.1f;
+        }
+    };
+
+    void RunKernelCases(FBenchHarness& H)
+    {
+        // The evaluators aim with the default ball on a pitch at Z = 0, as the game mode configures them
+        FKickSolver Kicks;
+        Kicks.Configure(FBallParams(), 0.f);
+
+        for (int32 Squad : SquadSizes)
+        {
+            const FBenchLayout L(Squad, 1000 + Squad);
+            const FMatchKernel& K = L.Kernel;
+            const int32 Num = L.Snap.Num;
+
+            H.Run(TEXT("SeekArriveDirection"), Squad, [&](int32 i)
+                {
+                    FBenchHarness::Consume(K.SeekArriveDirection(L.Points[i & (NumInputs - 1)], L.Points[(i + 7) & (NumInputs - 1)]));
+                });
+
+            H.Run(TEXT("SeparationVector"), Squad, [&](int32 i)
+                {
+                    const int32 Idx = i % Num;
+                    FBenchHarness::Consume(K.SeparationVector(L.Snap, L.Grid, Idx, L.Snap.Team[Idx]));
+                });
+
+            H.Run(TEXT("ClampToField"), Squad, [&](int32 i)
+                {
+                    FBenchHarness::Consume(K.ClampToField(L.Points[i & (NumInputs - 1)]));
+                });
+
+            // Segments between query points; the ones ending past a line produce an event
+            const FPitchRules Rules;
+            H.Run(TEXT("PitchRules.Sweep"), Squad, [&](int32 i)
+                {
+                    FPitchEventInfo Event;
+                    FBenchHarness::Consume(Rules.Sweep(K.ClampToField(L.Points[i & (NumInputs - 1)]), L.Points[(i + 7) & (NumInputs - 1)], i & 1, Event));
+                });
+
+            H.Run(TEXT("ComputeKeeperTarget"), Squad, [&](int32 i)
+                {
+                    FVector Goal, Home, BoxMin, BoxMax;
+                    K.ComputeKeeperTarget(i & 1, L.Points[i & (NumInputs - 1)], Goal, Home, BoxMin, BoxMax);
+                    FBenchHarness::Consume(Home);
+                });
+
+            // Team 1's outfielders marking team 0: a cold solve per call, then warm-started while
+            // the attackers switch every 8 calls between the layout and one with half of them moved
+            TArray<int32> MarkerSlots;
+            for (int32 Slot = 1; Slot < Squad; ++Slot) MarkerSlots.Add(Slot);
+            FMatchSnapshot Shifted = L.Snap;
+            for (int32 j = Shifted.TeamBegin[0]; j < Shifted.TeamEnd[0]; j += 2) Shifted.PosY[j] += 300.f;
+
+            FMarkingAssignment Marking;
+            TArray<int32, TInlineAllocator<32>> MarkTargets;
+            H.Run(TEXT("Marking.Solve"), Squad, [&](int32 i)
+                {
+                    Marking.Reset();
+                    Marking.Solve(L.Snap, 1, MarkerSlots, MarkTargets);
+                    FBenchHarness::Consume(MarkTargets.GetData());
+                }, 500);
+
+            int32 WarmHits = 0, Solves = 0;
+            H.Run(TEXT("Marking.Solve.Warm"), Squad, [&](int32 i)
+                {
+                    Marking.Solve((i & 8) ? Shifted : L.Snap, 1, MarkerSlots, MarkTargets);
+                    WarmHits += Marking.bLastWarmHit ? 1 : 0;
+                    ++Solves;
+                    FBenchHarness::Consume(MarkTargets.GetData());
+                }, 2000);
+            UE_CLOG(Solves > 0, LogTemp, Display, TEXT("osf.Bench: Marking.Solve.Warm/%d kept the previous assignment on %.0f%% of solves"),
+                Squad, 100.0 * WarmHits / Solves);
+
+            // Formation homes: mirror, shift, clamp and ground per call against the compiled set
+            FMatchKernel Compiled = K;
+            FFormationSet Formations;
+            Formations.Add(TEXT("Default"), K.Formation);
+            Formations.Compile(K, Squad);
+            Compiled.Formations = &Formations;
+
+            H.Run(TEXT("FormationHome.Runtime"), Squad, [&](int32 i)
+                {
+                    FBenchHarness::Consume(K.Home(i & 1, (i >> 1) % Squad, static_cast<EFormationShape>(i % 3)));
+                });
+
+            H.Run(TEXT("FormationHome.Compiled"), Squad, [&](int32 i)
+                {
+                    FBenchHarness::Consume(Compiled.Home(i & 1, (i >> 1) % Squad, static_cast<EFormationShape>(i % 3)));
+                });
+
+            // Held shape for a ball position: the kernel's blend of two homes against one table sample
+            FFormationZones Zones;
+            Zones.Bake(K.Tactics, K.Formation, Squad, FFormationZoneBake());
+            H.Run(TEXT("ShapeTarget.Rules"), Squad, [&](int32 i)
+                {
+                    const int32 TeamID = i & 1;
+                    const int32 Slot = (i >> 1) % Squad;
+                    FBenchHarness::Consume(FMath::Lerp(K.Home(TeamID, Slot, EFormationShape::Base), K.Home(TeamID, Slot, EFormationShape::Attack), 1.f - K.Tactics.HomeWeight));
+                });
+
+            H.Run(TEXT("ShapeTarget.Zones"), Squad, [&](int32 i)
+                {
+                    FBenchHarness::Consume(Zones.Sample(K.Tactics, true, i & 1, (i >> 1) % Squad, L.Points[i & (NumInputs - 1)]));
+                });
+
+            // Closest-to-ball: packed linear scan and grid ring search
+            H.Run(TEXT("ClosestTo.Snapshot"), Squad, [&](int32 i)
+                {
+                    const int32 TeamID = i & 1;
+                    FBenchHarness::Consume(L.Snap.Nearest(L.Snap.TeamBegin[TeamID], L.Snap.TeamEnd[TeamID], L.Points[i & (NumInputs - 1)]));
+                });
+
+            H.Run(TEXT("ClosestTo.Grid"), Squad, [&](int32 i)
+                {
+                    FBenchHarness::Consume(L.Grid.Nearest(i & 1, L.Points[i & (NumInputs - 1)]));
+                });
+
+            // Whole-squad intercept solve against a 3 s rolling path at 15 Hz (one Think's worth)
+            FMatchSnapshot Snap = L.Snap;
+            FInterceptSolver Solver;
+            {
+                const FBallFlight Ball;
+                FBallState S;
+                Ball.PlaceAtRest(S, L.Snap.BallPos);
+                S.Vel = FVector(1500.f, 400.f, 0.f);
+                TArray<FBallState> Path;
+                Ball.Predict(S, 3.f, 1.f / 15.f, Path);
+                Solver.ResetPath(1.f / 15.f, 0.f);
+                for (const FBallState& P : Path) Solver.AddPathPoint(P.Pos);
+            }
+            H.Run(TEXT("Intercept.Solve"), Squad, [&](int32 i)
+                {
+                    Solver.Solve(Snap);
+                    FBenchHarness::Consume(Snap.InterceptT[Snap.InterceptOrder[0]]);
+                });
+
+            // Pitch control at the team-plan rate: everyone runs 0.1 s along their velocity (off the lines and back)
+            // per update; Full recomputes every cell, Incremental only those around players who drifted
+            FPitchControl Control;
+            Control.Configure(K.Tactics.FieldCentre, K.Tactics.HalfLength, K.Tactics.HalfWidth);
+            FMatchSnapshot Moving = L.Snap;
+            auto Advance = [&](float Dt = 0.1f)
+                {
+                    for (int32 j = 0; j < Moving.Num; ++j)
+                    {
+                        Moving.PosX[j] += Dt * Moving.VelX[j];
+                        Moving.PosY[j] += Dt * Moving.VelY[j];
+                        if (FMath::Abs(Moving.PosX[j]) > K.Tactics.HalfLength) Moving.VelX[j] = -Moving.VelX[j];
+                        if (FMath::Abs(Moving.PosY[j]) > K.Tactics.HalfWidth) Moving.VelY[j] = -Moving.VelY[j];
+                    }
+                };
+            H.Run(TEXT("PitchControl.Full"), Squad, [&](int32 i)
+                {
+                    Advance();
+                    Control.Invalidate();
+                    FBenchHarness::Consume(Control.Update(Moving));
+                }, 200);
+
+            int64 Cells = 0;
+            int32 Updates = 0;
+            H.Run(TEXT("PitchControl.Incremental"), Squad, [&](int32 i)
+                {
+                    Advance();
+                    Cells += Control.Update(Moving);
+                    ++Updates;
+                }, 2000);
+            UE_CLOG(Updates > 0, LogTemp, Display, TEXT("osf.Bench: PitchControl.Incremental/%d recomputed %.0f%% of %d cells per update"),
+                Squad, 100.0 * Cells / Updates / Control.GetNumCells(), Control.GetNumCells());
+
+            // One carrier's full pass search: every teammate plus two through balls each, against every opponent.
+            // As the game runs it, the best SolveTopK solved against the real ball; .Linear is the analytic part alone
+            FPassEvaluator Passes;
+            Passes.Kicks = &Kicks;
+            FPassEvaluator LinearPasses;
+            for (const FPassEvaluator* Eval : { &Passes, &LinearPasses })
+            {
+                H.Run(Eval == &Passes ? TEXT("Pass.Evaluate") : TEXT("Pass.Evaluate.Linear"), Squad, [&](int32 i)
+                    {
+                        FPassChoice Pass;
+                        const int32 Passer = i % Num;
+                        const FVector BallAt = L.Snap.GetPos(Passer) + FVector(0.f, 0.f, Kicks.GetBall().Radius);
+                        Eval->Evaluate(L.Snap, K.Tactics, Passer, BallAt, FVector::ZeroVector, Pass);
+                        FBenchHarness::Consume(Pass.Target);
+                    });
+            }
+
+            // Team 0 shooting at +X from around the box: table row, keeper and every blocker for 21 aim points,
+            // the best SolveTopK solved; .Linear without the solver
+            FShotEvaluator Shots;
+            Shots.Configure(FGoalMouth::FromLine(K.Tactics.FieldCentre + FVector(K.Tactics.HalfLength, 0.f, 0.f), 366.f, 244.f, K.Tactics.FieldCentre));
+            FShotEvaluator LinearShots = Shots;
+            Shots.Kicks = &Kicks;
+            for (const FShotEvaluator* Eval : { &Shots, &LinearShots })
+            {
+                H.Run(Eval == &Shots ? TEXT("Shot.Evaluate") : TEXT("Shot.Evaluate.Linear"), Squad, [&](int32 i)
+                    {
+                        FShotChoice Shot;
+                        const FVector& P = L.Points[i & (NumInputs - 1)];
+                        const FVector From(K.Tactics.HalfLength - 600.f - FMath::Abs(P.X) * 0.2f, P.Y * 0.25f, 11.f);
+                        Eval->Evaluate(L.Snap, i % Squad, From, FVector::ZeroVector, Shot);
+                        FBenchHarness::Consume(Shot.Aim);
+                    });
+            }
+
+            // Recording at 60 Hz with everyone moving as above, then seeks anywhere in what was recorded
+            FReplayRecorder Recorder;
+            const FString ReplayFile = FPaths::ProjectSavedDir() / TEXT("Bench") / FString::Printf(TEXT("Replay_%d.osfreplay"), Squad);
+            if (Recorder.Start(ReplayFile))
+            {
+                int32 Captured = 0;
+                H.Run(TEXT("Replay.Capture"), Squad, [&](int32 i)
+                    {
+                        Advance(1.f / 60.f);
+                        Recorder.Capture(Moving, Captured++ / 60.0, i % Num, (i / 600) & 1);
+                    }, 3600);
+                Recorder.Stop();
+                UE_CLOG(Recorder.FramesRecorded > 0, LogTemp, Display, TEXT("osf.Bench: Replay.Capture/%d recorded %.0f KB per minute at 60 Hz"),
+                    Squad, Recorder.BytesRecorded / 1024.0 / (Recorder.FramesRecorded / 3600.0));
+
+                FReplayReader Reader;
+                if (Reader.Open(ReplayFile))
+                {
+                    const double Duration = Reader.GetDuration();
+                    H.Run(TEXT("Replay.Seek"), Squad, [&](int32 i)
+                        {
+                            FBenchHarness::Consume(Reader.Seek(Duration * ((i * 613) & 1023) / 1023.0));
+                        }, 2000);
+                }
+            }
+        }
+    }
+
+    /** Ball flight: one AI-style prediction (2 s, sampled at 30 Hz) from seeded kicks, with and without the goal frame. */
+    void RunBallCases(FBenchHarness& H)
+    {
+        FRandomStream Rng(77);
+        TArray<FBallState> Kicks;
+        Kicks.SetNum(NumInputs);
+        for (FBallState& S : Kicks)
+        {
+            S.Pos = FVector(Rng.FRandRange(-4000.f, 4000.f), Rng.FRandRange(-3000.f, 3000.f), 11.f);
+            S.Vel = FVector(Rng.FRandRange(-3000.f, 3000.f), Rng.FRandRange(-3000.f, 3000.f), Rng.FRandRange(0.f, 1200.f));
+            S.Spin = FVector(0.f, 0.f, Rng.FRandRange(-60.f, 60.f));
+        }
+
+        FBallFlight Open;
+        FBallFlight Framed;
+        for (const float X : { -4755.f, 4755.f })
+        {
+            Framed.Obstacles.Add({ FVector(X, -465.f, 0.f), FVector(X, -465.f, 244.f), 10.f });
+            Framed.Obstacles.Add({ FVector(X, 465.f, 0.f), FVector(X, 465.f, 244.f), 10.f });
+            Framed.Obstacles.Add({ FVector(X, -465.f, 244.f), FVector(X, 465.f, 244.f), 10.f });
+        }
+
+        TArray<FBallState> Path;
+        H.Run(TEXT("BallFlight.Predict2s"), 0, [&](int32 i)
+            {
+                Open.Predict(Kicks[i & (NumInputs - 1)], 2.f, 1.f / 30.f, Path);
+                FBenchHarness::Consume(Path.Last().Pos);
+            }, 2000);
+        H.Run(TEXT("BallFlight.Predict2s.GoalFrame"), 0, [&](int32 i)
+            {
+                Framed.Predict(Kicks[i & (NumInputs - 1)], 2.f, 1.f / 30.f, Path);
+                FBenchHarness::Consume(Path.Last().Pos);
+            }, 2000);
+    }
+
+    /** Inverse kicks, 96 targets per call (a full pass search), for each kind of query the evaluators make. */
+    void RunKickCases(FBenchHarness& H)
+    {
+        FRandomStream Rng(91);
+        constexpr int32 Batch = 96;
+        constexpr int32 NumBatches = 4;
+
+        FKickSolver Solver;
+        Solver.Configure(FBallParams(), 0.f);
+        const FVector From(0.f, 0.f, 11.f);
+
+        struct FCase
+        {
+            const TCHAR* Name;
+            FKickQuery Query;
+            TArray<FKickTarget> Targets;
+        };
+        FCase Cases[3];
+        Cases[0].Name = TEXT("Kick.Solve96.GroundPass");
+        Cases[0].Query.bGround = true;
+        Cases[1].Name = TEXT("Kick.Solve96.Shot");
+        Cases[1].Query.Goal = EKickGoal::LaunchSpeed;
+        Cases[2].Name = TEXT("Kick.Solve96.Timed");
+        Cases[2].Query.Goal = EKickGoal::ArrivalTime;
+
+        for (FCase& C : Cases)
+        {
+            C.Targets.SetNum(Batch * NumBatches);
+            for (FKickTarget& T : C.Targets)
+            {
+                const float Dist = Rng.FRandRange(800.f, 3500.f);
+                const float Angle = Rng.FRandRange(-0.3f, 0.3f);
+                T.From = From;
+                T.To = From + FVector(Dist * FMath::Cos(Angle), Dist * FMath::Sin(Angle), 0.f);
+                switch (C.Query.Goal)
+                {
+                case EKickGoal::LaunchSpeed:
+                    T.To.Z = Rng.FRandRange(21.f, 230.f);
+                    T.Value = 2600.f;
+                    T.SideSpin = Rng.FRandRange(-20.f, 20.f);
+                    break;
+                case EKickGoal::ArrivalTime:
+                    T.To.Z = Rng.FRandRange(11.f, 200.f);
+                    T.Value = Dist / 1500.f + 0.3f;
+                    break;
+                default:
+                    T.Value = 500.f;
+                    break;
+                }
+            }
+
+            TArray<FKickSolution> Out;
+            Out.SetNum(Batch);
+            H.Run(C.Name, 0, [&](int32 i)
+                {
+                    Solver.Solve(C.Query, MakeArrayView(C.Targets.GetData() + (i % NumBatches) * Batch, Batch), Out);
+                    FBenchHarness::Consume(Out[0].Velocity);
+                }, 200);
+
+            // Convergence alongside the timing, over every target of the case
+            Out.SetNum(C.Targets.Num());
+            Solver.Solve(C.Query, C.Targets, Out);
+            int32 Converged = 0, Iterations = 0;
+            float WorstError = 0.f;
+            for (const FKickSolution& S : Out)
+            {
+                Converged += S.bConverged ? 1 : 0;
+                Iterations += S.Iterations;
+                if (S.bConverged) WorstError = FMath::Max(WorstError, S.Error);
+            }
+            UE_LOG(LogTemp, Display, TEXT("osf.Bench: %s converged %d/%d, %.2f iterations on average, worst converged error %.1f cm"),
+                C.Name, Converged, Out.Num(), float(Iterations) / Out.Num(), WorstError);
+        }
+    }
+
+    /** Cases that need live actors; skipped without a game world. */
+    void RunActorCases(FBenchHarness& H, UWorld* World)
+    {
+        if (!World || !World->IsGameWorld())
+        {
+            UE_LOG(LogTemp, Display, TEXT("osf.Bench: no game world, skipping actor cases"));
+            return;
+        }
+
+        FActorSpawnParameters Params;
+        Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        Params.ObjectFlags |= RF_Transient;
+
+        const FBenchLayout L(11, 42);
+
+        if (AGoal* Goal = World->SpawnActor<AGoal>(AGoal::StaticClass(), FVector(4755.f, 0.f, 50.f), FRotator::ZeroRotator, Params))
+        {
+            H.Run(TEXT("AGoal::IsLocationInGoal"), 0, [&](int32 i)
+                {
+                    FBenchHarness::Consume(Goal->IsLocationInGoal(L.Points[i & (NumInputs - 1)]));
+                });
+            Goal->Destroy();
+        }
+
+        ACharacter* Runner = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator, Params);
+        ACharacter* BallStandIn = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), FVector(800.f, 300.f, 100.f), FRotator::ZeroRotator, Params);
+        if (Runner && BallStandIn)
+        {
+            UGameplayComponent* Gameplay = NewObject<UGameplayComponent>(Runner);
+            H.Run(TEXT("MoveToBallForKick"), 0, [&](int32 i)
+                {
+                    Gameplay->MoveToBallForKick(Runner, BallStandIn, FVector::ForwardVector, 1.f / 60.f);
+                    FBenchHarness::Consume(Runner->GetActorRotation().Yaw);
+                }, 5000);
+        }
+        if (Runner) Runner->Destroy();
+        if (BallStandIn) BallStandIn->Destroy();
+    }
+
+    void RunBenchCommand(const TArray<FString>& Args, UWorld* World)
+    {
+        const FString Joined = FString::Join(Args, TEXT(" "));
+
+        FBenchHarness H;
+        float Tolerance = 0.10f;
+        FString BaselinePath = FBenchHarness::DefaultBaselinePath();
+        FParse::Value(*Joined, TEXT("Filter="), H.Filter);
+        FParse::Value(*Joined, TEXT("Iterations="), H.Iterations);
+        FParse::Value(*Joined, TEXT("Tolerance="), Tolerance);
+        FParse::Value(*Joined, TEXT("Baseline="), BaselinePath);
+
+        RunKernelCases(H);
+        RunBallCases(H);
+        RunKickCases(H);
+        RunActorCases(H, World);
+
+        int32 Missing = 0;
+        const int32 Regressions = H.Report(BaselinePath, Tolerance, Missing);
+        UE_LOG(LogTemp, Display, TEXT("osf.Bench: %d cases, %d over baseline (tolerance %.0f%%)"),
+            H.Samples.Num(), Regressions, 100.f * Tolerance);
+        UE_CLOG(Missing > 0, LogTemp, Warning, TEXT("osf.Bench: %d cases have no baseline entry and were not checked; record one with WriteBaseline"),
+            Missing);
+
+        if (Joined.Contains(TEXT("WriteBaseline")))
+        {
+            const bool bOk = H.WriteBaseline(BaselinePath);
+            UE_LOG(LogTemp, Display, TEXT("osf.Bench: baseline %s %s"), bOk ? TEXT("written to") : TEXT("could not be written to"), *BaselinePath);
+        }
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs GBenchCommand(
+        TEXT("osf.Bench"),
+        TEXT("AI/geometry microbenchmarks: [Filter=name] [Iterations=N] [Tolerance=0.1] [Baseline=path] [WriteBaseline]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBenchCommand));
+}
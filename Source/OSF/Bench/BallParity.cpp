@@ -0,0 +1,269 @@
+#include "HAL/IConsoleManager.h"
+#include "Containers/Ticker.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Engine/CollisionProfile.h"
+
+#include "Sim/BallFlight.h"
+
+// Chaos against FBallFlight on the same launch, for what both simulate:
+// gravity, bounces and rolling (drag, Magnus and rolling resistance are off in
+// the model here, Chaos has none of them).
+//
+//   osf.Ball.Parity [Speed=1800] [Elevation=35] [Seconds=3] [Save=path.csv]
+//                   [Reference=path.csv] [Tolerance=2] [MaxTolerance=10] [Record]
+//
+// A transient sphere is launched with Chaos, its path recorded every frame,
+// then the model is run over the same timestamps and the deviation logged.
+//
+// The model path is then checked against a snapshot of itself, Bench/BallModel_<Speed>_<Elevation>.csv
+// (t and position relative to the launch point): RMS within Tolerance and every sample within
+// MaxTolerance (cm) passes, anything else logs an error. The snapshot was made by FBallFlight, so
+// this catches regressions in the model, not disagreement with Chaos; that is the deviation logged
+// above. Record rewrites the snapshot from this run's model path.
+
+namespace
+{
+    struct FParityRun
+    {
+        TWeakObjectPtr<AStaticMeshActor> Ball;
+        TWeakObjectPtr<UWorld> World;
+        FBallFlight Model;
+        FBallState Start;
+        double StartTime = 0.0;
+        float Seconds = 3.f;
+        FString SavePath;
+        FString ReferencePath;
+        float Tolerance = 2.f;     // snapshot check; the model should only move when it is changed
+        float MaxTolerance = 10.f;
+        bool bRecord = false;
+
+        TArray<float> Times;
+        TArray<FVector> Chaos;
+    };
+
+    /** Rows of t,x,y,z after a header line; false if the file is missing or has no rows. */
+    bool LoadReference(const FString& Path, TArray<float>& OutTimes, TArray<FVector>& OutPos)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *Path)) return false;
+
+        for (int32 i = 1; i < Lines.Num(); ++i)
+        {
+            TArray<FString> Cells;
+            if (Lines[i].ParseIntoArray(Cells, TEXT(",")) != 4) continue;
+            OutTimes.Add(FCString::Atof(*Cells[0]));
+            OutPos.Add(FVector(FCString::Atof(*Cells[1]), FCString::Atof(*Cells[2]), FCString::Atof(*Cells[3])));
+        }
+        return OutTimes.Num() > 1;
+    }
+
+    /** The model path against its snapshot, interpolated at the Chaos timestamps. */
+    void CheckReference(const FParityRun& Run, const TArray<FVector>& ModelPath)
+    {
+        if (Run.bRecord)
+        {
+            FString Csv = TEXT("t,x,y,z\n");
+            for (int32 i = 0; i < Run.Times.Num(); ++i)
+            {
+                const FVector P = ModelPath[i] - Run.Start.Pos;
+                Csv += FString::Printf(TEXT("%.4f,%.2f,%.2f,%.2f\n"), Run.Times[i], P.X, P.Y, P.Z);
+            }
+            const bool bOk = FFileHelper::SaveStringToFile(Csv, *Run.ReferencePath);
+            UE_LOG(LogTemp, Display, TEXT("osf.Ball.Parity: model snapshot %s %s"), bOk ? TEXT("recorded to") : TEXT("could not be written to"), *Run.ReferencePath);
+            return;
+        }
+
+        TArray<float> RefTimes;
+        TArray<FVector> RefPos;
+        if (!LoadReference(Run.ReferencePath, RefTimes, RefPos))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("osf.Ball.Parity: no model snapshot at %s; record one with Record"), *Run.ReferencePath);
+            return;
+        }
+
+        double SumSq = 0.0;
+        float MaxErr = 0.f, MaxErrTime = 0.f;
+        int32 Num = 0;
+        int32 r = 0;
+        for (int32 i = 0; i < Run.Times.Num(); ++i)
+        {
+            const float T = Run.Times[i];
+            if (T > RefTimes.Last()) break;
+            while (r + 2 < RefTimes.Num() && RefTimes[r + 1] < T) ++r;
+
+            const float Alpha = FMath::Clamp((T - RefTimes[r]) / FMath::Max(RefTimes[r + 1] - RefTimes[r], 1.e-4f), 0.f, 1.f);
+            const FVector Ref = Run.Start.Pos + FMath::Lerp(RefPos[r], RefPos[r + 1], Alpha);
+            const float Err = FVector::Dist(Ref, ModelPath[i]);
+            SumSq += double(Err) * Err;
+            if (Err > MaxErr) { MaxErr = Err; MaxErrTime = T; }
+            ++Num;
+        }
+
+        const float Rms = Num > 0 ? float(FMath::Sqrt(SumSq / Num)) : 0.f;
+        if (Num > 0 && Rms <= Run.Tolerance && MaxErr <= Run.MaxTolerance)
+        {
+            UE_LOG(LogTemp, Display, TEXT("osf.Ball.Parity: model PASS against %s: RMS %.1f cm (<= %.1f), max %.1f cm (<= %.1f) at %.2f s"),
+                *Run.ReferencePath, Rms, Run.Tolerance, MaxErr, Run.MaxTolerance, MaxErrTime);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Error, TEXT("osf.Ball.Parity: model FAIL against %s: %d samples, RMS %.1f cm (<= %.1f), max %.1f cm (<= %.1f) at %.2f s"),
+                *Run.ReferencePath, Num, Rms, Run.Tolerance, MaxErr, Run.MaxTolerance, MaxErrTime);
+        }
+    }
+
+    void Compare(const FParityRun& Run)
+    {
+        FBallState S = Run.Start;
+        double SumSq = 0.0;
+        float MaxErr = 0.f, MaxErrTime = 0.f;
+        float PrevT = 0.f;
+        TArray<FVector> ModelPath;
+        ModelPath.Reserve(Run.Times.Num());
+
+        FString Csv = TEXT("t,chaos_x,chaos_y,chaos_z,model_x,model_y,model_z\n");
+        for (int32 i = 0; i < Run.Times.Num(); ++i)
+        {
+            Run.Model.Advance(S, Run.Times[i] - PrevT);
+            PrevT = Run.Times[i];
+            ModelPath.Add(S.Pos);
+
+            const float Err = FVector::Dist(S.Pos, Run.Chaos[i]);
+            SumSq += double(Err) * Err;
+            if (Err > MaxErr) { MaxErr = Err; MaxErrTime = Run.Times[i]; }
+
+            Csv += FString::Printf(TEXT("%.4f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n"), Run.Times[i],
+                Run.Chaos[i].X, Run.Chaos[i].Y, Run.Chaos[i].Z, S.Pos.X, S.Pos.Y, S.Pos.Z);
+        }
+
+        const float Rms = Run.Times.Num() > 0 ? float(FMath::Sqrt(SumSq / Run.Times.Num())) : 0.f;
+        UE_LOG(LogTemp, Display, TEXT("osf.Ball.Parity: %d samples over %.2f s, RMS %.1f cm, max %.1f cm at %.2f s"),
+            Run.Times.Num(), PrevT, Rms, MaxErr, MaxErrTime);
+
+        if (!Run.SavePath.IsEmpty())
+        {
+            const bool bOk = FFileHelper::SaveStringToFile(Csv, *Run.SavePath);
+            UE_LOG(LogTemp, Display, TEXT("osf.Ball.Parity: trajectory %s %s"), bOk ? TEXT("written to") : TEXT("could not be written to"), *Run.SavePath);
+        }
+
+        CheckReference(Run, ModelPath);
+    }
+
+    void RunParityCommand(const TArray<FString>& Args, UWorld* World)
+    {
+        if (!World || !World->IsGameWorld())
+        {
+            UE_LOG(LogTemp, Display, TEXT("osf.Ball.Parity: needs a game world"));
+            return;
+        }
+
+        const FString Joined = FString::Join(Args, TEXT(" "));
+        float Speed = 1800.f, Elevation = 35.f;
+        TSharedRef<FParityRun> Run = MakeShared<FParityRun>();
+        FParse::Value(*Joined, TEXT("Speed="), Speed);
+        FParse::Value(*Joined, TEXT("Elevation="), Elevation);
+        FParse::Value(*Joined, TEXT("Seconds="), Run->Seconds);
+        if (FParse::Value(*Joined, TEXT("Save="), Run->SavePath) && FPaths::IsRelative(Run->SavePath))
+        {
+            Run->SavePath = FPaths::ProjectSavedDir() / Run->SavePath;
+        }
+        if (!FParse::Value(*Joined, TEXT("Reference="), Run->ReferencePath))
+        {
+            Run->ReferencePath = FString::Printf(TEXT("Bench/BallModel_%.0f_%.0f.csv"), Speed, Elevation);
+        }
+        if (FPaths::IsRelative(Run->ReferencePath))
+        {
+            Run->ReferencePath = FPaths::ProjectDir() / Run->ReferencePath;
+        }
+        FParse::Value(*Joined, TEXT("Tolerance="), Run->Tolerance);
+        FParse::Value(*Joined, TEXT("MaxTolerance="), Run->MaxTolerance);
+        Run->bRecord = Args.Contains(TEXT("Record"));
+
+        // Only what Chaos simulates too
+        FBallParams& P = Run->Model.Params;
+        P.DragCoeff = 0.f;
+        P.MagnusCoeff = 0.f;
+        P.RollingResistance = 0.f;
+        P.SpinDecay = 0.f;
+
+        UStaticMesh* Sphere = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Sphere.Sphere"));
+        if (!Sphere)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("osf.Ball.Parity: /Engine/BasicShapes/Sphere not found"));
+            return;
+        }
+
+        // Launch from the centre spot, a metre up so the first contact is a real bounce
+        const FVector Above(0.f, 0.f, 1000.f);
+        FHitResult Hit;
+        Run->Model.GroundZ = World->LineTraceSingleByChannel(Hit, Above, Above - FVector(0, 0, 10000.f), ECC_Visibility) ? Hit.ImpactPoint.Z : 0.f;
+        const FVector Origin(0.f, 0.f, Run->Model.GroundZ + P.Radius + 100.f);
+
+        FActorSpawnParameters Params;
+        Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        Params.ObjectFlags |= RF_Transient;
+        AStaticMeshActor* Ball = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Origin, FRotator::ZeroRotator, Params);
+        if (!Ball) return;
+
+        UStaticMeshComponent* Body = Ball->GetStaticMeshComponent();
+        Body->SetMobility(EComponentMobility::Movable);
+        Body->SetStaticMesh(Sphere);
+        Body->SetWorldScale3D(FVector(P.Radius / 50.f)); // engine sphere is 50 cm
+        Body->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
+
+        UPhysicalMaterial* Mat = NewObject<UPhysicalMaterial>(Ball);
+        Mat->Restitution = P.Restitution;
+        Mat->Friction = P.GroundFriction;
+        Mat->bOverrideRestitutionCombineMode = true;
+        Mat->RestitutionCombineMode = EFrictionCombineMode::Max;
+        Body->SetPhysMaterialOverride(Mat);
+
+        Body->SetSimulatePhysics(true);
+        Body->SetMassOverrideInKg(NAME_None, P.Mass, true);
+        Body->SetLinearDamping(0.f);
+        Body->SetAngularDamping(0.f);
+
+        const float Rad = FMath::DegreesToRadians(Elevation);
+        const FVector V0(Speed * FMath::Cos(Rad), 0.f, Speed * FMath::Sin(Rad));
+        Body->SetPhysicsLinearVelocity(V0);
+
+        Run->Ball = Ball;
+        Run->World = World;
+        Run->Start.Pos = Origin;
+        Run->Start.Vel = V0;
+        Run->StartTime = World->GetTimeSeconds();
+
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Run](float)
+            {
+                AStaticMeshActor* B = Run->Ball.Get();
+                UWorld* W = Run->World.Get();
+                if (!B || !W) return false;
+
+                const float T = float(W->GetTimeSeconds() - Run->StartTime);
+                if (T > 0.f)
+                {
+                    Run->Times.Add(T);
+                    Run->Chaos.Add(B->GetActorLocation());
+                }
+                if (T < Run->Seconds) return true;
+
+                B->Destroy();
+                Compare(*Run);
+                return false;
+            }));
+
+        UE_LOG(LogTemp, Display, TEXT("osf.Ball.Parity: launched at %.0f cm/s, %.0f deg; recording %.1f s"), Speed, Elevation, Run->Seconds);
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs GParityCommand(
+        TEXT("osf.Ball.Parity"),
+        TEXT("Ball model vs Chaos on one launch, and the model against its snapshot: [Speed=1800] [Elevation=35] [Seconds=3] [Save=path.csv] [Reference=path.csv] [Tolerance=2] [MaxTolerance=10] [Record]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunParityCommand));
+}
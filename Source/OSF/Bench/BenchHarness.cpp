@@ -0,0 +1,149 @@
+#include "Bench/BenchHarness.h"
+
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+volatile float FBenchHarness::Sink = 0.f;
+
+namespace
+{
+    /** Forwards everything to the real allocator; counts Malloc/Realloc-as-malloc on one thread. */
+    class FCountingMalloc final : public FMalloc
+    {
+    public:
+        FMalloc* Inner = nullptr;
+        uint32 ThreadId = 0;
+        uint64 Count = 0;
+
+        virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+        {
+            if (FPlatformTLS::GetCurrentThreadId() == ThreadId) ++Count;
+            return Inner->Malloc(Size, Alignment);
+        }
+        virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override
+        {
+            if (Ptr == nullptr && NewSize > 0 && FPlatformTLS::GetCurrentThreadId() == ThreadId) ++Count;
+            return Inner->Realloc(Ptr, NewSize, Alignment);
+        }
+        virtual void Free(void* Ptr) override { Inner->Free(Ptr); }
+
+        virtual SIZE_T QuantizeSize(SIZE_T Count_, uint32 Alignment) override { return Inner->QuantizeSize(Count_, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual void UpdateStats() override { Inner->UpdateStats(); }
+        virtual const TCHAR* GetDescriptiveName() override { return TEXT("OSFBenchCounting"); }
+    };
+
+    // Never destroyed: other threads may still be inside it right after the swap back
+    FCountingMalloc GCountingMalloc;
+}
+
+void FBenchHarness::BeginAllocCount()
+{
+    check(IsInGameThread());
+    GCountingMalloc.Inner = GMalloc;
+    GCountingMalloc.ThreadId = FPlatformTLS::GetCurrentThreadId();
+    GCountingMalloc.Count = 0;
+    GMalloc = &GCountingMalloc;
+}
+
+uint64 FBenchHarness::EndAllocCount()
+{
+    GMalloc = GCountingMalloc.Inner;
+    return GCountingMalloc.Count;
+}
+
+FString FBenchHarness::DefaultBaselinePath()
+{
+    return FPaths::ProjectDir() / TEXT("Bench/Baseline.json");
+}
+
+static FString SampleKey(const FString& Name, int32 Squad)
+{
+    return FString::Printf(TEXT("%s/%d"), *Name, Squad);
+}
+
+int32 FBenchHarness::Report(const FString& BaselinePath, float Tolerance, int32& OutMissing) const
+{
+    TMap<FString, FBenchSample> Baseline;
+    OutMissing = 0;
+
+    FString Text;
+    TSharedPtr<FJsonObject> Root;
+    if (FFileHelper::LoadFileToString(Text, *BaselinePath)
+        && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) && Root.IsValid())
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+        if (Root->TryGetArrayField(TEXT("results"), Entries))
+        {
+            for (const TSharedPtr<FJsonValue>& V : *Entries)
+            {
+                const TSharedPtr<FJsonObject> E = V->AsObject();
+                if (!E.IsValid()) continue;
+                FBenchSample S;
+                S.Name = E->GetStringField(TEXT("name"));
+                S.Squad = static_cast<int32>(E->GetNumberField(TEXT("squad")));
+                S.NsPerOp = E->GetNumberField(TEXT("nsPerOp"));
+                S.AllocsPerOp = E->GetNumberField(TEXT("allocsPerOp"));
+                Baseline.Add(SampleKey(S.Name, S.Squad), S);
+            }
+        }
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("osf.Bench: no baseline at %s; nothing can be checked for regressions"), *BaselinePath);
+    }
+
+    int32 Regressions = 0;
+    UE_LOG(LogTemp, Display, TEXT("%-28s %6s %12s %10s %10s"), TEXT("case"), TEXT("squad"), TEXT("ns/op"), TEXT("allocs/op"), TEXT("vs base"));
+    for (const FBenchSample& S : Samples)
+    {
+        const FBenchSample* B = Baseline.Find(SampleKey(S.Name, S.Squad));
+        if (!B || B->NsPerOp <= 0.0)
+        {
+            ++OutMissing;
+            UE_LOG(LogTemp, Warning, TEXT("%-28s %6d %12.1f %10.2f %10s  NO BASELINE"),
+                *S.Name, S.Squad, S.NsPerOp, S.AllocsPerOp, TEXT("-"));
+            continue;
+        }
+
+        const double Ratio = S.NsPerOp / B->NsPerOp - 1.0;
+        const bool bRegressed = Ratio > Tolerance || S.AllocsPerOp > B->AllocsPerOp + 0.01;
+        Regressions += bRegressed ? 1 : 0;
+
+        UE_LOG(LogTemp, Display, TEXT("%-28s %6d %12.1f %10.2f %+9.1f%%%s"),
+            *S.Name, S.Squad, S.NsPerOp, S.AllocsPerOp, 100.0 * Ratio, bRegressed ? TEXT("  REGRESSION") : TEXT(""));
+    }
+    return Regressions;
+}
+
+bool FBenchHarness::WriteBaseline(const FString& Path) const
+{
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    for (const FBenchSample& S : Samples)
+    {
+        TSharedRef<FJsonObject> E = MakeShared<FJsonObject>();
+        E->SetStringField(TEXT("name"), S.Name);
+        E->SetNumberField(TEXT("squad"), S.Squad);
+        E->SetNumberField(TEXT("nsPerOp"), S.NsPerOp);
+        E->SetNumberField(TEXT("allocsPerOp"), S.AllocsPerOp);
+        Entries.Add(MakeShared<FJsonValueObject>(E));
+    }
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("machine"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+    Root->SetArrayField(TEXT("results"), Entries);
+
+    FString Json;
+    FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+    return FFileHelper::SaveStringToFile(Json, *Path);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One measured case. */
+struct FBenchSample
+{
+    FString Name;
+    int32   Squad = 0;        // players per team, 0 = not squad dependent
+    double  NsPerOp = 0.0;    // best of Repeats
+    double  AllocsPerOp = 0.0;
+};
+
+/**
+ * Small embedded benchmark harness (Google Benchmark style, no dependency).
+ *
+ * Run() times Op(i) for i in [0, Iterations) Repeats times and keeps the best
+ * batch; a separate pass counts heap allocations made on the calling thread by
+ * routing GMalloc through a counting proxy for the duration of that pass.
+ * Results compare against a JSON baseline (see Bench/Baseline.json).
+ */
+class OSF_API FBenchHarness
+{
+public:
+    int32 Iterations = 20000;
+    int32 Repeats = 5;
+    FString Filter;           // substring of the case name; empty = all
+
+    TArray<FBenchSample> Samples;
+
+    template<typename FuncType>
+    void Run(const TCHAR* Name, int32 Squad, FuncType&& Op, int32 IterationsOverride = 0);
+
+    /**
+     * Logs every sample with its delta to the baseline and whether it is over Tolerance. Returns regressions;
+     * OutMissing counts samples the baseline has no entry for, each logged as a warning.
+     */
+    int32 Report(const FString& BaselinePath, float Tolerance, int32& OutMissing) const;
+
+    bool WriteBaseline(const FString& Path) const;
+
+    static FString DefaultBaselinePath();
+
+    /** Keeps a result alive so the optimiser cannot drop the work. */
+    template<typename T>
+    static FORCEINLINE void Consume(const T& Value) { Sink = Sink + static_cast<float>(GetSinkValue(Value)); }
+
+private:
+    static void BeginAllocCount();
+    static uint64 EndAllocCount();
+
+    static FORCEINLINE double GetSinkValue(float V) { return V; }
+    static FORCEINLINE double GetSinkValue(double V) { return V; }
+    static FORCEINLINE double GetSinkValue(int32 V) { return V; }
+    static FORCEINLINE double GetSinkValue(bool V) { return V ? 1.0 : 0.0; }
+    static FORCEINLINE double GetSinkValue(const FVector& V) { return V.X + V.Y + V.Z; }
+    static FORCEINLINE double GetSinkValue(const void* P) { return P ? 1.0 : 0.0; }
+
+    static volatile float Sink;
+};
+
+template<typename FuncType>
+void FBenchHarness::Run(const TCHAR* Name, int32 Squad, FuncType&& Op, int32 IterationsOverride)
+{
+    if (!Filter.IsEmpty() && !FCString::Stristr(Name, *Filter)) return;
+
+    const int32 N = IterationsOverride > 0 ? IterationsOverride : FMath::Max(Iterations, 1);
+
+    // Warm caches and lazy statics
+    for (int32 i = 0; i < FMath::Max(N / 10, 1); ++i) Op(i);
+
+    uint64 BestCycles = TNumericLimits<uint64>::Max();
+    for (int32 r = 0; r < FMath::Max(Repeats, 1); ++r)
+    {
+        const uint64 Start = FPlatformTime::Cycles64();
+        for (int32 i = 0; i < N; ++i) Op(i);
+        BestCycles = FMath::Min(BestCycles, FPlatformTime::Cycles64() - Start);
+    }
+
+    BeginAllocCount();
+    for (int32 i = 0; i < N; ++i) Op(i);
+    const uint64 Allocs = EndAllocCount();
+
+    FBenchSample& S = Samples.AddDefaulted_GetRef();
+    S.Name = Name;
+    S.Squad = Squad;
+    S.NsPerOp = FPlatformTime::ToMilliseconds64(BestCycles) * 1.0e6 / N;
+    S.AllocsPerOp = double(Allocs) / N;
+}
@@ -0,0 +1,139 @@
+#include "HAL/IConsoleManager.h"
+#include "Containers/Ticker.h"
+#include "Misc/Parse.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+
+#include "DefaultGameMode.h"
+#include "TeamGameState.h"
+#include "Footballer.h"
+#include "Ballsack.h"
+#include "MatchRegistrySubsystem.h"
+#include "Sim/PitchRules.h"
+
+// An AI-played ball over the defenders' own by-line must give the attackers a corner.
+//
+//   osf.Rules.Check [Seconds=4]
+//
+// A team 1 AI footballer (team 1 defends +X) is put beside the ball wide of the
+// +X goal, kicks it over the line through AFootballer::KickBall, and the game
+// mode's restart is checked: last touch team 1 after the kick, then the ball
+// on the corner spot with team 0 awarded it. Logs PASS, or an error naming
+// what went wrong.
+
+namespace
+{
+    struct FRulesRun
+    {
+        TWeakObjectPtr<UWorld> World;
+        TWeakObjectPtr<AFootballer> Kicker;
+        FVector KickVelocity = FVector::ZeroVector;
+        FVector CornerSpot = FVector::ZeroVector;
+        double StartTime = 0.0;
+        float Seconds = 4.f;
+        bool bKicked = false;
+    };
+
+    void Fail(const TCHAR* What)
+    {
+        UE_LOG(LogTemp, Error, TEXT("osf.Rules.Check: FAIL, %s"), What);
+    }
+
+    void RunRulesCommand(const TArray<FString>& Args, UWorld* World)
+    {
+        ADefaultGameMode* GM = World ? World->GetAuthGameMode<ADefaultGameMode>() : nullptr;
+        UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(World);
+        ABallsack* Ball = Registry ? Registry->GetBall() : nullptr;
+        if (!GM || !Ball)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("osf.Rules.Check: needs a running match with a ball"));
+            return;
+        }
+
+        AFootballer* Kicker = nullptr;
+        for (AFootballer* P : Registry->GetRoster(1))
+        {
+            if (P && !(P->GetController() && P->GetController()->IsPlayerController())) { Kicker = P; break; }
+        }
+        if (!Kicker)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("osf.Rules.Check: team 1 has no AI footballer"));
+            return;
+        }
+
+        TSharedRef<FRulesRun> Run = MakeShared<FRulesRun>();
+        Run->World = World;
+        Run->Kicker = Kicker;
+        const FString Joined = FString::Join(Args, TEXT(" "));
+        FParse::Value(*Joined, TEXT("Seconds="), Run->Seconds);
+        Run->Seconds = FMath::Max(Run->Seconds, 0.5f);
+
+        // Wide of the +X goal, a few metres short of the line, kicked straight over it
+        const FPitchRules& Rules = GM->GetPitchRules();
+        const FPitchGeometry& G = Rules.Geometry;
+        const FPitchGoal& Mouth = G.Goals[1];
+        const FVector BallAt = G.Centre + FVector(G.HalfLength - 300.f, Mouth.CentreY + Mouth.HalfWidth + 800.f, G.BallRadius);
+        Run->KickVelocity = FVector(1500.f, 0.f, 0.f);
+
+        FPitchEventInfo Expected;
+        if (!Rules.Sweep(BallAt, BallAt + FVector(1000.f, 0.f, 0.f), 1, Expected) || Expected.Type != EPitchEvent::Corner)
+        {
+            Fail(TEXT("the pitch rules do not call this path a corner"));
+            return;
+        }
+        Run->CornerSpot = Rules.RestartLocation(Expected);
+
+        Ball->SetActorLocation(BallAt, false, nullptr, ETeleportType::ResetPhysics);
+        Kicker->SetActorLocation(FVector(BallAt.X - 100.f, BallAt.Y, Kicker->GetActorLocation().Z), false, nullptr, ETeleportType::TeleportPhysics);
+        Run->StartTime = World->GetTimeSeconds();
+
+        // The ball settles where it was put on its next tick, so kick a frame later
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Run](float)
+            {
+                UWorld* W = Run->World.Get();
+                AFootballer* K = Run->Kicker.Get();
+                ADefaultGameMode* Mode = W ? W->GetAuthGameMode<ADefaultGameMode>() : nullptr;
+                ATeamGameState* GS = W ? W->GetGameState<ATeamGameState>() : nullptr;
+                if (!Mode || !GS || !K) return false;
+
+                if (!Run->bKicked)
+                {
+                    if (W->GetTimeSeconds() <= Run->StartTime) return true;
+                    if (!K->KickBall(Run->KickVelocity, FVector::ZeroVector))
+                    {
+                        Fail(TEXT("the kicker could not reach the ball"));
+                        return false;
+                    }
+                    Run->bKicked = true;
+                    if (Mode->GetLastTouchTeamID() != 1)
+                    {
+                        Fail(TEXT("the kick did not register a team 1 touch"));
+                        return false;
+                    }
+                    GS->PossessingTeamID = -1; // so only the restart can set it
+                    return true;
+                }
+
+                const FVector BallPos = ATeamGameState::GetBallLocationSafe(W);
+                if (GS->PossessingTeamID != -1 && FVector::Dist2D(BallPos, Run->CornerSpot) < 50.f)
+                {
+                    if (GS->PossessingTeamID == 0) UE_LOG(LogTemp, Display, TEXT("osf.Rules.Check: PASS, corner to team 0 at (%.0f, %.0f)"), BallPos.X, BallPos.Y);
+                    else Fail(*FString::Printf(TEXT("restart on the corner spot went to team %d"), GS->PossessingTeamID));
+                    return false;
+                }
+                if (W->GetTimeSeconds() - Run->StartTime > Run->Seconds)
+                {
+                    Fail(*FString::Printf(TEXT("no corner after %.1f s (ball at %.0f, %.0f; possession %d)"), Run->Seconds, BallPos.X, BallPos.Y, GS->PossessingTeamID));
+                    return false;
+                }
+                return true;
+            }));
+
+        UE_LOG(LogTemp, Display, TEXT("osf.Rules.Check: %s kicks toward the +X line"), *Kicker->GetName());
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs GRulesCommand(
+        TEXT("osf.Rules.Check"),
+        TEXT("An AI kick over the defenders' by-line must give a corner: [Seconds=4]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunRulesCommand));
+}
@@ -0,0 +1,460 @@
+#include "MatchSimCommandlet.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "PhysicsPublic.h"
+
+#include "DefaultGameMode.h"
+#include "TeamGameState.h"
+
+namespace
+{
+    /** Squad size and tunables for a named scenario. */
+    struct FMatchScenario
+    {
+        const TCHAR* Name;
+        int32 PlayersPerTeam;
+        const TCHAR* Tunables; // same syntax as -Set=
+    };
+
+    const FMatchScenario Scenarios[] =
+    {
+        { TEXT("11v11"),    11, TEXT("") },
+        { TEXT("30v30"),    30, TEXT("") },
+        // Everyone collapses on the ball: most players in the near LOD tier, lots of possession changes
+        { TEXT("Pressing"), 11, TEXT("HomeWeight=0.25,AdvanceWithBall=2200,RetreatWithBall=300,SupportAhead=350,SupportWide=500,KeeperChaseRadius=2000") },
+    };
+
+    /** "Name=Value,Name=Value" onto reflected properties of Obj. */
+    void ApplyTunables(UObject* Obj, const FString& List)
+    {
+        TArray<FString> Pairs;
+        List.ParseIntoArray(Pairs, TEXT(","));
+        for (const FString& Pair : Pairs)
+        {
+            FString Name, Value;
+            if (!Pair.Split(TEXT("="), &Name, &Value)) continue;
+
+            FProperty* Prop = Obj->GetClass()->FindPropertyByName(*Name.TrimStartAndEnd());
+            if (!Prop || !Prop->ImportText_InContainer(*Value.TrimStartAndEnd(), Obj, Obj, PPF_None))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("MatchSim: cannot set %s"), *Pair);
+            }
+        }
+    }
+
+    /** p50/p95/p99/max of one per-frame series, in ms. */
+    struct FPercentiles
+    {
+        double P50 = 0.0, P95 = 0.0, P99 = 0.0, Max = 0.0;
+
+        static FPercentiles Of(TArray<float> Ms)
+        {
+            FPercentiles P;
+            if (Ms.Num() == 0) return P;
+            Ms.Sort();
+            auto At = [&Ms](double Q) { return double(Ms[FMath::Clamp(FMath::CeilToInt(Q * Ms.Num()) - 1, 0, Ms.Num() - 1)]); };
+            P.P50 = At(0.50); P.P95 = At(0.95); P.P99 = At(0.99); P.Max = Ms.Last();
+            return P;
+        }
+
+        TSharedRef<FJsonObject> ToJson() const
+        {
+            TSharedRef<FJsonObject> O = MakeShared<FJsonObject>();
+            O->SetNumberField(TEXT("p50"), P50);
+            O->SetNumberField(TEXT("p95"), P95);
+            O->SetNumberField(TEXT("p99"), P99);
+            O->SetNumberField(TEXT("max"), Max);
+            return O;
+        }
+    };
+
+    FString DefaultMatchBaselinePath()
+    {
+        return FPaths::ProjectDir() / TEXT("Bench/MatchBaseline.json");
+    }
+
+    /** Series over the baseline by more than Tolerance; OutMissing counts series the baseline has no entry for. */
+    int32 CompareToBaseline(const FString& Path, const FString& Scenario, const TMap<FString, FPercentiles>& Series, float Tolerance, int32& OutMissing)
+    {
+        OutMissing = 0;
+        FString Text;
+        TSharedPtr<FJsonObject> Root;
+        if (!FFileHelper::LoadFileToString(Text, *Path)
+            || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) || !Root.IsValid())
+        {
+            UE_LOG(LogTemp, Error, TEXT("MatchSim: no baseline at %s; record one with -WriteBaseline"), *Path);
+            OutMissing = Series.Num();
+            return 0;
+        }
+
+        const TSharedPtr<FJsonObject>* Scenarios = nullptr;
+        const TSharedPtr<FJsonObject>* Base = nullptr;
+        if (!Root->TryGetObjectField(TEXT("scenarios"), Scenarios) || !(*Scenarios)->TryGetObjectField(Scenario, Base))
+        {
+            UE_LOG(LogTemp, Error, TEXT("MatchSim: baseline has no entry for %s; record one with -WriteBaseline"), *Scenario);
+            OutMissing = Series.Num();
+            return 0;
+        }
+
+        int32 Regressions = 0;
+        for (const TPair<FString, FPercentiles>& It : Series)
+        {
+            const TSharedPtr<FJsonObject>* B = nullptr;
+            if (!(*Base)->TryGetObjectField(It.Key, B))
+            {
+                UE_LOG(LogTemp, Error, TEXT("MatchSim: baseline for %s has no %s series"), *Scenario, *It.Key);
+                ++OutMissing;
+                continue;
+            }
+
+            const double Pairs[2][2] = { { It.Value.P95, (*B)->GetNumberField(TEXT("p95")) }, { It.Value.P99, (*B)->GetNumberField(TEXT("p99")) } };
+            const TCHAR* Names[2] = { TEXT("p95"), TEXT("p99") };
+            for (int32 k = 0; k < 2; ++k)
+            {
+                const double Now = Pairs[k][0], Was = Pairs[k][1];
+                if (Was > 0.0 && Now > Was * (1.0 + Tolerance))
+                {
+                    UE_LOG(LogTemp, Error, TEXT("MatchSim: %s %s %s %.3f ms vs baseline %.3f ms (%+.1f%%)"),
+                        *Scenario, *It.Key, Names[k], Now, Was, 100.0 * (Now / Was - 1.0));
+                    ++Regressions;
+                }
+            }
+        }
+        return Regressions;
+    }
+
+    bool WriteScenarioBaseline(const FString& Path, const FString& Scenario, const TMap<FString, FPercentiles>& Series)
+    {
+        // Keep other scenarios already in the file
+        FString Text;
+        TSharedPtr<FJsonObject> Root;
+        if (!FFileHelper::LoadFileToString(Text, *Path)
+            || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) || !Root.IsValid())
+        {
+            Root = MakeShared<FJsonObject>();
+        }
+
+        const TSharedPtr<FJsonObject>* Existing = nullptr;
+        TSharedPtr<FJsonObject> ScenariosObj = Root->TryGetObjectField(TEXT("scenarios"), Existing) ? *Existing : MakeShared<FJsonObject>();
+
+        TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+        for (const TPair<FString, FPercentiles>& It : Series) Entry->SetObjectField(It.Key, It.Value.ToJson());
+        ScenariosObj->SetObjectField(Scenario, Entry);
+
+        Root->SetStringField(TEXT("machine"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+        Root->SetObjectField(TEXT("scenarios"), ScenariosObj);
+
+        FString Json;
+        FJsonSerializer::Serialize(Root.ToSharedRef(), TJsonWriterFactory<>::Create(&Json));
+        return FFileHelper::SaveStringToFile(Json, *Path);
+    }
+}
+
+UMatchSimCommandlet::UMatchSimCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = true;
+    LogToConsole = true;
+}
+
+int32 UMatchSimCommandlet::Main(const FString& Params)
+{
+    FString MapName = TEXT("/Game/Maps/Example_Map");
+    FString GameModeClass;
+    FString OutPath;
+    FString ScenarioName;
+    FString Tunables;
+    FString BaselinePath = DefaultMatchBaselinePath();
+    double Duration = 90.0 * 60.0;
+    float Dt = 1.f / 60.f;
+    float Tolerance = 0.10f;
+    int32 Seed = 0;
+    int32 PlayersPerTeam = 0;
+
+    FParse::Value(*Params, TEXT("Map="), MapName);
+    FParse::Value(*Params, TEXT("GameMode="), GameModeClass);
+    FParse::Value(*Params, TEXT("Out="), OutPath);
+    FParse::Value(*Params, TEXT("Scenario="), ScenarioName);
+    FParse::Value(*Params, TEXT("Set="), Tunables, false);
+    FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+    FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+    FParse::Value(*Params, TEXT("Dt="), Dt);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    const bool bBench = FParse::Param(*Params, TEXT("Bench"));
+    const bool bWriteBaseline = FParse::Param(*Params, TEXT("WriteBaseline"));
+    const bool bCsv = FParse::Param(*Params, TEXT("Csv"));
+    Dt = FMath::Clamp(Dt, 1.f / 240.f, 0.1f);
+
+    const FMatchScenario* Scenario = nullptr;
+    if (!ScenarioName.IsEmpty())
+    {
+        for (const FMatchScenario& S : Scenarios)
+        {
+            if (ScenarioName == S.Name) Scenario = &S;
+        }
+        if (!Scenario)
+        {
+            UE_LOG(LogTemp, Error, TEXT("MatchSim: unknown scenario %s"), *ScenarioName);
+            return 1;
+        }
+        PlayersPerTeam = Scenario->PlayersPerTeam;
+        Duration = 5.0 * 60.0;
+    }
+    else
+    {
+        ScenarioName = TEXT("Custom");
+    }
+    FParse::Value(*Params, TEXT("Duration="), Duration);
+    FParse::Value(*Params, TEXT("PlayersPerTeam="), PlayersPerTeam);
+
+    // Fixed step, never wait on the clock, nothing to look at
+    FApp::SetUseFixedTimeStep(true);
+    FApp::SetFixedDeltaTime(Dt);
+    FApp::SetBenchmarking(true);
+    FMath::RandInit(Seed);
+    FMath::SRandInit(Seed);
+    if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("osf.AI.DebugDraw"))) CVar->Set(0);
+
+    UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+    UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+    if (!World)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MatchSim: could not load map %s"), *MapName);
+        return 1;
+    }
+
+    World->WorldType = EWorldType::Game;
+    World->AddToRoot();
+
+    FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+    Context.SetCurrentWorld(World);
+
+    World->InitWorld(UWorld::InitializationValues()
+        .AllowAudioPlayback(false)
+        .RequiresHitProxies(false)
+        .CreatePhysicsScene(true)
+        .CreateNavigation(true)
+        .CreateAISystem(true)
+        .ShouldSimulatePhysics(true)
+        .EnableTraceCollision(true)
+        .SetTransactional(false));
+    World->UpdateWorldComponents(true, false);
+
+    FURL URL;
+    URL.Map = MapName;
+    if (!GameModeClass.IsEmpty()) URL.AddOption(*FString::Printf(TEXT("game=%s"), *GameModeClass));
+
+    // Squad size and tunables have to be in place before BeginPlay spawns the teams
+    World->SetGameMode(URL);
+    ADefaultGameMode* GM = Cast<ADefaultGameMode>(World->GetAuthGameMode());
+    if (!GM)
+    {
+        UE_LOG(LogTemp, Error, TEXT("MatchSim: %s is not running an ADefaultGameMode"), *MapName);
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        World->RemoveFromRoot();
+        return 1;
+    }
+    if (PlayersPerTeam > 0) GM->SetPlayersPerTeamOverride(PlayersPerTeam);
+    if (Scenario) ApplyTunables(GM, Scenario->Tunables);
+    ApplyTunables(GM, Tunables);
+
+    World->InitializeActorsForPlay(URL);
+    World->BeginPlay();
+
+    // Per-frame series for -Bench
+    const int32 ExpectedFrames = FMath::CeilToInt(Duration / Dt);
+    TArray<float> FrameMs, AIMs, PhysicsMs;
+    if (bBench)
+    {
+        FrameMs.Reserve(ExpectedFrames);
+        AIMs.Reserve(ExpectedFrames);
+        PhysicsMs.Reserve(ExpectedFrames);
+    }
+
+    // Physics: start of the physics frame to its end, including waits on the solver
+    double PhysicsStart = 0.0;
+    double PhysicsSeconds = 0.0;
+    FDelegateHandle PreHandle, PostHandle;
+    FPhysScene* PhysScene = World->GetPhysicsScene();
+    if (bBench && PhysScene)
+    {
+        PreHandle = PhysScene->OnPhysScenePreTick.AddLambda([&PhysicsStart](FChaosScene*, float) { PhysicsStart = FPlatformTime::Seconds(); });
+        PostHandle = PhysScene->OnPhysScenePostTick.AddLambda([&PhysicsStart, &PhysicsSeconds](FChaosScene*) { PhysicsSeconds += FPlatformTime::Seconds() - PhysicsStart; });
+    }
+
+#if CSV_PROFILER
+    if (bCsv) FCsvProfiler::Get()->BeginCapture();
+#endif
+
+    const double WallStart = FPlatformTime::Seconds();
+    double SimTime = 0.0;
+    int64 Frames = 0;
+
+    while (SimTime < Duration && !IsEngineExitRequested())
+    {
+#if CSV_PROFILER
+        if (bCsv) FCsvProfiler::Get()->BeginFrame();
+#endif
+        const double FrameStart = FPlatformTime::Seconds();
+        PhysicsSeconds = 0.0;
+
+        FApp::SetDeltaTime(Dt);
+        FApp::SetCurrentTime(FApp::GetCurrentTime() + Dt);
+
+        World->Tick(LEVELTICK_All, Dt);
+
+        // Async path queries and other game-thread work queued this frame
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+        if (bBench)
+        {
+            FrameMs.Add(static_cast<float>(1000.0 * (FPlatformTime::Seconds() - FrameStart)));
+            AIMs.Add(static_cast<float>(1000.0 * GM->GetRunStats().ThinkSecondsLast));
+            PhysicsMs.Add(static_cast<float>(1000.0 * PhysicsSeconds));
+        }
+#if CSV_PROFILER
+        if (bCsv) FCsvProfiler::Get()->EndFrame();
+#endif
+
+        SimTime += Dt;
+        ++Frames;
+    }
+
+    const double WallSeconds = FPlatformTime::Seconds() - WallStart;
+
+#if CSV_PROFILER
+    if (bCsv) FCsvProfiler::Get()->EndCapture();
+#endif
+    if (PhysScene)
+    {
+        PhysScene->OnPhysScenePreTick.Remove(PreHandle);
+        PhysScene->OnPhysScenePostTick.Remove(PostHandle);
+    }
+
+    // ---------- Report ----------
+    GM->StopReplayRecording(); // final size, and the file is complete before the world goes
+    const FMatchRunStats& Stats = GM->GetRunStats();
+    const FPathRequestManager& Paths = GM->GetPathRequests();
+    const ATeamGameState* GS = World->GetGameState<ATeamGameState>();
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("map"), MapName);
+    Root->SetStringField(TEXT("scenario"), ScenarioName);
+    Root->SetNumberField(TEXT("seed"), Seed);
+    Root->SetNumberField(TEXT("dt"), Dt);
+    Root->SetNumberField(TEXT("playersPerTeam"), GM->GetPlayersPerTeam());
+
+    TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetNumberField(TEXT("goals0"), GS ? GS->Score[0] : 0);
+    Result->SetNumberField(TEXT("goals1"), GS ? GS->Score[1] : 0);
+    Result->SetNumberField(TEXT("possessionLoose"), Stats.PossessionSeconds[0]);
+    Result->SetNumberField(TEXT("possession0"), Stats.PossessionSeconds[1]);
+    Result->SetNumberField(TEXT("possession1"), Stats.PossessionSeconds[2]);
+    Result->SetNumberField(TEXT("possessionChanges"), Stats.PossessionChanges);
+    Result->SetNumberField(TEXT("kicks"), Stats.Kicks);
+    Result->SetNumberField(TEXT("restarts"), Stats.Restarts);
+    Root->SetObjectField(TEXT("result"), Result);
+
+    TSharedRef<FJsonObject> Nav = MakeShared<FJsonObject>();
+    Nav->SetNumberField(TEXT("requested"), Paths.NumRequested);
+    Nav->SetNumberField(TEXT("suppressed"), Paths.NumSuppressed);
+    Nav->SetNumberField(TEXT("issued"), Paths.NumIssued);
+    Nav->SetNumberField(TEXT("completed"), Paths.NumCompleted);
+    Nav->SetNumberField(TEXT("failed"), Paths.NumFailed);
+    Root->SetObjectField(TEXT("paths"), Nav);
+
+    TSharedRef<FJsonObject> Timing = MakeShared<FJsonObject>();
+    Timing->SetNumberField(TEXT("simSeconds"), SimTime);
+    Timing->SetNumberField(TEXT("wallSeconds"), WallSeconds);
+    Timing->SetNumberField(TEXT("frames"), static_cast<double>(Frames));
+    Timing->SetNumberField(TEXT("speedup"), WallSeconds > 0.0 ? SimTime / WallSeconds : 0.0);
+    Timing->SetNumberField(TEXT("msPerFrame"), Frames > 0 ? 1000.0 * WallSeconds / Frames : 0.0);
+    Timing->SetNumberField(TEXT("thinkMsAvg"), Stats.Frames > 0 ? 1000.0 * Stats.ThinkSecondsTotal / Stats.Frames : 0.0);
+    Timing->SetNumberField(TEXT("thinkMsMax"), 1000.0 * Stats.ThinkSecondsMax);
+
+    // Pitch control per team plan: cost, and the share of the grid an incremental update recomputed
+    const int32 ControlUpdates = FMath::Max(Stats.PitchControlUpdates, 1);
+    const int32 ControlCells = FMath::Max(GM->GetPitchControl().GetNumCells(), 1);
+    Timing->SetNumberField(TEXT("pitchControlUsAvg"), 1.0e6 * Stats.PitchControlSecondsTotal / ControlUpdates);
+    Timing->SetNumberField(TEXT("pitchControlCellShare"), double(Stats.PitchControlCells) / ControlUpdates / ControlCells);
+    Root->SetObjectField(TEXT("timing"), Timing);
+
+    if (Stats.ReplayFrames > 0)
+    {
+        TSharedRef<FJsonObject> Replay = MakeShared<FJsonObject>();
+        Replay->SetStringField(TEXT("file"), GM->GetReplayRecorder().GetFilename());
+        Replay->SetNumberField(TEXT("frames"), Stats.ReplayFrames);
+        Replay->SetNumberField(TEXT("bytes"), static_cast<double>(Stats.ReplayBytes));
+        Replay->SetNumberField(TEXT("bytesPerMinute"), SimTime > 0.0 ? Stats.ReplayBytes * 60.0 / SimTime : 0.0);
+        Replay->SetNumberField(TEXT("recordUsAvg"), 1.0e6 * Stats.ReplayRecordSecondsTotal / Stats.ReplayFrames);
+        Root->SetObjectField(TEXT("replay"), Replay);
+    }
+
+    int32 Regressions = 0;
+    int32 MissingBaselines = 0;
+    if (bBench)
+    {
+        TMap<FString, FPercentiles> Series;
+        Series.Add(TEXT("frame"), FPercentiles::Of(FrameMs));
+        Series.Add(TEXT("ai"), FPercentiles::Of(AIMs));
+        Series.Add(TEXT("physics"), FPercentiles::Of(PhysicsMs));
+
+        TSharedRef<FJsonObject> Percentiles = MakeShared<FJsonObject>();
+        for (const TPair<FString, FPercentiles>& It : Series)
+        {
+            Percentiles->SetObjectField(It.Key, It.Value.ToJson());
+            UE_LOG(LogTemp, Display, TEXT("MatchSim: %-8s p50 %7.3f  p95 %7.3f  p99 %7.3f  max %7.3f ms"),
+                *It.Key, It.Value.P50, It.Value.P95, It.Value.P99, It.Value.Max);
+        }
+        Root->SetObjectField(TEXT("frameTimes"), Percentiles);
+
+        Regressions = CompareToBaseline(BaselinePath, ScenarioName, Series, Tolerance, MissingBaselines);
+        Root->SetNumberField(TEXT("regressions"), Regressions);
+        Root->SetNumberField(TEXT("missingBaselines"), MissingBaselines);
+
+        if (bWriteBaseline)
+        {
+            const bool bOk = WriteScenarioBaseline(BaselinePath, ScenarioName, Series);
+            UE_LOG(LogTemp, Display, TEXT("MatchSim: baseline for %s %s %s"), *ScenarioName,
+                bOk ? TEXT("written to") : TEXT("could not be written to"), *BaselinePath);
+        }
+    }
+
+    FString Json;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Root, Writer);
+
+    if (OutPath.IsEmpty())
+    {
+        OutPath = FPaths::ProjectSavedDir() / TEXT("MatchSim") /
+            FString::Printf(TEXT("MatchSim_%s_%d_%s.json"), *ScenarioName, Seed, *FDateTime::Now().ToString());
+    }
+    const bool bWritten = FFileHelper::SaveStringToFile(Json, *OutPath);
+
+    UE_LOG(LogTemp, Display, TEXT("MatchSim: %.0f s simulated in %.1f s (x%.1f), %d-%d -> %s"),
+        SimTime, WallSeconds, WallSeconds > 0.0 ? SimTime / WallSeconds : 0.0,
+        GS ? GS->Score[0] : 0, GS ? GS->Score[1] : 0, *OutPath);
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    World->RemoveFromRoot();
+
+    if (!bWritten) return 1;
+    if (bWriteBaseline) return 0;
+    return (Regressions > 0) ? 2 : (MissingBaselines > 0) ? 3 : 0;
+}
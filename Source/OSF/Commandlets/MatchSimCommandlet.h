@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MatchSimCommandlet.generated.h"
+
+/**
+ * Headless fast-forward match: loads the match map, lets ADefaultGameMode spawn
+ * both teams as usual and ticks the world on a fixed step as fast as the CPU
+ * allows. No rendering, audio or debug draw. Results and timing go to JSON.
+ *
+ *   UnrealEditor-Cmd OSF.uproject -run=MatchSim -nullrhi -nosound -unattended
+ *       [-Map=/Game/Maps/Example_Map] [-GameMode=/Game/Blueprints/BPGameMode.BPGameMode_C]
+ *       [-Duration=5400] [-Dt=0.0166667] [-Seed=0] [-PlayersPerTeam=0] [-Out=<file.json>]
+ *       [-Scenario=11v11|30v30|Pressing] [-Set=HomeWeight=0.4,RetreatWithBall=600]
+ *       [-Bench [-Baseline=<file.json>] [-Tolerance=0.1] [-WriteBaseline] [-Csv]]
+ *
+ * -Scenario picks squad size and tunables (and a 5 minute segment unless -Duration
+ * is given). -Bench records frame, AI (Think) and physics time per frame, reports
+ * p50/p95/p99/max and compares against Bench/MatchBaseline.json; the exit code is
+ * 2 when any p95/p99 is over the baseline by more than Tolerance, and 3 when the
+ * baseline has no entry for the scenario (record one with -WriteBaseline on the
+ * reference machine and check it in). -Csv also captures a CSV profile (OSF
+ * category: Think, UpdatePossession).
+ * Possession in the report comes from AI ball control, so it moves without a
+ * PlayerController; "kicks" counts every KickBall.
+ * -Set=bRecordReplay=true[,ReplayPath=<file.osfreplay>] records the match; the
+ * report's "replay" block has its size and recording cost.
+ */
+UCLASS()
+class OSF_API UMatchSimCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMatchSimCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
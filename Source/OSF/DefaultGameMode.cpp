@@ -8,15 +8,111 @@
 #include "AIController.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Async/ParallelFor.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicsPublic.h"
+#include "Engine/Engine.h"
+#include "Misc/Paths.h"
 
 #include "Footballer.h"
 #include "FootballTeam.h"
 #include "Ballsack.h"
+#include "BallFlightComponent.h"
+#include "Goal.h"
+#include "TeamGameState.h"
 #include "FormationRow.h"
+#include "FormationZoneAsset.h"
+#include "OSFStats.h"
+#include "MatchRegistrySubsystem.h"
+
+static TAutoConsoleVariable<int32> CVarAIUpdateBudget(
+    TEXT("osf.AI.UpdateBudget"),
+    8,
+    TEXT("Max footballers whose AI decision runs per frame (<= 0: no cap)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAIDebugDraw(
+    TEXT("osf.AI.DebugDraw"),
+    1,
+    TEXT("Draw AI targets and keeper boxes (0 = off, e.g. headless runs)."),
+    ECVF_Default);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdAIDumpCost(
+    TEXT("osf.AI.DumpCost"),
+    TEXT("Log the footballers with the most expensive AI decisions: osf.AI.DumpCost [TopN=5]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (const ADefaultGameMode* GM = World ? World->GetAuthGameMode<ADefaultGameMode>() : nullptr)
+            {
+                GM->DumpAICost(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 5);
+            }
+        }));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdAIFormation(
+    TEXT("osf.AI.Formation"),
+    TEXT("Switch a team's formation: osf.AI.Formation Team Name [BlendSeconds]; no arguments lists the loaded formations"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            ADefaultGameMode* GM = World ? World->GetAuthGameMode<ADefaultGameMode>() : nullptr;
+            if (!GM) return;
+            if (Args.Num() < 2 || !GM->SetTeamFormation(FCString::Atoi(*Args[0]), FName(*Args[1]), Args.Num() > 2 ? FCString::Atof(*Args[2]) : -1.f))
+            {
+                GM->DumpFormations();
+            }
+        }));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdReplayRecord(
+    TEXT("osf.Replay.Record"),
+    TEXT("Record the match: osf.Replay.Record [File]; default Saved/Replays/Match-<time>.osfreplay"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (ADefaultGameMode* GM = World ? World->GetAuthGameMode<ADefaultGameMode>() : nullptr)
+            {
+                GM->StartReplayRecording(Args.Num() > 0 ? Args[0] : FString());
+            }
+        }));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdReplayStop(
+    TEXT("osf.Replay.Stop"),
+    TEXT("Finish the recording started by osf.Replay.Record or bRecordReplay"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (ADefaultGameMode* GM = World ? World->GetAuthGameMode<ADefaultGameMode>() : nullptr)
+            {
+                GM->StopReplayRecording();
+            }
+        }));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdReplayView(
+    TEXT("osf.Replay.View"),
+    TEXT("Draw a recording over the scene: osf.Replay.View File [Seconds=0] [Rate=1]; no arguments closes it"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            ADefaultGameMode* GM = World ? World->GetAuthGameMode<ADefaultGameMode>() : nullptr;
+            if (!GM) return;
+            if (Args.Num() == 0)
+            {
+                GM->CloseReplayView();
+                return;
+            }
+            GM->OpenReplayView(Args[0], Args.Num() > 1 ? FCString::Atod(*Args[1]) : 0.0, Args.Num() > 2 ? FCString::Atof(*Args[2]) : 1.f);
+        }));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdReplaySeek(
+    TEXT("osf.Replay.Seek"),
+    TEXT("Jump the viewed recording to a time: osf.Replay.Seek Seconds"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (ADefaultGameMode* GM = World ? World->GetAuthGameMode<ADefaultGameMode>() : nullptr)
+            {
+                if (Args.Num() > 0) GM->SeekReplayView(FCString::Atod(*Args[0]));
+            }
+        }));
 
 ADefaultGameMode::ADefaultGameMode()
 {
-    PrimaryActorTick.bCanEverTick = false; // timer-driven
+    PrimaryActorTick.bCanEverTick = true; // AI is spread across frames by the LOD scheduler
+    PathRequests.Init(this);
     Team0Players.Reserve(11);
     Team1Players.Reserve(11);
 }
@@ -31,12 +127,27 @@ void ADefaultGameMode::BeginPlay()
         BuildBaseFormation();
         PlayersPerTeam = BaseFormation_Local.Num() > 0 ? BaseFormation_Local.Num() : PlayersPerTeam;
     }
+    if (PlayersPerTeamOverride > 0) PlayersPerTeam = PlayersPerTeamOverride;
+    LoadFormations();
 
     FieldCentreWS = FVector::ZeroVector;
+    Kernel.ProjectToGround = [this](const FVector& XY) { return ProjectXYToGround(XY); };
+    SyncKernel();
+    RebuildGroundCache(); // before spawning, so the grid never samples players
     SpawnTeams();
 
-    // Ball
-    if (BallClass && UGameplayStatics::GetActorOfClass(GetWorld(), BallClass) == nullptr)
+    // Ball: follow the registry so a respawned ball is picked up without a search
+    UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this);
+    if (Registry)
+    {
+        Registry->OnBallChanged.AddWeakLambda(this, [this](ABallsack* NewBall) { Ball = NewBall; });
+    }
+
+    if (Registry && Registry->GetBall())
+    {
+        Ball = Registry->GetBall();
+    }
+    else if (BallClass && UGameplayStatics::GetActorOfClass(GetWorld(), BallClass) == nullptr)
     {
         const FVector BallLoc = ProjectXYToGround(FieldCentreWS) + FVector(0, 0, 20.f);
         Ball = GetWorld()->SpawnActor<ABallsack>(BallClass, BallLoc, FRotator::ZeroRotator);
@@ -56,15 +167,128 @@ void ADefaultGameMode::BeginPlay()
         }
     }
 
-    GetWorldTimerManager().SetTimer(ThinkTimer, this, &ADefaultGameMode::Think, 0.1f, true); // 10 Hz
+    // Rules: lines from the tunables or the placed goals, checked once per scene step; with substepping the sweep spans all of that step's substeps
+    SyncPitchRules();
+    if (Registry) Registry->OnGoalsChanged.AddUObject(this, &ADefaultGameMode::SyncPitchRules);
+    if (FPhysScene* PhysScene = GetWorld()->GetPhysicsScene())
+    {
+        PhysicsStepHandle = PhysScene->OnPhysSceneStep.AddUObject(this, &ADefaultGameMode::OnPhysicsStep);
+    }
+    bHaveLastBallPos = false;
+    BallPrediction.Configure(BallPredictionHorizon, BallPredictionRate);
+
+    NextTeamPlanTime = 0.0;
+    AIScheduler.Reset();
+    RunStats = FMatchRunStats();
+
+    if (bRecordReplay) StartReplayRecording(ReplayPath);
+}
+
+void ADefaultGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr)
+    {
+        PhysScene->OnPhysSceneStep.Remove(PhysicsStepHandle);
+    }
+    if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this))
+    {
+        Registry->OnBallChanged.RemoveAll(this);
+        Registry->OnGoalsChanged.RemoveAll(this);
+    }
+    StopReplayRecording();
+    CloseReplayView();
+    Super::EndPlay(EndPlayReason);
+}
+
+void ADefaultGameMode::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    Formations.Advance(DeltaSeconds);
+
+    const double ThinkStart = FPlatformTime::Seconds();
+    {
+        CSV_SCOPED_TIMING_STAT(OSF, Think);
+        Think();
+    }
+    const double ThinkSeconds = FPlatformTime::Seconds() - ThinkStart;
+
+    if (Replay.IsRecording())
+    {
+        const double RecordStart = FPlatformTime::Seconds();
+        Replay.Capture(Snapshot, GetWorld()->GetTimeSeconds(), Snapshot.Find(PossessingPlayer.Get()), PossessingTeamID);
+        RunStats.ReplayRecordSecondsTotal += FPlatformTime::Seconds() - RecordStart;
+        RunStats.ReplayBytes = Replay.BytesRecorded;
+        RunStats.ReplayFrames = Replay.FramesRecorded;
+    }
+    if (ReplayView.IsOpen()) DrawReplayView(DeltaSeconds);
+
+    RunStats.SimSeconds += DeltaSeconds;
+    RunStats.Frames++;
+    RunStats.PossessionSeconds[FMath::Clamp(PossessingTeamID + 1, 0, 2)] += DeltaSeconds;
+    RunStats.ThinkSecondsTotal += ThinkSeconds;
+    RunStats.ThinkSecondsMax = FMath::Max(RunStats.ThinkSecondsMax, ThinkSeconds);
+    RunStats.ThinkSecondsLast = ThinkSeconds;
 }
 
 // ---------------- Possession ----------------
 void ADefaultGameMode::NotifyPossession(AFootballer* NewOwner)
 {
+    const int32 NewTeam = NewOwner ? NewOwner->TeamID : -1;
+    if (NewTeam != PossessingTeamID && NewTeam >= 0)
+    {
+        RunStats.PossessionChanges++;
+        INC_DWORD_STAT(STAT_OSF_PossessionChanges);
+    }
     PossessingPlayer = NewOwner;
     PossessingTeamID = NewOwner ? NewOwner->TeamID : -1;
+    if (NewTeam >= 0) LastTouchTeamID = NewTeam;
 }
+
+void ADefaultGameMode::NotifyTouch(AFootballer* Toucher, bool bControl)
+{
+    if (!Toucher || (Toucher->TeamID != 0 && Toucher->TeamID != 1)) return;
+    LastTouchTeamID = Toucher->TeamID;
+
+    if (bControl)
+    {
+        if (PossessingPlayer.Get() != Toucher) NotifyPossession(Toucher);
+        return;
+    }
+
+    // Kicked: the ball is loose until someone controls it, and not the kicker straight away
+    RunStats.Kicks++;
+    ClearPossession(Toucher);
+    LastKicker = Toucher;
+    LastKickTime = GetWorld()->GetTimeSeconds();
+}
+
+void ADefaultGameMode::UpdateBallControl()
+{
+    // AI players take a slow, low ball they reach; humans take it through their controller
+    float DistSq = 0.f;
+    const int32 Idx = Snapshot.Nearest(0, Snapshot.Num, Snapshot.BallPos, nullptr, &DistSq);
+    AFootballer* P = (Idx != INDEX_NONE && !Snapshot.Human[Idx]) ? Snapshot.Players[Idx] : nullptr;
+    const bool bJustKicked = P && P == LastKicker.Get() && GetWorld()->GetTimeSeconds() - LastKickTime < CarrierKickCooldown;
+    const bool bControl = P && !bJustKicked
+        && DistSq <= FMath::Square(CarrierKickReach)
+        && Snapshot.BallPos.Z - FieldCentreWS.Z <= InterceptMaxHeight
+        && (Snapshot.BallVel - Snapshot.GetVel(Idx)).SizeSquared2D() <= FMath::Square(CarrierMaxBallSpeed);
+
+    if (bControl)
+    {
+        NotifyTouch(P, true);
+        return;
+    }
+
+    // An AI holder that lost the ball
+    const AFootballer* Holder = PossessingPlayer.Get();
+    if (Holder && !(Holder->GetController() && Holder->GetController()->IsPlayerController()) && Holder != P)
+    {
+        ClearPossession(PossessingPlayer.Get());
+    }
+}
+
 void ADefaultGameMode::ClearPossession(AFootballer* OldOwner)
 {
     if (PossessingPlayer.Get() == OldOwner)
@@ -84,6 +308,13 @@ void ADefaultGameMode::SpawnTeams()
     if (Team0) Team0->TeamID = 0;
     if (Team1) Team1->TeamID = 1;
 
+    // TeamID is set after BeginPlay registered them; register again under the right slot
+    if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this))
+    {
+        Registry->RegisterTeam(Team0);
+        Registry->RegisterTeam(Team1);
+    }
+
     for (int32 i = 0; i < PlayersPerTeam; ++i)
     {
         SpawnOne(0, i, Team0, Team0Players);
@@ -98,10 +329,7 @@ void ADefaultGameMode::SpawnOne(int32 TeamID, int32 Index, AFootballTeam* TeamAc
 {
     if (!TeamActor || !FootballerClass) return;
 
-    const FVector L = FormationLocal(Index);
-    const FVector LocalForTeam = (TeamID == 0) ? L : FVector(-L.X, -L.Y, L.Z);
-
-    const FVector XYWorld = ClampToField(ToWorld(LocalForTeam));
+    const FVector XYWorld = Kernel.ClampToField(Kernel.HomeWorld(TeamID, Index));
     FVector SpawnLoc = ProjectXYToGround(XYWorld);
     const FRotator SpawnRot(0.f, TeamHalfAngle(TeamID), 0.f);
 
@@ -140,396 +368,661 @@ void ADefaultGameMode::SpawnOne(int32 TeamID, int32 Index, AFootballTeam* TeamAc
 // ---------------- Formation helpers ----------------
 void ADefaultGameMode::BuildFormationFromTable()
 {
-    BaseFormation_Local.Reset();
-    BaseRoles.Reset();
-
-    if (!FormationTable)
+    if (!ReadFormationRows(FormationTable, BaseFormation_Local, &BaseRoles))
     {
         BuildBaseFormation();
-        PlayersPerTeam = BaseFormation_Local.Num() > 0 ? BaseFormation_Local.Num() : PlayersPerTeam;
+        PlayersPerTeam = BaseFormation_Local.Num() > 0 ? BaseFormation_Local.Num() : 11;
         return;
     }
+    PlayersPerTeam = BaseFormation_Local.Num();
+}
 
-    TArray<FName> RowNames = FormationTable->GetRowNames();
+void ADefaultGameMode::LoadFormations()
+{
+    Formations = FFormationSet();
+    PrimaryFormation = FormationTable ? FormationTable->GetFName() : FName(TEXT("Default"));
+    Formations.Add(PrimaryFormation, BaseFormation_Local);
 
-    struct FRowTmp { int32 Index; FVector Pos; uint8 Role; };
-    TArray<FRowTmp> Rows; Rows.Reserve(RowNames.Num());
+    TArray<FVector> Local;
+    for (const UDataTable* Table : ExtraFormationTables)
+    {
+        if (Table && Table != FormationTable && ReadFormationRows(Table, Local))
+        {
+            Formations.Add(Table->GetFName(), Local);
+        }
+    }
 
-    for (const FName& RowName : RowNames)
+    // Shared with every other match using the same assets
+    for (const UFormationZoneAsset* Asset : FormationZones)
     {
-        const FFormationRow* Row = FormationTable->FindRow<FFormationRow>(RowName, TEXT("FormationRead"));
-        if (!Row) continue;
-        Rows.Add({ Row->Index, Row->LocalPosition, static_cast<uint8>(Row->Role) });
+        if (!Asset || !Asset->GetZones().IsValid()) continue;
+        const int32 Index = Formations.Find(Asset->Formation ? Asset->Formation->GetFName() : PrimaryFormation);
+        UE_CLOG(Index == INDEX_NONE, LogTemp, Warning, TEXT("%s: its formation is not loaded"), *Asset->GetName());
+        Formations.SetZones(Index, &Asset->GetZones());
     }
+}
 
-    Rows.Sort([](const FRowTmp& A, const FRowTmp& B) { return A.Index < B.Index; });
+bool ADefaultGameMode::SetTeamFormation(int32 TeamID, FName Formation, float BlendSeconds)
+{
+    const int32 Index = Formations.Find(Formation);
+    if (TeamID < 0 || TeamID > 1 || Index == INDEX_NONE) return false;
+
+    Formations.SwitchTo(TeamID, Index, BlendSeconds < 0.f ? FormationBlendTime : BlendSeconds);
+    return true;
+}
 
-    for (const FRowTmp& R : Rows)
+bool ADefaultGameMode::BlendTeamFormations(int32 TeamID, FName From, FName To, float Alpha)
+{
+    const int32 FromIndex = Formations.Find(From);
+    const int32 ToIndex = Formations.Find(To);
+    if (TeamID < 0 || TeamID > 1 || FromIndex == INDEX_NONE || ToIndex == INDEX_NONE) return false;
+
+    Formations.SetBlend(TeamID, FromIndex, ToIndex, Alpha);
+    return true;
+}
+
+void ADefaultGameMode::DumpFormations() const
+{
+    for (int32 i = 0; i < Formations.Num(); ++i)
     {
-        BaseFormation_Local.Add(R.Pos);
-        BaseRoles.Add(R.Role);
+        UE_LOG(LogTemp, Display, TEXT("Formation %d: %s"), i, *Formations.GetName(i).ToString());
     }
-
-    PlayersPerTeam = BaseFormation_Local.Num();
-    if (PlayersPerTeam <= 0)
+    for (int32 TeamID = 0; TeamID < 2; ++TeamID)
     {
-        BuildBaseFormation();
-        PlayersPerTeam = BaseFormation_Local.Num() > 0 ? BaseFormation_Local.Num() : 11;
+        UE_LOG(LogTemp, Display, TEXT("Team %d plays %s"), TeamID, *Formations.GetName(Formations.GetFormation(TeamID)).ToString());
     }
 }
 
 void ADefaultGameMode::BuildBaseFormation()
 {
-    BaseFormation_Local.Empty(11);
+    FMatchKernel::MakeDefaultFormation(HalfLength, BaseFormation_Local);
+}
 
-    // GK (index 0)
-    BaseFormation_Local.Add(FVector(-HalfLength + 500.f, 0.f, 0.f)); // 0
+void ADefaultGameMode::SyncKernel()
+{
+    FTacticParams& T = Kernel.Tactics;
+    T.FieldCentre = FieldCentreWS;
+    T.HalfLength = HalfLength;
+    T.HalfWidth = HalfWidth;
+    T.HomeWeight = HomeWeight;
+    T.AdvanceWithBall = AdvanceWithBall;
+    T.RetreatWithBall = RetreatWithBall;
+    T.SupportAhead = SupportAhead;
+    T.SupportWide = SupportWide;
+    T.SpaceSearch = SpaceSearch;
+    T.ArriveRadius = ArriveRadius;
+    T.SeparationRadius = SeparationRadius;
+    T.SeparationStrength = SeparationStrength;
+    T.KeeperDepth = KeeperDepth;
+    T.KeeperChaseRadius = KeeperChaseRadius;
+    T.PenBoxDepth = PenBoxDepth;
+    T.PenBoxHalfWidth = PenBoxHalfWidth;
+    T.MarkSwitchPenalty = MarkSwitchPenalty;
+    T.BallLeadTime = BallLeadTime;
+    T.ChaserHysteresis = ChaserHysteresis;
+    T.KickReach = CarrierKickReach;
+    T.KickMaxBallSpeed = CarrierMaxBallSpeed;
+    T.ShotRange = CarrierShotRange;
+    T.ShotMinChance = CarrierShotMinChance;
+    T.PassMinScore = CarrierPassMinScore;
+    T.PressureRadius = CarrierPressureRadius;
+
+    Intercepts.Params.ReactionTime = InterceptReactionTime;
+    Intercepts.Params.ControlRadius = InterceptControlRadius;
+    Intercepts.Params.MaxHeight = InterceptMaxHeight;
+
+    Passes.Params.BallDrag = (PassBallDrag > 0.f) ? PassBallDrag : FittedPassDrag;
+    Passes.Params.ArrivalSpeed = PassArrivalSpeed;
+    Passes.Params.MaxSpeed = PassMaxSpeed;
+    Passes.Params.RiskWeight = PassRiskWeight;
+    Passes.Params.AimWeight = PassAimWeight;
+    Passes.Params.SpaceWeight = PassSpaceWeight;
+
+    PitchControl.Params.MoveThreshold = PitchControlMoveThreshold;
+    PitchControl.Params.ReactionTime = InterceptReactionTime;
+    PitchControl.Params.ControlRadius = InterceptControlRadius;
+
+    if (Kernel.Formation != BaseFormation_Local)
+    {
+        Kernel.Formation = BaseFormation_Local;
+        Formations.Add(PrimaryFormation, BaseFormation_Local);
+    }
 
-    // DEF
-    const float DefX = -HalfLength * 0.5f;
-    BaseFormation_Local.Add(FVector(DefX, -1400.f, 0.f)); // 1
-    BaseFormation_Local.Add(FVector(DefX, -400.f, 0.f)); // 2
-    BaseFormation_Local.Add(FVector(DefX, +400.f, 0.f)); // 3
-    BaseFormation_Local.Add(FVector(DefX, +1400.f, 0.f)); // 4
+    // Homes compiled once per pitch, shift and ground; without the cache that would trace every slot, so wait for it
+    if (!Formations.IsCompiledFor(Kernel, PlayersPerTeam) && (GroundCache.IsBuilt() || GroundCacheSpacing <= 0.f))
+    {
+        Formations.Compile(Kernel, PlayersPerTeam);
+    }
+    Kernel.Formations = Formations.IsCompiledFor(Kernel, PlayersPerTeam) ? &Formations : nullptr;
+}
 
-    // MID
-    const float MidX = 0.f;
-    BaseFormation_Local.Add(FVector(MidX, -1600.f, 0.f)); // 5
-    BaseFormation_Local.Add(FVector(MidX, -500.f, 0.f)); // 6
-    BaseFormation_Local.Add(FVector(MidX, 500.f, 0.f)); // 7
-    BaseFormation_Local.Add(FVector(MidX, +1600.f, 0.f)); // 8
+// ---------------- Replay ----------------
+bool ADefaultGameMode::StartReplayRecording(const FString& Path)
+{
+    const FString File = !Path.IsEmpty() ? Path
+        : FPaths::ProjectSavedDir() / TEXT("Replays") / FString::Printf(TEXT("Match-%s.osfreplay"), *FDateTime::Now().ToString());
 
-    // FWD
-    const float FwdX = HalfLength * 0.35f;
-    BaseFormation_Local.Add(FVector(FwdX, -800.f, 0.f)); // 9
-    BaseFormation_Local.Add(FVector(FwdX, +800.f, 0.f)); // 10
+    Replay.Params.KeyframeInterval = FMath::Max(ReplayKeyframeInterval, 0.05f);
+    Replay.Params.FrameInterval = FMath::Max(ReplayFrameInterval, 0.f);
+    if (!Replay.Start(File))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Replay: cannot write %s"), *File);
+        return false;
+    }
+
+    RunStats.ReplayBytes = 0;
+    RunStats.ReplayFrames = 0;
+    RunStats.ReplayRecordSecondsTotal = 0.0;
+    UE_LOG(LogTemp, Display, TEXT("Replay: recording to %s"), *File);
+    return true;
 }
 
-FVector ADefaultGameMode::FormationLocal(int32 Index) const
+void ADefaultGameMode::StopReplayRecording()
 {
-    return BaseFormation_Local.IsValidIndex(Index) ? BaseFormation_Local[Index] : FVector::ZeroVector;
+    if (!Replay.IsRecording()) return;
+
+    Replay.Stop();
+    RunStats.ReplayBytes = Replay.BytesRecorded;
+    RunStats.ReplayFrames = Replay.FramesRecorded;
+    UE_LOG(LogTemp, Display, TEXT("Replay: %d frames, %lld bytes in %s"),
+        Replay.FramesRecorded, Replay.BytesRecorded, *Replay.GetFilename());
 }
-FVector ADefaultGameMode::ToWorld(const FVector& Local) const { return FieldCentreWS + Local; }
 
-FVector ADefaultGameMode::ClampToField(const FVector& P) const
+void ADefaultGameMode::RecordReplayEvent(EReplayEvent Type, const AFootballer* Player, const FVector& Value, int32 Team)
 {
-    FVector Out = P;
-    Out.X = FMath::Clamp(Out.X, FieldCentreWS.X - HalfLength, FieldCentreWS.X + HalfLength);
-    Out.Y = FMath::Clamp(Out.Y, FieldCentreWS.Y - HalfWidth, FieldCentreWS.Y + HalfWidth);
-    return Out;
+    if (!Replay.IsRecording()) return;
+
+    FReplayEvent E;
+    E.Type = Type;
+    E.Player = Snapshot.Find(Player);
+    E.Team = (Team == INDEX_NONE && Player) ? Player->TeamID : Team;
+    E.Value = Value;
+    Replay.AddEvent(E);
 }
-float ADefaultGameMode::TeamHalfAngle(int32 TeamID) const { return (TeamID == 0) ? 0.f : 180.f; }
 
-// ---------------- Grounding ----------------
-FVector ADefaultGameMode::ProjectXYToGround(const FVector& XY) const
+bool ADefaultGameMode::OpenReplayView(const FString& Path, double Time, float Rate)
 {
-    const FVector Start(XY.X, XY.Y, FieldCentreWS.Z + GroundTraceUp);
-    const FVector End(XY.X, XY.Y, FieldCentreWS.Z - GroundTraceDown);
+    if (!ReplayView.Open(Path))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Replay: cannot read %s"), *Path);
+        return false;
+    }
 
-    FHitResult Hit;
-    FCollisionQueryParams Params(SCENE_QUERY_STAT(ProjectXYToGround), false);
-    Params.bReturnPhysicalMaterial = false;
-    Params.AddIgnoredActor(this);
+    ReplayViewRate = Rate;
+    SeekReplayView(Time);
+    UE_LOG(LogTemp, Display, TEXT("Replay: viewing %s, %.1f s in %d chunks"), *Path, ReplayView.GetDuration(), ReplayView.GetNumChunks());
+    return true;
+}
 
-    const bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, Start, End, GroundTraceChannel, Params);
-    const float Z = bHit ? Hit.Location.Z : FieldCentreWS.Z;
-    return FVector(XY.X, XY.Y, Z + GroundZOffset);
+void ADefaultGameMode::SeekReplayView(double Time)
+{
+    ReplayViewTime = FMath::Clamp<double>(Time, 0.0, ReplayView.GetDuration());
 }
 
-void ADefaultGameMode::SnapActorToGround(AActor* Actor) const
+void ADefaultGameMode::CloseReplayView()
 {
-    if (!Actor) return;
+    ReplayView.Close();
+}
 
-    FVector L = Actor->GetActorLocation();
-    L = ProjectXYToGround(L);
+void ADefaultGameMode::DrawReplayView(float DeltaSeconds)
+{
+    ReplayViewTime = FMath::Clamp<double>(ReplayViewTime + DeltaSeconds * ReplayViewRate, 0.0, ReplayView.GetDuration());
+    const FReplayFrame* F = ReplayView.Seek(ReplayViewTime);
+    if (!F) return;
 
-    if (UCapsuleComponent* Cap = Actor->FindComponentByClass<UCapsuleComponent>())
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+    UWorld* World = GetWorld();
+    for (int32 i = 0; i < F->Players.Num(); ++i)
     {
-        L.Z += Cap->GetScaledCapsuleHalfHeight();
+        const FReplayPlayer& P = F->Players[i];
+        if (!P.bValid) continue;
+        const FColor Col = P.bHuman ? FColor::Yellow : (P.Team == 0) ? FColor::Blue : FColor::Red;
+        DrawDebugCapsule(World, P.Pos, 90.f, 35.f, FQuat::Identity, Col, false, -1.f, 0, (i == F->PossessionPlayer) ? 3.f : 1.f);
+        DrawDebugDirectionalArrow(World, P.Pos, P.Pos + FRotator(0.f, P.Yaw, 0.f).Vector() * 80.f, 30.f, Col, false, -1.f, 0, 2.f);
     }
-
-    Actor->SetActorLocation(L, false, nullptr, ETeleportType::TeleportPhysics);
+    DrawDebugSphere(World, F->BallPos, BallRadius * 2.f, 12, FColor::White, false, -1.f, 0, 2.f);
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(reinterpret_cast<uint64>(this), 0.f, FColor::White,
+            FString::Printf(TEXT("Replay %.1f / %.1f s (x%.2f)"), F->Time, ReplayView.GetDuration(), ReplayViewRate));
+    }
+#endif
 }
 
-// ---------------- Brain ----------------
-void ADefaultGameMode::Think()
+// ---------------- Rules ----------------
+void ADefaultGameMode::SyncPitchRules()
 {
-    int32 AttackingTeam = PossessingTeamID;
+    FPitchGeometry& G = Rules.Geometry;
+    G.Centre = FieldCentreWS;
+    G.HalfLength = HalfLength;
+    G.HalfWidth = HalfWidth;
+    for (FPitchGoal& Goal : G.Goals)
+    {
+        Goal.CentreY = 0.f;
+        Goal.HalfWidth = GoalHalfWidth;
+        Goal.CrossbarHeight = CrossbarHeight;
+    }
+    G.BallRadius = BallRadius;
+
+    // A placed goal is the truth for its own mouth (inner post faces, underside of the bar)
+    // and, averaged over both ends, for the goal line (post centres)
+    const UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this);
+    bool bPlaced[2] = { false, false };
+    FGoalMouth Mouths[2];
+    float LineSum = 0.f;
+    const TArray<AGoal*> NoGoals;
+    for (const AGoal* Goal : Registry ? Registry->GetGoals() : NoGoals)
+    {
+        if (!IsValid(Goal) || !Goal->LeftPost || !Goal->RightPost || !Goal->Crossbar) continue;
 
-    const AActor* BallActor = Ball ? static_cast<AActor*>(Ball)
-        : UGameplayStatics::GetActorOfClass(GetWorld(), ABallsack::StaticClass());
-    const FVector BallLoc = BallActor ? BallActor->GetActorLocation() : FieldCentreWS;
+        const FGoalMouth Mouth = FGoalMouth::FromFrame(Goal->LeftPost->Bounds, Goal->RightPost->Bounds, Goal->Crossbar->Bounds,
+            FieldCentreWS.Z, FieldCentreWS);
+        const int32 End = (Mouth.Centre.X >= FieldCentreWS.X) ? 1 : 0;
+        if (bPlaced[End]) continue;
 
-    if (AttackingTeam < 0)
+        bPlaced[End] = true;
+        Mouths[End] = Mouth;
+        LineSum += FMath::Abs(Mouth.Centre.X - FieldCentreWS.X);
+
+        FPitchGoal& Line = G.Goals[End];
+        Line.CentreY = Mouth.Centre.Y - FieldCentreWS.Y;
+        Line.HalfWidth = Mouth.HalfWidth;
+        Line.CrossbarHeight = Mouth.Height;
+    }
+    const int32 NumPlaced = (bPlaced[0] ? 1 : 0) + (bPlaced[1] ? 1 : 0);
+    if (NumPlaced > 0) G.HalfLength = LineSum / NumPlaced;
+
+    // Kicks aimed with the model that moves the ball (tables rebuilt here, not per kick)
+    const UBallFlightComponent* Flight = Ball ? Ball->Flight : nullptr;
+    const bool bFlight = Flight && Flight->IsDriving();
+    const FBallFlight& BallModel = bFlight ? Flight->GetModel() : FallbackBallModel;
+    Kicks.Configure(BallModel.Params, bFlight ? BallModel.GroundZ : static_cast<float>(FieldCentreWS.Z));
+    Passes.Kicks = &Kicks;
+    FittedPassDrag = FPassEvaluator::FitBallDrag(BallModel.Params, PassArrivalSpeed, Passes.Params.MinLength, Passes.Params.MaxLength);
+
+    // Pitch control over the rules' pitch; the next team plan computes every cell
+    PitchControl.Params.CellSize = PitchControlCellSize;
+    PitchControl.Configure(FieldCentreWS, G.HalfLength, G.HalfWidth);
+    Kernel.Control = &PitchControl;
+    Passes.Control = &PitchControl;
+    Kernel.Passes = &Passes;
+
+    // Shot aim points from the goal frames themselves, else the rules' mouth
+    for (int32 End = 0; End < 2; ++End)
     {
-        auto MinDistToBall = [&](const TArray<AFootballer*>& Team)->float
-            {
-                float Best = TNumericLimits<float>::Max();
-                for (AFootballer* P : Team)
-                {
-                    if (!IsValid(P)) continue;
-                    Best = FMath::Min(Best, FVector::DistSquared(P->GetActorLocation(), BallLoc));
-                }
-                return Best;
-            };
+        FShotEvaluator& Shot = Shots[End];
+        Shot.Kicks = &Kicks;
+        Shot.Params.Speed = ShotSpeed;
+        Shot.Params.AimErrorDeg = ShotAimErrorDeg;
+        Shot.Params.AimWeight = ShotAimWeight;
+        Shot.Params.BallRadius = BallRadius;
+
+        if (bPlaced[End])
+        {
+            Shot.Configure(Mouths[End]);
+        }
+        else
+        {
+            const FPitchGoal& Line = G.Goals[End];
+            const FVector Centre = FieldCentreWS + FVector((End == 1 ? 1.f : -1.f) * G.HalfLength, Line.CentreY, 0.f);
+            Shot.Configure(FGoalMouth::FromLine(Centre, Line.HalfWidth, Line.CrossbarHeight, FieldCentreWS));
+        }
+        Kernel.Shots[End] = &Shot;
+    }
+}
+
+void ADefaultGameMode::OnPhysicsStep(FChaosScene* Scene, float StepSeconds)
+{
+    OSF_SCOPE(PitchRules);
 
-        const float D0 = MinDistToBall(Team0Players);
-        const float D1 = MinDistToBall(Team1Players);
-        AttackingTeam = (D0 <= D1) ? 0 : 1;
+    if (!Ball)
+    {
+        bHaveLastBallPos = false;
+        BallPrediction.Reset();
+        return;
     }
 
-    DriveTeamAI(Team0Players, 0, AttackingTeam == 0);
-    DriveTeamAI(Team1Players, 1, AttackingTeam == 1);
+    FPitchEventInfo Event;
+    if (bHaveLastBallPos && Rules.Sweep(LastBallPos, Ball->GetActorLocation(), LastTouchTeamID, Event))
+    {
+        HandlePitchEvent(Event);
+    }
+
+    // Read again: a restart has moved the ball
+    LastBallPos = Ball->GetActorLocation();
+    bHaveLastBallPos = true;
+
+    UpdateBallPrediction();
 }
 
-static AFootballer* ClosestTo(const TArray<AFootballer*>& Arr, const FVector& Pt, const TSet<AFootballer*>& Exclude = {})
+void ADefaultGameMode::UpdateBallPrediction()
 {
-    AFootballer* Best = nullptr; float BestD = TNumericLimits<float>::Max();
-    for (AFootballer* P : Arr)
+    const double Now = GetWorld()->GetTimeSeconds();
+    const UBallFlightComponent* Flight = Ball->Flight;
+    if (Flight && Flight->IsDriving())
     {
-        if (!IsValid(P) || Exclude.Contains(P)) continue;
-        const float D = FVector::DistSquared(P->GetActorLocation(), Pt);
-        if (D < BestD) { BestD = D; Best = P; }
+        BallPrediction.Update(Flight->GetModel(), Flight->GetState(), Now);
+        return;
     }
-    return Best;
+
+    // Chaos ball: same model from its current location and velocity
+    FBallState S;
+    S.Pos = Ball->GetActorLocation();
+    S.Vel = Ball->GetVelocity();
+    FallbackBallModel.GroundZ = FieldCentreWS.Z;
+    const FBallParams& P = FallbackBallModel.Params;
+    S.bRolling = S.Pos.Z <= FallbackBallModel.GroundZ + P.Radius + 1.f && FMath::Abs(S.Vel.Z) < P.RollSpeedZ;
+    BallPrediction.Update(FallbackBallModel, S, Now);
 }
 
-void ADefaultGameMode::ComputeKeeperTarget(
-    int32 TeamID, const FVector& BallLoc,
-    FVector& OutGoal, FVector& OutKeeperHome, FVector& OutBoxMin, FVector& OutBoxMax) const
+void ADefaultGameMode::HandlePitchEvent(const FPitchEventInfo& Event)
 {
-    OutGoal = OwnGoalLocation(TeamID);
+    ATeamGameState* GS = GetGameState<ATeamGameState>();
+    if (Event.Type == EPitchEvent::Goal)
+    {
+        if (GS) GS->HandleGoal(Event.Team, Event.bPositiveEnd);
+        RecordReplayEvent(EReplayEvent::Goal, nullptr, FVector::ZeroVector, Event.Team);
+    }
+    else
+    {
+        RunStats.Restarts++;
+        const FVector Spot = ProjectXYToGround(Rules.RestartLocation(Event)) + FVector(0, 0, 20.f);
+        if (GS) GS->HandleRestart(Event.Team, Spot);
+        RecordReplayEvent(EReplayEvent::Restart, nullptr, Spot, Event.Team);
+    }
 
-    const float Dir = (TeamID == 0) ? +1.f : -1.f;
-    const float BoxX0 = OutGoal.X + Dir * PenBoxDepth;
-    OutBoxMin = FVector(FMath::Min(OutGoal.X, BoxX0), FieldCentreWS.Y - PenBoxHalfWidth, OutGoal.Z);
-    OutBoxMax = FVector(FMath::Max(OutGoal.X, BoxX0), FieldCentreWS.Y + PenBoxHalfWidth, OutGoal.Z);
+    // Dead ball: nobody has it until the next touch
+    PossessingPlayer = nullptr;
+    PossessingTeamID = -1;
+    LastTouchTeamID = -1;
+}
+
+float ADefaultGameMode::TeamHalfAngle(int32 TeamID) const { return (TeamID == 0) ? 0.f : 180.f; }
 
-    const FVector ToBall = (BallLoc - OutGoal).GetSafeNormal2D();
-    FVector Candidate = OutGoal + ToBall * KeeperDepth;
-    Candidate.X = FMath::Clamp(Candidate.X, OutBoxMin.X, OutBoxMax.X);
-    Candidate.Y = FMath::Clamp(Candidate.Y, OutBoxMin.Y, OutBoxMax.Y);
+// ---------------- Grounding ----------------
+void ADefaultGameMode::RebuildGroundCache()
+{
+    GroundCache.Reset();
+    Formations.Invalidate(); // compiled homes sit on the old heights
+    if (GroundCacheSpacing <= 0.f) return;
 
-    OutKeeperHome = ProjectXYToGround(ClampToField(Candidate));
+    GroundCache.Build(GetWorld(), FieldCentreWS, HalfLength, HalfWidth, GroundCacheSpacing,
+        GroundTraceUp, GroundTraceDown, GroundTraceChannel, this);
 }
 
-void ADefaultGameMode::DriveTeamAI(const TArray<AFootballer*>& Team, int32 TeamID, bool bAttacking)
+FVector ADefaultGameMode::ProjectXYToGround(const FVector& XY, FVector* OutNormal) const
 {
-    AActor* BallActor = Ball ? static_cast<AActor*>(Ball)
-        : UGameplayStatics::GetActorOfClass(GetWorld(), ABallsack::StaticClass());
-    const FVector BallLoc = BallActor ? BallActor->GetActorLocation() : FieldCentreWS;
+    float CachedZ;
+    if (GroundCache.Sample(XY.X, XY.Y, CachedZ, OutNormal))
+    {
+        return FVector(XY.X, XY.Y, CachedZ + GroundZOffset);
+    }
 
-    const float Dir = (TeamID == 0) ? +1.f : -1.f;
-    const FVector OwnGoal = OwnGoalLocation(TeamID);
+    // Outside the grid (or cache disabled): real trace
+    INC_DWORD_STAT(STAT_OSF_GroundTraces);
+    const FVector Start(XY.X, XY.Y, FieldCentreWS.Z + GroundTraceUp);
+    const FVector End(XY.X, XY.Y, FieldCentreWS.Z - GroundTraceDown);
 
-    // Two closest to ball
-    TSet<AFootballer*> Used;
-    AFootballer* First = ClosestTo(Team, BallLoc);
-    if (First)  Used.Add(First);
-    AFootballer* Second = ClosestTo(Team, BallLoc, Used);
-    if (Second) Used.Add(Second);
+    FHitResult Hit;
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(ProjectXYToGround), false);
+    Params.bReturnPhysicalMaterial = false;
+    Params.AddIgnoredActor(this);
 
-    // Keeper = slot 0
-    AFootballer* Keeper = Team.IsValidIndex(0) ? Team[0] : nullptr;
+    const bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, Start, End, GroundTraceChannel, Params);
+    const float Z = bHit ? Hit.Location.Z : FieldCentreWS.Z;
+    if (OutNormal) *OutNormal = bHit ? FVector(Hit.ImpactNormal) : FVector::UpVector;
+    return FVector(XY.X, XY.Y, Z + GroundZOffset);
+}
 
-    // Remaining indices (we keep slot index explicitly)
-    TArray<int32> RestIdx;
-    RestIdx.Reserve(Team.Num());
-    for (int32 i = 0; i < Team.Num(); ++i)
+void ADefaultGameMode::SnapActorToGround(AActor* Actor) const
+{
+    if (!Actor) return;
+
+    FVector L = Actor->GetActorLocation();
+    L = ProjectXYToGround(L);
+
+    if (UCapsuleComponent* Cap = Actor->FindComponentByClass<UCapsuleComponent>())
     {
-        AFootballer* P = Team[i];
-        if (!IsValid(P)) continue;
-        if (i == 0) continue;           // GK handled separately
-        if (P == First || P == Second) continue;
-        RestIdx.Add(i);
+        L.Z += Cap->GetScaledCapsuleHalfHeight();
     }
 
-    // Move helper: blend tactical with home slot
-    auto SetTargetFor = [&](AFootballer* P, int32 SlotIndex, const FVector& Tactical, EPlayRole PlayIntent)
-        {
-            if (!IsValid(P)) return;
+    Actor->SetActorLocation(L, false, nullptr, ETeleportType::TeleportPhysics);
+}
 
-            FVector HomeLocal = FormationLocal(SlotIndex);
-            if (TeamID == 1) HomeLocal = FVector(-HomeLocal.X, -HomeLocal.Y, HomeLocal.Z);
-            FVector HomeWorld = ProjectXYToGround(ClampToField(ToWorld(HomeLocal)));
+// ---------------- Brain ----------------
+void ADefaultGameMode::Think()
+{
+    OSF_SCOPE(Think);
 
-            const FVector Target = FMath::Lerp(HomeWorld, Tactical, 1.f - HomeWeight);
+    AActor* BallActor = Ball;
 
-            // steering intent for your pawn
-            FVector Desired = SeekArriveDirection(P->GetActorLocation(), Target);
-            Desired += SeparationVector(P, Team) * SeparationStrength;
+    SyncKernel(); // tunables may be edited live
 
-            P->SetDesiredMovement(Desired);
-            P->SetDesiredSprintStrength((Target - P->GetActorLocation()).Size() > 700.f ? 1.f : 0.f);
+    // One pass over the actors; everything below reads the packed copy.
+    Snapshot.Build(Team0Players, Team1Players, BallActor, FieldCentreWS);
+    PlayerGrid.Build(Snapshot, FieldCentreWS,
+        FVector2D(HalfLength + SeparationRadius, HalfWidth + SeparationRadius), SeparationRadius);
+    if (BallPrediction.IsValid())
+    {
+        Snapshot.BallAhead = Kernel.ClampToField(BallPrediction.PositionAt(GetWorld()->GetTimeSeconds() + BallLeadTime));
+    }
+    const FVector BallLoc = Snapshot.BallPos;
+    UpdateBallControl();
 
-            if (AAIController* AIC = Cast<AAIController>(P->GetController()))
-            {
-                AIC->MoveToLocation(Target, ArriveRadius, true, true, true, false);
-                if (BallActor) AIC->SetFocus(BallActor);
-            }
-            else if (ACharacter* C = Cast<ACharacter>(P))
-            {
-                C->AddMovementInput(Desired, 1.f);
-            }
+    // Who reaches the ball's path first; a ball without a prediction stays where it is
+    const float PathDt = 1.f / FMath::Max(InterceptPathRate, 1.f);
+    if (BallPrediction.IsValid())
+    {
+        Intercepts.SetPath(BallPrediction, GetWorld()->GetTimeSeconds(), PathDt, FieldCentreWS.Z);
+    }
+    else
+    {
+        Intercepts.ResetPath(PathDt, FieldCentreWS.Z);
+        Intercepts.AddPathPoint(FVector(BallLoc.X, BallLoc.Y, FieldCentreWS.Z));
+    }
+    Intercepts.Solve(Snapshot);
 
-#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-            const FColor CCol = (PlayIntent == EPlayRole::Press) ? FColor::Red
-                : (PlayIntent == EPlayRole::Support) ? FColor::Yellow
-                : (PlayIntent == EPlayRole::Mark) ? FColor::Cyan
-                : FColor::Green;
-            DrawDebugDirectionalArrow(GetWorld(), P->GetActorLocation(), Target, 40.f, CCol, false, 0.12f, 0, 2.f);
-#endif
-        };
+    // Decide: pure reads of Snapshot/PlayerGrid/GroundCache, safe off the game thread.
+    // Without the ground cache grounding would trace, so stay on this thread then.
+    const EParallelForFlags Flags = (bParallelAI && GroundCache.IsBuilt())
+        ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
 
-    // --- Keeper ---
-    if (IsValid(Keeper))
+    // Team-level plan at the base rate
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (Now >= NextTeamPlanTime)
     {
-        FVector Goal, KeeperHome, BoxMin, BoxMax;
-        ComputeKeeperTarget(TeamID, BallLoc, Goal, KeeperHome, BoxMin, BoxMax);
+        NextTeamPlanTime = Now + TeamPlanInterval;
 
-        const float DistToBall = FVector::Dist2D(Keeper->GetActorLocation(), BallLoc);
-        FVector GKTarget = KeeperHome;
+        // Space for positioning and passes; only the cells around players who moved since the last plan
+        PitchControl.Update(Snapshot);
+        RunStats.PitchControlUpdates++;
+        RunStats.PitchControlCells += PitchControl.LastCellsUpdated;
+        RunStats.PitchControlSecondsTotal += PitchControl.LastUpdateMicros * 1.0e-6;
+        SET_DWORD_STAT(STAT_OSF_PitchControlCells, PitchControl.LastCellsUpdated);
+        SET_FLOAT_STAT(STAT_OSF_PitchControlMicros, PitchControl.LastUpdateMicros);
 
-        // Inside box and close enough → step out toward ball
-        if (BallLoc.X >= FMath::Min(BoxMin.X, BoxMax.X) && BallLoc.X <= FMath::Max(BoxMin.X, BoxMax.X) &&
-            BallLoc.Y >= BoxMin.Y && BallLoc.Y <= BoxMax.Y &&
-            DistToBall <= KeeperChaseRadius)
-        {
-            GKTarget = ProjectXYToGround(ClampToField(BallLoc));
-        }
+        const int32 AttackingTeam = Kernel.PickAttackingTeam(PlayerGrid, BallLoc, PossessingTeamID);
 
-        const FVector Target = FMath::Lerp(KeeperHome, GKTarget, 0.5f);
-        if (AAIController* AIC = Cast<AAIController>(Keeper->GetController()))
+        ParallelFor(TEXT("OSF.PlanTeams"), 2, 1, [&](int32 TeamID)
+            {
+                Kernel.PlanTeam(Snapshot, PlayerGrid, TeamID, AttackingTeam == TeamID, Marking[TeamID], TeamPlans[TeamID]);
+            }, Flags);
+
+        for (int32 TeamID = 0; TeamID < 2; ++TeamID)
         {
-            AIC->MoveToLocation(Target, ArriveRadius, true, true, true, false);
-            if (BallActor) AIC->SetFocus(BallActor);
+            UE_CLOG(Marking[TeamID].LastSolveMicros > MarkingBudgetMicros, LogTemp, Verbose,
+                TEXT("Marking solve for team %d took %.1f us (budget %.1f)"), TeamID, Marking[TeamID].LastSolveMicros, MarkingBudgetMicros);
         }
-
-#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-        DrawDebugBox(GetWorld(), (BoxMin + BoxMax) * 0.5f,
-            FVector(FMath::Abs(BoxMax.X - BoxMin.X) * 0.5f, PenBoxHalfWidth, 50.f),
-            FColor::White, false, 0.12f, 0, 1.f);
-        DrawDebugSphere(GetWorld(), Target, 40.f, 10, FColor::White, false, 0.12f, 0, 2.f);
-#endif
     }
 
-    // --- Field players ---
-    if (bAttacking)
+    // Per-player decisions: only those the LOD scheduler picks this frame
+    int32 Forced[6];
+    int32 NumForced = 0;
+    for (int32 TeamID = 0; TeamID < 2; ++TeamID)
     {
-        const int32 FirstIdx = Team.IndexOfByKey(First);
-        const int32 SecondIdx = Team.IndexOfByKey(Second);
-
-        if (IsValid(First) && FirstIdx != INDEX_NONE)
+        const int32 KeeperIdx = Snapshot.IndexOf(TeamID, 0);
+        if (Snapshot.IsValidEntry(KeeperIdx)) Forced[NumForced++] = KeeperIdx;
+        for (int32 Chaser : TeamPlans[TeamID].Chasers)
         {
-            const FVector T = ClampToField(ProjectXYToGround(BallLoc + FVector(SupportAhead * Dir, +SupportWide, 0.f)));
-            SetTargetFor(First, FirstIdx, T, EPlayRole::Support);
-        }
-        if (IsValid(Second) && SecondIdx != INDEX_NONE)
-        {
-            const FVector T = ClampToField(ProjectXYToGround(BallLoc + FVector(SupportAhead * Dir, -SupportWide, 0.f)));
-            SetTargetFor(Second, SecondIdx, T, EPlayRole::Support);
+            if (Snapshot.IsValidEntry(Chaser)) Forced[NumForced++] = Chaser;
         }
+    }
 
-        for (int32 SlotIdx : RestIdx)
-        {
-            AFootballer* P = Team[SlotIdx];
-            if (!IsValid(P) || (P->GetController() && P->GetController()->IsPlayerController())) continue;
+    AIScheduler.FullInterval = TeamPlanInterval;
+    AIScheduler.MidInterval = AIMidInterval;
+    AIScheduler.FarInterval = AIFarInterval;
+    AIScheduler.NearRadius = AINearRadius;
+    AIScheduler.MidRadius = AIMidRadius;
+    AIScheduler.Select(Snapshot, MakeArrayView(Forced, NumForced), Now, CVarAIUpdateBudget.GetValueOnGameThread(), Selected);
 
-            FVector HomeLocal = FormationLocal(SlotIdx);
-            if (TeamID == 1) HomeLocal = FVector(-HomeLocal.X, -HomeLocal.Y, HomeLocal.Z);
-            FVector HomeWorld = ToWorld(HomeLocal);
-            HomeWorld.X += AdvanceWithBall * 0.5f * Dir;
+    SET_DWORD_STAT(STAT_OSF_AIPlayersUpdated, AIScheduler.LastUpdated);
+    SET_DWORD_STAT(STAT_OSF_AIPlayersDeferred, AIScheduler.LastDeferred);
 
-            const FVector T = ClampToField(ProjectXYToGround(HomeWorld));
-            SetTargetFor(P, SlotIdx, T, EPlayRole::HoldLine);
-        }
-    }
-    else
+    Intents.SetNum(Snapshot.Num);
+    DecideSamples.SetNumZeroed(Snapshot.Num);
     {
-        auto ContainPoint = [&](float side)->FVector
+        OSF_SCOPE(DecidePlayers);
+        ParallelFor(TEXT("OSF.DecidePlayers"), Selected.Num(), 2, [&](int32 k)
             {
-                const FVector ToGoal = (OwnGoal - BallLoc).GetSafeNormal2D();
-                const FVector Right = FVector::CrossProduct(ToGoal, FVector::UpVector);
-                return BallLoc + ToGoal * 900.f + Right * side * 260.f;
-            };
+                const int32 Idx = Selected[k];
+                const uint32 Start = FPlatformTime::Cycles();
+                Kernel.DecidePlayer(Snapshot, PlayerGrid, Idx, TeamPlans[Snapshot.Team[Idx]], Intents[Idx]);
+                DecideSamples[Idx] = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - Start) * 1000.f;
+            }, Flags);
+    }
 
-        const int32 FirstIdx = Team.IndexOfByKey(First);
-        const int32 SecondIdx = Team.IndexOfByKey(Second);
+    // Averages per player: snapshot indices shift when players join or leave
+    if (DecideMicros.Num() > Snapshot.Num)
+    {
+        for (auto It = DecideMicros.CreateIterator(); It; ++It)
+        {
+            if (!It->Key.ResolveObjectPtr()) It.RemoveCurrent();
+        }
+    }
+    float MaxMicros = 0.f;
+    for (int32 Idx : Selected)
+    {
+        float& Micros = DecideMicros.FindOrAdd(Snapshot.Players[Idx], DecideSamples[Idx]);
+        Micros = FMath::Lerp(Micros, DecideSamples[Idx], 0.2f);
+        MaxMicros = FMath::Max(MaxMicros, Micros);
+    }
+    SET_FLOAT_STAT(STAT_OSF_AICostMaxMicros, MaxMicros);
 
-        if (IsValid(First) && FirstIdx != INDEX_NONE)
-            SetTargetFor(First, FirstIdx, ClampToField(ProjectXYToGround(ContainPoint(+1.f))), EPlayRole::Press);
-        if (IsValid(Second) && SecondIdx != INDEX_NONE)
-            SetTargetFor(Second, SecondIdx, ClampToField(ProjectXYToGround(ContainPoint(-1.f))), EPlayRole::Press);
+    // Apply: side effects, game thread only
+    for (int32 Idx : Selected)
+    {
+        ApplyIntent(Idx, Intents[Idx], BallActor);
+    }
 
-        const TArray<AFootballer*>& Opp = (TeamID == 0) ? Team1Players : Team0Players;
-        TSet<AFootballer*> Claimed;
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+    for (int32 TeamID = 0; TeamID < 2 && CVarAIDebugDraw.GetValueOnGameThread() != 0; ++TeamID)
+    {
+        const FTeamPlan& Plan = TeamPlans[TeamID];
+        if (!Snapshot.IsValidEntry(Snapshot.IndexOf(TeamID, 0))) continue;
+        DrawDebugBox(GetWorld(), (Plan.KeeperBoxMin + Plan.KeeperBoxMax) * 0.5f,
+            FVector(FMath::Abs(Plan.KeeperBoxMax.X - Plan.KeeperBoxMin.X) * 0.5f, PenBoxHalfWidth, 50.f),
+            FColor::White, false, -1.f, 0, 1.f);
+    }
+#endif
 
-        for (int32 SlotIdx : RestIdx)
-        {
-            AFootballer* P = Team[SlotIdx];
-            if (!IsValid(P) || (P->GetController() && P->GetController()->IsPlayerController())) continue;
+    PathRequests.GoalTolerance = RepathTolerance;
+    PathRequests.Flush(GetWorld());
+}
 
-            AFootballer* Att = nullptr; float Best = TNumericLimits<float>::Max();
-            for (AFootballer* A : Opp)
-            {
-                if (!IsValid(A) || Claimed.Contains(A)) continue;
-                const float D = FVector::DistSquared(P->GetActorLocation(), A->GetActorLocation());
-                if (D < Best) { Best = D; Att = A; }
-            }
-            if (Att) Claimed.Add(Att);
+AFootballer* ADefaultGameMode::GetFirstInterceptor(int32 TeamID) const
+{
+    if (TeamID < 0 || TeamID > 1) return nullptr;
+    const int32 Idx = Snapshot.Interceptor(TeamID, 0);
+    AFootballer* P = Idx != INDEX_NONE ? Snapshot.Players[Idx] : nullptr;
+    return IsValid(P) ? P : nullptr;
+}
 
-            FVector MarkPos;
-            if (Att)
-            {
-                const FVector Apos = Att->GetActorLocation();
-                const FVector AG = (OwnGoal - Apos).GetSafeNormal2D();
-                MarkPos = Apos + AG * 350.f; // goal-side
-            }
-            else
-            {
-                FVector Slot = FormationLocal(SlotIdx);
-                if (TeamID == 1) Slot = FVector(-Slot.X, -Slot.Y, Slot.Z);
-                MarkPos = ToWorld(Slot);
-            }
+bool ADefaultGameMode::ChoosePass(const AFootballer* Passer, const FVector& Aim, FPassChoice& Out) const
+{
+    // Last Think's snapshot; a frame old at most, the ball is read fresh
+    const int32 Idx = Snapshot.Find(Passer);
+    if (Idx == INDEX_NONE) return false;
 
-            MarkPos.X -= RetreatWithBall * 0.5f * Dir;
-            SetTargetFor(P, SlotIdx, ClampToField(ProjectXYToGround(MarkPos)), EPlayRole::Mark);
-        }
-    }
+    const FVector BallLoc = Ball ? Ball->GetActorLocation() : Passer->GetActorLocation();
+    return Passes.Evaluate(Snapshot, Kernel.Tactics, Idx, BallLoc, Aim, Out);
 }
 
-// ---------- Steering helpers ----------
-FVector ADefaultGameMode::SeekArriveDirection(const FVector& From, const FVector& To) const
+bool ADefaultGameMode::ChooseShot(const AFootballer* Shooter, const FVector& Aim, FShotChoice& Out) const
 {
-    const FVector ToT = (To - From);
-    const float Dist = ToT.Size2D();
-    if (Dist < KINDA_SMALL_NUMBER) return FVector::ZeroVector;
+    const int32 Idx = Snapshot.Find(Shooter);
+    if (Idx == INDEX_NONE) return false;
 
-    const float Strength = (Dist > ArriveRadius) ? 1.f : (Dist / ArriveRadius);
-    return ToT.GetSafeNormal2D() * Strength;
+    // Team 0 attacks +X
+    const FVector BallLoc = Ball ? Ball->GetActorLocation() : Shooter->GetActorLocation();
+    return Shots[Snapshot.Team[Idx] == 0 ? 1 : 0].Evaluate(Snapshot, Idx, BallLoc, Aim, Out);
 }
 
-FVector ADefaultGameMode::SeparationVector(AFootballer* Self, const TArray<AFootballer*>& SameTeam) const
+void ADefaultGameMode::ApplyIntent(int32 Idx, const FPlayerIntent& Intent, AActor* BallActor)
 {
-    if (!IsValid(Self)) return FVector::ZeroVector;
-    const FVector MyPos = Self->GetActorLocation();
-    FVector Accum = FVector::ZeroVector;
+    OSF_SCOPE(ApplyIntent);
+    if (!Intent.bActive) return;
+    AFootballer* P = Snapshot.Players[Idx];
+    if (!IsValid(P)) return;
 
-    for (AFootballer* P : SameTeam)
+    if (Intent.bSteer)
     {
-        if (!IsValid(P) || P == Self) continue;
-        const FVector Delta = MyPos - P->GetActorLocation();
-        const float D2 = FMath::Max(Delta.SizeSquared2D(), 1.f);
-        if (D2 < SeparationRadius * SeparationRadius)
-        {
-            Accum += Delta.GetSafeNormal2D() * (SeparationRadius * SeparationRadius / D2);
-        }
+        P->SetDesiredMovement(Intent.Desired);
+        P->SetDesiredSprintStrength(Intent.Sprint);
+    }
+
+    // The AI carrier's pass or shot; the pawn checks the ball is still within its reach
+    if (Intent.Kick != ESimKick::None)
+    {
+        P->KickBall(Intent.KickVelocity, Intent.KickSpin);
+    }
+
+    if (AAIController* AIC = Cast<AAIController>(P->GetController()))
+    {
+        PathRequests.Request(AIC, Intent.Target, ArriveRadius);
+        if (BallActor) AIC->SetFocus(BallActor);
     }
-    return Accum;
+    else if (Intent.bSteer)
+    {
+        P->AddMovementInput(Intent.Desired, 1.f);
+    }
+
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+    if (CVarAIDebugDraw.GetValueOnGameThread() == 0) return;
+    const float DebugLife = AIScheduler.GetInterval(Idx) + 0.02f;
+    if (Intent.bKeeper)
+    {
+        DrawDebugSphere(GetWorld(), Intent.Target, 40.f, 10, FColor::White, false, DebugLife, 0, 2.f);
+    }
+    else
+    {
+        const FColor CCol = (Intent.Role == ESimRole::Press) ? FColor::Red
+            : (Intent.Role == ESimRole::Support) ? FColor::Yellow
+            : (Intent.Role == ESimRole::Mark) ? FColor::Cyan
+            : FColor::Green;
+        DrawDebugDirectionalArrow(GetWorld(), Snapshot.GetPos(Idx), Intent.Target, 40.f, CCol, false, DebugLife, 0, 2.f);
+    }
+#endif
 }
 
-FVector ADefaultGameMode::OwnGoalLocation(int32 TeamID) const
+void ADefaultGameMode::DumpAICost(int32 TopN) const
 {
-    const float X = FieldCentreWS.X + ((TeamID == 0) ? -HalfLength : +HalfLength);
-    return FVector(X, FieldCentreWS.Y, FieldCentreWS.Z);
+    TArray<int32> Order;
+    TArray<float> Micros;
+    Micros.SetNumZeroed(Snapshot.Num);
+    for (int32 i = 0; i < Snapshot.Num; ++i)
+    {
+        if (const float* M = DecideMicros.Find(Snapshot.Players[i]))
+        {
+            Micros[i] = *M;
+            Order.Add(i);
+        }
+    }
+    Order.Sort([&Micros](int32 A, int32 B) { return Micros[A] > Micros[B]; });
+
+    for (int32 k = 0; k < FMath::Min(TopN, Order.Num()); ++k)
+    {
+        const int32 i = Order[k];
+        UE_LOG(LogTemp, Display, TEXT("AI cost #%d: team %d slot %d %s  %.2f us (interval %.2f s)"),
+            k + 1, Snapshot.Team[i], Snapshot.Slot[i], *GetNameSafe(Snapshot.Players[i]), Micros[i], AIScheduler.GetInterval(i));
+    }
 }
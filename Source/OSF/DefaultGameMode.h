@@ -2,12 +2,31 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "UObject/ObjectKey.h"
+#include "MatchSnapshot.h"
+#include "PitchHeightField.h"
+#include "SpatialHashGrid.h"
+#include "MarkingAssignment.h"
+#include "PathRequestManager.h"
+#include "AILodScheduler.h"
+#include "Sim/MatchKernel.h"
+#include "Sim/PitchRules.h"
+#include "Sim/BallPrediction.h"
+#include "Sim/InterceptSolver.h"
+#include "Sim/PitchControl.h"
+#include "Sim/FormationSet.h"
+#include "Sim/KickSolver.h"
+#include "Sim/PassEvaluator.h"
+#include "Sim/ShotEvaluator.h"
+#include "Sim/MatchReplay.h"
 #include "DefaultGameMode.generated.h"
 
 class UDataTable;
+class UFormationZoneAsset;
 class ABallsack;
 class AFootballer;
 class AFootballTeam;
+class FChaosScene;
 struct FFormationRow; // defined in FormationRow.h
 
 UENUM(BlueprintType)
@@ -18,6 +37,27 @@ enum class EPlayRole : uint8
     Support   UMETA(DisplayName = "Support"),
     Mark      UMETA(DisplayName = "Mark")
 };
+static_assert(uint8(EPlayRole::Mark) == uint8(ESimRole::Mark), "EPlayRole mirrors ESimRole");
+
+/** Running totals for headless runs and reports. */
+struct FMatchRunStats
+{
+    double SimSeconds = 0.0;
+    int64  Frames = 0;
+    double PossessionSeconds[3] = { 0.0, 0.0, 0.0 }; // loose ball, team 0, team 1
+    int32  PossessionChanges = 0;  // from human pickups and AI ball control alike
+    int32  Kicks = 0;
+    int32  Restarts = 0;            // throw-ins, corners, goal kicks
+    double ThinkSecondsTotal = 0.0; // wall time spent in Think
+    double ThinkSecondsMax = 0.0;
+    double ThinkSecondsLast = 0.0;
+    int32  PitchControlUpdates = 0;
+    int64  PitchControlCells = 0;   // recomputed, over every update
+    double PitchControlSecondsTotal = 0.0;
+    int64  ReplayBytes = 0;         // recording so far, when one is running
+    int32  ReplayFrames = 0;
+    double ReplayRecordSecondsTotal = 0.0;
+};
 
 UCLASS()
 class OSF_API ADefaultGameMode : public AGameModeBase
@@ -27,23 +67,95 @@ class OSF_API ADefaultGameMode : public AGameModeBase
 public:
     ADefaultGameMode();
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void Tick(float DeltaSeconds) override;
 
     // Possession API (kept)
     UFUNCTION(BlueprintCallable) void NotifyPossession(AFootballer* NewOwner);
     UFUNCTION(BlueprintCallable) void ClearPossession(AFootballer* OldOwner);
 
+    // Toucher played the ball (kick, AI control): last touch for the rules; with bControl they also have it
+    void NotifyTouch(AFootballer* Toucher, bool bControl);
+    int32 GetLastTouchTeamID() const { return LastTouchTeamID; }
+
+    // Re-sample the ground height cache (e.g. after streaming in pitch geometry)
+    UFUNCTION(BlueprintCallable, Category = "Grounding") void RebuildGroundCache();
+
+    // Headless runs: squad size before BeginPlay, totals afterwards
+    void SetPlayersPerTeamOverride(int32 InPlayersPerTeam) { PlayersPerTeamOverride = InPlayersPerTeam; }
+    int32 GetPlayersPerTeam() const { return PlayersPerTeam; }
+    const FMatchRunStats& GetRunStats() const { return RunStats; }
+    const FPathRequestManager& GetPathRequests() const { return PathRequests; }
+    const FPitchRules& GetPitchRules() const { return Rules; }
+
+    // Where the ball is going, refreshed after every physics step; query this instead of re-simulating
+    const FBallPrediction& GetBallPrediction() const { return BallPrediction; }
+
+    // Who gets where first, as of the last team plan
+    const FPitchControl& GetPitchControl() const { return PitchControl; }
+
+    // Team's player who can play the ball first, as of the last Think; null before the first
+    AFootballer* GetFirstInterceptor(int32 TeamID) const;
+
+    // Best pass for Passer from where the ball is now; Aim (may be zero) steers assisted human passes
+    bool ChoosePass(const AFootballer* Passer, const FVector& Aim, FPassChoice& Out) const;
+
+    // Best shot for Shooter at the goal their team attacks; false out of range
+    bool ChooseShot(const AFootballer* Shooter, const FVector& Aim, FShotChoice& Out) const;
+
+    // Logs the TopN players by recent AI decision cost (osf.AI.DumpCost)
+    void DumpAICost(int32 TopN) const;
+
+    // Moves a team to a loaded formation (the table's name) over BlendSeconds; < 0 = FormationBlendTime. False if not loaded
+    UFUNCTION(BlueprintCallable, Category = "Formation") bool SetTeamFormation(int32 TeamID, FName Formation, float BlendSeconds = -1.f);
+
+    // Holds a team at Alpha (0..1) between two loaded formations, e.g. from the score or the clock
+    UFUNCTION(BlueprintCallable, Category = "Formation") bool BlendTeamFormations(int32 TeamID, FName From, FName To, float Alpha);
+
+    // Logs the loaded formations and what each team plays (osf.AI.Formation)
+    void DumpFormations() const;
+
+    // Records the match from the next frame (osf.Replay.Record); empty Path = Saved/Replays/Match-<time>.osfreplay
+    UFUNCTION(BlueprintCallable, Category = "Replay") bool StartReplayRecording(const FString& Path);
+    UFUNCTION(BlueprintCallable, Category = "Replay") void StopReplayRecording();
+    const FReplayRecorder& GetReplayRecorder() const { return Replay; }
+
+    // Goes into the recording with the next frame; Team defaults to Player's
+    void RecordReplayEvent(EReplayEvent Type, const AFootballer* Player, const FVector& Value = FVector::ZeroVector, int32 Team = INDEX_NONE);
+
+    // Draws a recording over the scene from Time at Rate x real time (osf.Replay.View); the match itself is untouched
+    bool OpenReplayView(const FString& Path, double Time = 0.0, float Rate = 1.f);
+    void SeekReplayView(double Time);
+    void CloseReplayView();
+
 protected:
     // ---------- Tunables ----------
     UPROPERTY(EditAnywhere, Category = "Pitch") float HalfLength = 9000.f;
     UPROPERTY(EditAnywhere, Category = "Pitch") float HalfWidth = 6000.f;
 
+    // Goal mouth and ball for the rules; a placed AGoal overrides the mouth at its end, and placed goals the goal line
+    UPROPERTY(EditAnywhere, Category = "Pitch") float GoalHalfWidth = 366.f;
+    UPROPERTY(EditAnywhere, Category = "Pitch") float CrossbarHeight = 244.f;
+    UPROPERTY(EditAnywhere, Category = "Pitch") float BallRadius = 11.f;
+
     UPROPERTY(EditAnywhere, Category = "Spawning") TSubclassOf<AFootballer>  FootballerClass;
     UPROPERTY(EditAnywhere, Category = "Spawning") TSubclassOf<AFootballTeam> TeamClass;
 
     UPROPERTY(EditAnywhere, Category = "Ball") TSubclassOf<ABallsack> BallClass;
 
+    // Shared ball prediction: seconds ahead and samples per second
+    UPROPERTY(EditAnywhere, Category = "Ball") float BallPredictionHorizon = 3.f;
+    UPROPERTY(EditAnywhere, Category = "Ball") float BallPredictionRate = 60.f;
+
     UPROPERTY(EditAnywhere, Category = "Formation") UDataTable* FormationTable = nullptr;
 
+    // More formations to switch to at runtime (SetTeamFormation), loaded and compiled with the first
+    UPROPERTY(EditAnywhere, Category = "Formation") TArray<UDataTable*> ExtraFormationTables;
+    UPROPERTY(EditAnywhere, Category = "Formation") float FormationBlendTime = 2.f;
+
+    // Ball-zone shape tables, each used while a team plays the formation it was made for
+    UPROPERTY(EditAnywhere, Category = "Formation") TArray<UFormationZoneAsset*> FormationZones;
+
     // Local-space formation points (X forward, Y right, origin at field center)
     UPROPERTY(EditAnywhere, Category = "Formation") TArray<FVector> BaseFormation_Local;
 
@@ -52,6 +164,42 @@ protected:
 
     UPROPERTY(EditAnywhere, Category = "Formation") int32 PlayersPerTeam = 11;
 
+    // 0 = formation size. Larger squads (stress drills) repeat outfield slots with a lateral offset
+    UPROPERTY(EditAnywhere, Category = "Formation") int32 PlayersPerTeamOverride = 0;
+
+    // Chasers and keeper aim at the predicted ball this far ahead (s)
+    UPROPERTY(EditAnywhere, Category = "AI|Shape") float BallLeadTime = 0.4f;
+
+    // Intercepts: who gets to the ball first picks the chasers and the human switch
+    UPROPERTY(EditAnywhere, Category = "AI|Chasers") float InterceptReactionTime = 0.1f;
+    UPROPERTY(EditAnywhere, Category = "AI|Chasers") float InterceptControlRadius = 70.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Chasers") float InterceptMaxHeight = 180.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Chasers") float InterceptPathRate = 15.f; // path points per second
+    UPROPERTY(EditAnywhere, Category = "AI|Chasers") float ChaserHysteresis = 0.15f;
+
+    // Passing: ground-pass model and how much the human's aim outweighs the engine
+    UPROPERTY(EditAnywhere, Category = "AI|Passing") float PassBallDrag = 0.f; // 1/s; 0 = fitted to the ball's rolling model
+    UPROPERTY(EditAnywhere, Category = "AI|Passing") float PassArrivalSpeed = 500.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Passing") float PassMaxSpeed = 2600.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Passing") float PassRiskWeight = 2.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Passing") float PassAimWeight = 3.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Passing") float PassSpaceWeight = 0.5f;
+
+    // Shooting; read when the goals are synced (the on-target table is rebuilt then)
+    UPROPERTY(EditAnywhere, Category = "AI|Shooting") float ShotSpeed = 2600.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Shooting") float ShotAimErrorDeg = 3.5f;
+    UPROPERTY(EditAnywhere, Category = "AI|Shooting") float ShotAimWeight = 0.3f;
+
+    // AI carrier: with the ball under control it shoots from ShotRange at ShotMinChance, else passes when pressed or the pass is good enough
+    UPROPERTY(EditAnywhere, Category = "AI|Carrier") float CarrierKickReach = 150.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Carrier") float CarrierMaxBallSpeed = 700.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Carrier") float CarrierShotRange = 2800.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Carrier") float CarrierShotMinChance = 0.12f;
+    UPROPERTY(EditAnywhere, Category = "AI|Carrier") float CarrierPassMinScore = 1.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Carrier") float CarrierPressureRadius = 300.f;
+    // A kicker cannot take the ball back under control this soon after the kick (s)
+    UPROPERTY(EditAnywhere, Category = "AI|Carrier") float CarrierKickCooldown = 0.3f;
+
     // Keep-shape bias (0..1) – higher = tighter lines
     UPROPERTY(EditAnywhere, Category = "AI|Shape") float HomeWeight = 0.65f;
 
@@ -63,11 +211,35 @@ protected:
     UPROPERTY(EditAnywhere, Category = "AI|Support") float SupportAhead = 750.f;
     UPROPERTY(EditAnywhere, Category = "AI|Support") float SupportWide = 900.f;
 
+    // Pitch control: support and attacking runs look this far around their target for the team's space (0 = off)
+    UPROPERTY(EditAnywhere, Category = "AI|Space") float SpaceSearch = 450.f;
+    // Grid cell (read when the goals are synced) and how far a player drifts before their cells are recomputed
+    UPROPERTY(EditAnywhere, Category = "AI|Space") float PitchControlCellSize = 300.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Space") float PitchControlMoveThreshold = 100.f;
+
+    // Marking: extra cost (cm) for a defender to switch target; solve time budget per team
+    UPROPERTY(EditAnywhere, Category = "AI|Marking") float MarkSwitchPenalty = 400.f;
+    UPROPERTY(EditAnywhere, Category = "AI|Marking") float MarkingBudgetMicros = 25.f;
+
     // Steering
     UPROPERTY(EditAnywhere, Category = "AI|Steering") float ArriveRadius = 260.f;
     UPROPERTY(EditAnywhere, Category = "AI|Steering") float SeparationRadius = 420.f;
     UPROPERTY(EditAnywhere, Category = "AI|Steering") float SeparationStrength = 0.7f;
 
+    // Navigation: skip re-pathing while the new goal is within this distance of the active one
+    UPROPERTY(EditAnywhere, Category = "AI|Navigation") float RepathTolerance = 120.f;
+
+    // Run the decision phase on worker threads
+    UPROPERTY(EditAnywhere, Category = "AI|Threading") bool bParallelAI = true;
+
+    // Level of detail: team plan (and full-rate players) every TeamPlanInterval,
+    // others by distance to ball. Per-frame cap: osf.AI.UpdateBudget
+    UPROPERTY(EditAnywhere, Category = "AI|LOD") float TeamPlanInterval = 0.1f;
+    UPROPERTY(EditAnywhere, Category = "AI|LOD") float AIMidInterval = 0.2f;
+    UPROPERTY(EditAnywhere, Category = "AI|LOD") float AIFarInterval = 0.4f;
+    UPROPERTY(EditAnywhere, Category = "AI|LOD") float AINearRadius = 2500.f;
+    UPROPERTY(EditAnywhere, Category = "AI|LOD") float AIMidRadius = 5000.f;
+
     // Keeper parameters
     UPROPERTY(EditAnywhere, Category = "AI|Keeper") float KeeperDepth = 900.f;
     UPROPERTY(EditAnywhere, Category = "AI|Keeper") float KeeperChaseRadius = 1200.f;
@@ -80,6 +252,15 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Grounding") TEnumAsByte<ECollisionChannel> GroundTraceChannel = ECC_Visibility;
     UPROPERTY(EditAnywhere, Category = "Grounding") float GroundZOffset = 0.f;
 
+    // Height cache: grid spacing in cm; 0 disables the cache (every call traces)
+    UPROPERTY(EditAnywhere, Category = "Grounding") float GroundCacheSpacing = 250.f;
+
+    // Record every match from BeginPlay to ReplayPath (empty = Saved/Replays/Match-<time>.osfreplay)
+    UPROPERTY(EditAnywhere, Category = "Replay") bool bRecordReplay = false;
+    UPROPERTY(EditAnywhere, Category = "Replay") FString ReplayPath;
+    UPROPERTY(EditAnywhere, Category = "Replay") float ReplayKeyframeInterval = 1.f; // s; the most a seek decodes
+    UPROPERTY(EditAnywhere, Category = "Replay") float ReplayFrameInterval = 0.f;    // s between recorded frames; 0 = every frame
+
     // ---------- State ----------
     FVector FieldCentreWS = FVector::ZeroVector;
 
@@ -94,8 +275,71 @@ protected:
     // Possession memory
     TWeakObjectPtr<AFootballer> PossessingPlayer;
     int32 PossessingTeamID = -1;
+    int32 LastTouchTeamID = -1; // survives losing possession; decides corners vs goal kicks
+    TWeakObjectPtr<AFootballer> LastKicker;
+    double LastKickTime = -1.0;
+
+    double NextTeamPlanTime = 0.0;
+
+    FMatchRunStats RunStats;
+
+    // Team AI geometry, fed from the tunables above each Think (see SyncKernel)
+    FMatchKernel Kernel;
+
+    // Packed positions/velocities, rebuilt at the top of every Think
+    FMatchSnapshot Snapshot;
+
+    // Neighbour buckets over Snapshot, cell size = SeparationRadius
+    FSpatialHashGrid PlayerGrid;
+
+    // Persistent marker -> attacker assignment per team (warm-started each Think)
+    FMarkingAssignment Marking[2];
+
+    // Coalesces MoveTo requests and batches the async path queries
+    FPathRequestManager PathRequests;
+
+    // Decision phase output, indexed like Snapshot
+    FTeamPlan TeamPlans[2];
+    TArray<FPlayerIntent> Intents;
 
-    FTimerHandle ThinkTimer;
+    // Who decides this frame
+    FAILodScheduler AIScheduler;
+    TArray<int32, TInlineAllocator<64>> Selected;
+
+    // Smoothed DecidePlayer cost per player (microseconds); this Think's samples by snapshot index
+    TMap<TObjectKey<AFootballer>, float> DecideMicros;
+    TArray<float> DecideSamples;
+
+    // Ground heights over the pitch, sampled at BeginPlay
+    FPitchHeightField GroundCache;
+
+    // Goal / out-of-play detection on the ball's swept path, once per scene step (OnPhysSceneStep fires from FChaosScene::StartFrame, not per solver substep)
+    FPitchRules Rules;
+    FVector LastBallPos = FVector::ZeroVector;
+    bool bHaveLastBallPos = false;
+    FDelegateHandle PhysicsStepHandle;
+
+    // Ball future for the AI; FallbackBallModel predicts when Chaos moves the ball
+    FBallPrediction BallPrediction;
+    FBallFlight FallbackBallModel;
+    FInterceptSolver Intercepts;
+    FKickSolver Kicks;       // shared by Passes and Shots; aimed with the ball's model
+    FPassEvaluator Passes;
+    float FittedPassDrag = 0.21f; // FPassEvaluator::FitBallDrag for the ball's model, in SyncPitchRules
+    FShotEvaluator Shots[2]; // by goal: 0 at -X (team 0 defends), 1 at +X
+
+    // Who gets where first, updated with the team plan around players who moved; read by Kernel and Passes
+    FPitchControl PitchControl;
+
+    // Every loaded formation's homes, compiled in SyncKernel once the ground cache is built; read by Kernel
+    FFormationSet Formations;
+    FName PrimaryFormation; // FormationTable's name, or Default for BaseFormation_Local
+
+    // Match recording, captured from Snapshot after every Think; and a recording being viewed
+    FReplayRecorder Replay;
+    FReplayReader ReplayView;
+    double ReplayViewTime = 0.0;
+    float ReplayViewRate = 1.f;
 
     // ---------- Flow ----------
     void SpawnTeams();
@@ -103,26 +347,24 @@ protected:
 
     void BuildFormationFromTable();
     void BuildBaseFormation();
+    void LoadFormations();
 
     void Think();
-    void DriveTeamAI(const TArray<AFootballer*>& Team, int32 TeamID, bool bAttacking);
+    void SyncKernel();
+    void UpdateBallControl();
+
+    void SyncPitchRules();
+    void OnPhysicsStep(FChaosScene* Scene, float StepSeconds);
+    void HandlePitchEvent(const FPitchEventInfo& Event);
+    void UpdateBallPrediction();
+    void DrawReplayView(float DeltaSeconds);
+
+    // Apply phase (game thread); the decision phase is Kernel.PlanTeam/DecidePlayer
+    void ApplyIntent(int32 Idx, const FPlayerIntent& Intent, AActor* BallActor);
 
     // ---------- Helpers ----------
-    FVector FormationLocal(int32 Index) const;
-    FVector ToWorld(const FVector& Local) const;
-    FVector ClampToField(const FVector& P) const;
     float  TeamHalfAngle(int32 TeamID) const;
 
-    FVector ProjectXYToGround(const FVector& XY) const;
+    FVector ProjectXYToGround(const FVector& XY, FVector* OutNormal = nullptr) const;
     void    SnapActorToGround(AActor* Actor) const;
-
-    FVector SeekArriveDirection(const FVector& From, const FVector& To) const;
-    FVector SeparationVector(AFootballer* Self, const TArray<AFootballer*>& SameTeam) const;
-
-    FVector OwnGoalLocation(int32 TeamID) const;
-
-    void ComputeKeeperTarget(
-        int32 TeamID, const FVector& BallLoc,
-        FVector& OutGoal, FVector& OutKeeperHome,
-        FVector& OutBoxMin, FVector& OutBoxMax) const;
 };
@@ -1,6 +1,7 @@
 ﻿// FootballTeam.cpp
 #include "FootballTeam.h"
 #include "Footballer.h"
+#include "MatchRegistrySubsystem.h"
 
 AFootballTeam::AFootballTeam()
 {
@@ -11,6 +12,8 @@ void AFootballTeam::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this)) Registry->RegisterTeam(this);
+
 	// Ensure any pre-placed Players in the array get proper team data at start.
 	for (int32 i = 0; i < Players.Num(); ++i)
 	{
@@ -25,6 +28,12 @@ void AFootballTeam::BeginPlay()
 	AssignRoles();
 }
 
+void AFootballTeam::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this)) Registry->UnregisterTeam(this);
+	Super::EndPlay(EndPlayReason);
+}
+
 void AFootballTeam::RegisterPlayer(AFootballer* Player)
 {
 	if (!Player) return;
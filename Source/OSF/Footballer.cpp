@@ -2,10 +2,28 @@
 #include "Footballer.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Materials/MaterialInterface.h"
+#include "Components/PrimitiveComponent.h"
+#include "MatchRegistrySubsystem.h"
+#include "DefaultGameMode.h"
+#include "Ballsack.h"
+#include "BallFlightComponent.h"
 
 AFootballer::AFootballer()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Nothing to do per frame; movement and AI tick elsewhere
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+void AFootballer::BeginPlay()
+{
+	Super::BeginPlay();
+	if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this)) Registry->RegisterFootballer(this);
+}
+
+void AFootballer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this)) Registry->UnregisterFootballer(this);
+	Super::EndPlay(EndPlayReason);
 }
 
 void AFootballer::SetDesiredMovement(const FVector& WorldDirection)
@@ -22,6 +40,9 @@ void AFootballer::ApplyTeamMaterial(int32 InTeamID)
 		TeamID = InTeamID;
 	}
 
+	// Every team assignment path ends here; keep the rosters current
+	if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this)) Registry->NotifyTeamChanged(this);
+
 	UMaterialInterface* Chosen = nullptr;
 	if (TeamID == 0)
 	{
@@ -67,12 +88,58 @@ void AFootballer::SetDesiredSprintStrength(float Strength)
 
 void AFootballer::ShootBall(float Power, const FVector& Direction)
 {
-	// Stub to satisfy controller; real shooting is handled elsewhere.
-	// (Optional) UE_LOG(LogTemp, Verbose, TEXT("[Footballer] ShootBall Power=%.2f Dir=%s"), Power, *Direction.ToString());
+	FVector Velocity = Direction.GetSafeNormal2D() * FMath::Clamp(Power, 0.f, 1.f) * MaxKickSpeed;
+	FVector Spin = FVector::ZeroVector;
+
+	FShotChoice Shot;
+	const ADefaultGameMode* GM = GetWorld()->GetAuthGameMode<ADefaultGameMode>();
+	if (GM && GM->ChooseShot(this, Direction, Shot))
+	{
+		Velocity = Shot.Velocity;
+		Spin = Shot.Spin;
+	}
+
+	KickBall(Velocity, Spin);
 }
 
 void AFootballer::PassBall(float Power, const FVector& Direction)
 {
-	// Stub to satisfy controller; real passing is handled elsewhere.
-	// (Optional) UE_LOG(LogTemp, Verbose, TEXT("[Footballer] PassBall Power=%.2f Dir=%s"), Power, *Direction.ToString());
+	FVector Velocity = Direction.GetSafeNormal2D() * FMath::Clamp(Power, 0.f, 1.f) * MaxKickSpeed;
+	FVector Spin = FVector::ZeroVector;
+
+	FPassChoice Pass;
+	const ADefaultGameMode* GM = GetWorld()->GetAuthGameMode<ADefaultGameMode>();
+	if (GM && GM->ChoosePass(this, Direction, Pass))
+	{
+		Velocity = Pass.Velocity;
+		Spin = Pass.Spin;
+	}
+
+	KickBall(Velocity, Spin);
+}
+
+bool AFootballer::KickBall(const FVector& Velocity, const FVector& Spin)
+{
+	const UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this);
+	ABallsack* Ball = Registry ? Registry->GetBall() : nullptr;
+	if (!Ball || FVector::Dist(Ball->GetActorLocation(), GetActorLocation()) > KickReach) return false;
+
+	if (Ball->Flight && Ball->Flight->IsDriving())
+	{
+		Ball->Flight->Launch(Velocity, Spin);
+	}
+	else
+	{
+		UPrimitiveComponent* Root = Cast<UPrimitiveComponent>(Ball->GetRootComponent());
+		if (!Root) return false;
+		Root->SetSimulatePhysics(true);
+		Root->SetPhysicsLinearVelocity(Velocity);
+	}
+
+	if (ADefaultGameMode* GM = GetWorld()->GetAuthGameMode<ADefaultGameMode>())
+	{
+		GM->NotifyTouch(this, false);
+		GM->RecordReplayEvent(EReplayEvent::Kick, this, Velocity);
+	}
+	return true;
 }
@@ -79,15 +79,38 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Input|Shim")
 	void SetDesiredSprintStrength(float Strength);
 
-	/** Stub: logs the intention; real logic can be added later without breaking callers. */
-	UFUNCTION(BlueprintCallable, Category = "Input|Shim")
+	/**
+	 * Shoot with the match's shot engine; Direction (may be zero) picks the side.
+	 * Out of range or without a match, a ground ball along Direction at Power.
+	 * Does nothing unless the ball is within KickReach.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ball")
 	void ShootBall(float Power, const FVector& Direction);
 
-	/** Stub: logs the intention; real logic can be added later without breaking callers. */
-	UFUNCTION(BlueprintCallable, Category = "Input|Shim")
+	/**
+	 * Pass with the match's pass engine; Direction (may be zero) steers it toward the
+	 * player's aim. Without a match or a target, a ground ball along Direction at Power.
+	 * Does nothing unless the ball is within KickReach.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ball")
 	void PassBall(float Power, const FVector& Direction);
 
+	/** Kick the ball with this velocity (and spin, rad/s, when the flight model drives it) if it is within KickReach. */
+	UFUNCTION(BlueprintCallable, Category = "Ball")
+	bool KickBall(const FVector& Velocity, const FVector& Spin = FVector::ZeroVector);
+
+	/** How close the ball must be to kick it (cm). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ball")
+	float KickReach = 200.f;
+
+	/** Ball speed at full power when kicking without a target (cm/s). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ball")
+	float MaxKickSpeed = 2600.f;
+
 protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Where AI/Controller writes its requested movement. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement")
 	FVector DesiredMove = FVector::ZeroVector;
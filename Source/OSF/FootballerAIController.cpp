@@ -6,7 +6,20 @@
 
 AFootballerAIController::AFootballerAIController()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Ticked in batch by UMatchTickSubsystem
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+void AFootballerAIController::BeginPlay()
+{
+	Super::BeginPlay();
+	if (UMatchTickSubsystem* Ticks = UMatchTickSubsystem::Get(this)) Ticks->Register(this, this, TG_PrePhysics);
+}
+
+void AFootballerAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UMatchTickSubsystem* Ticks = UMatchTickSubsystem::Get(this)) Ticks->Unregister(this);
+	Super::EndPlay(EndPlayReason);
 }
 
 void AFootballerAIController::OnPossess(APawn* InPawn)
@@ -15,9 +28,9 @@ void AFootballerAIController::OnPossess(APawn* InPawn)
 	Me = Cast<AFootballer>(InPawn);
 }
 
-void AFootballerAIController::Tick(float DeltaSeconds)
+void AFootballerAIController::BatchTick(float DeltaSeconds)
 {
-	Super::Tick(DeltaSeconds);
+	UpdateControlRotation(DeltaSeconds);
 
 	// Keep AI passive for now to avoid gameplay regressions.
 	// (Add your movement/decision logic here when ready.)
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "MatchTickSubsystem.h"
 #include "FootballerAIController.generated.h"
 
 class AFootballer;
@@ -11,7 +12,7 @@ class AFootballer;
  * You can flesh out behavior later—this existence + ctor fix the linker error.
  */
 UCLASS()
-class OSF_API AFootballerAIController : public AAIController
+class OSF_API AFootballerAIController : public AAIController, public IMatchBatchTickable
 {
 	GENERATED_BODY()
 
@@ -19,8 +20,12 @@ public:
 	AFootballerAIController();
 
 protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void OnPossess(APawn* InPawn) override;
-	virtual void Tick(float DeltaSeconds) override;
+
+	/** AAIController::Tick's work (turning the pawn to its focus), run from the match batch tick. */
+	virtual void BatchTick(float DeltaSeconds) override;
 
 private:
 	// Weak ref so we don't keep pawns alive
@@ -10,6 +10,10 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Engine/Engine.h"
 #include "InputCoreTypes.h"
+#include "OSFStats.h"
+#include "MatchRegistrySubsystem.h"
+#include "Ballsack.h"
+#include "BallFlightComponent.h"
 #include "Components/PrimitiveComponent.h"
 
 AFootballerController::AFootballerController()
@@ -25,6 +29,12 @@ void AFootballerController::BeginPlay()
 	Super::BeginPlay();
 	SetInputMode(FInputModeGameOnly{});
 
+	if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this))
+	{
+		Registry->OnBallChanged.AddUObject(this, &AFootballerController::HandleBallChanged);
+		Registry->OnRosterChanged.AddUObject(this, &AFootballerController::HandleRosterChanged);
+	}
+
 	CacheRefs();
 	FTimerHandle Th;
 	GetWorldTimerManager().SetTimer(Th, this, &AFootballerController::CacheRefs, InitialCacheDelay, false);
@@ -115,6 +125,13 @@ void AFootballerController::GetCameraBasis(FVector& OutForward, FVector& OutRigh
 	OutForward = Fwd; OutRight = Rt;
 }
 
+FVector AFootballerController::GetAimDirection(const AFootballer* Me) const
+{
+	FVector Fwd, Rt; GetCameraBasis(Fwd, Rt);
+	const FVector Aim = (Fwd * AxisForward) + (Rt * AxisRight);
+	return Aim.IsNearlyZero() ? Me->GetActorForwardVector() : Aim;
+}
+
 void AFootballerController::ApplyDesiredMovement()
 {
 	if (AFootballer* Me = GetControlledFootballer())
@@ -174,6 +191,7 @@ void AFootballerController::SprintPressed()
 	if (AFootballer* Me = GetControlledFootballer())
 	{
 		Me->SetDesiredSprintStrength(1.f);
+		RecordInput(EReplayEvent::Sprint, FVector(1.f, 0.f, 0.f));
 		Screen(TEXT("Sprint ON"));
 	}
 }
@@ -182,6 +200,7 @@ void AFootballerController::SprintReleased()
 	if (AFootballer* Me = GetControlledFootballer())
 	{
 		Me->SetDesiredSprintStrength(0.f);
+		RecordInput(EReplayEvent::Sprint);
 		Screen(TEXT("Sprint OFF"));
 	}
 }
@@ -192,7 +211,9 @@ void AFootballerController::ShootPressed()
 
 	if (AFootballer* Me = GetControlledFootballer())
 	{
-		Me->ShootBall(1.f, Me->GetActorForwardVector());
+		const FVector Aim = GetAimDirection(Me);
+		RecordInput(EReplayEvent::ShootInput, Aim);
+		Me->ShootBall(1.f, Aim);
 		Screen(TEXT("Shoot"));
 	}
 }
@@ -202,24 +223,26 @@ void AFootballerController::PassPressed()
 
 	if (AFootballer* Me = GetControlledFootballer())
 	{
-		Me->PassBall(0.75f, Me->GetActorForwardVector());
+		// The pass engine picks the receiver and the weight; the stick only steers it
+		const FVector Aim = GetAimDirection(Me);
+		RecordInput(EReplayEvent::PassInput, Aim);
+		Me->PassBall(0.75f, Aim);
 		Screen(TEXT("Pass"));
 	}
 }
 
 void AFootballerController::CacheRefs()
 {
+	OSF_SCOPE(CacheRefs);
+
 	TeamMates.Reset();
-	for (TActorIterator<AFootballer> It(GetWorld()); It; ++It)
+	if (const UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this))
 	{
-		if (It->TeamID == ControlledTeamID)
-		{
-			TeamMates.Add(*It);
-		}
+		TeamMates = Registry->GetRoster(ControlledTeamID);
 	}
 
 	BallActor = FindBallActor();
-	BallRoot = BallActor ? Cast<UPrimitiveComponent>(BallActor->GetRootComponent()) : nullptr;
+	CacheBallComponents();
 
 	Screen(FString::Printf(TEXT("Cached: Teammates=%d, Ball=%s"),
 		TeamMates.Num(), *GetNameSafe(BallActor)));
@@ -231,23 +254,44 @@ void AFootballerController::CacheRefs()
 
 AActor* AFootballerController::FindBallActor() const
 {
-	AActor* Best = nullptr; float BestScore = -FLT_MAX;
-	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	OSF_SCOPE(FindBallActor);
+
+	const UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this);
+	return Registry ? Registry->GetBall() : nullptr;
+}
+
+void AFootballerController::HandleBallChanged(ABallsack* NewBall)
+{
+	if (bHasBall && BallActor != NewBall) bHasBall = false;
+	BallActor = NewBall;
+	CacheBallComponents();
+}
+
+void AFootballerController::CacheBallComponents()
+{
+	BallRoot = BallActor ? Cast<UPrimitiveComponent>(BallActor->GetRootComponent()) : nullptr;
+	BallFlight = BallActor ? BallActor->FindComponentByClass<UBallFlightComponent>() : nullptr;
+}
+
+void AFootballerController::HandleRosterChanged(int32 TeamID)
+{
+	if (TeamID != ControlledTeamID) return;
+	if (const UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this))
 	{
-		const FString N = It->GetName();
-		if (N.Contains(TEXT("Ball"), ESearchCase::IgnoreCase))
-		{
-			const float Score = -N.Len();
-			if (Score > BestScore) { BestScore = Score; Best = *It; }
-		}
+		TeamMates = Registry->GetRoster(ControlledTeamID);
 	}
-	return Best;
 }
 
 AFootballer* AFootballerController::FindClosestToBall() const
 {
 	if (!BallActor) return nullptr;
 
+	// First to the ball by the match's intercept solve, when there is one
+	if (const ADefaultGameMode* GM = GetWorld()->GetAuthGameMode<ADefaultGameMode>())
+	{
+		if (AFootballer* First = GM->GetFirstInterceptor(ControlledTeamID)) return First;
+	}
+
 	const FVector BallLoc = BallActor->GetActorLocation();
 	float BestDistSq = TNumericLimits<float>::Max();
 	AFootballer* Best = nullptr;
@@ -380,6 +424,7 @@ void AFootballerController::PossessFootballer(AFootballer* P)
 
 	CurrentControlled = P;
 	Possess(P);
+	RecordInput(EReplayEvent::Switch);
 
 	// Configure facing for the pawn we now control
 	ApplyPlayerFacingIfCharacter(P);
@@ -392,7 +437,9 @@ void AFootballerController::PossessFootballer(AFootballer* P)
 
 void AFootballerController::UpdatePossession(float DeltaSeconds)
 {
-	if (!BallActor) { BallActor = FindBallActor(); BallRoot = BallActor ? Cast<UPrimitiveComponent>(BallActor->GetRootComponent()) : nullptr; }
+	CSV_SCOPED_TIMING_STAT(OSF, UpdatePossession);
+	OSF_SCOPE(UpdatePossession);
+	// Ball arrives through HandleBallChanged; nothing to search for here
 	if (!BallActor || !BallRoot) return;
 
 	AFootballer* Me = GetControlledFootballer();
@@ -415,12 +462,17 @@ void AFootballerController::UpdatePossession(float DeltaSeconds)
 		const FVector Right = Me->GetActorRightVector();
 		const FVector HoldLoc = Me->GetActorLocation() + Fwd * HoldOffsetLocal.X + Right * HoldOffsetLocal.Y + FVector(0, 0, HoldOffsetLocal.Z);
 
+		if (BallFlight && BallFlight->IsDriving())
+		{
+			BallFlight->Hold(HoldLoc);
+			return;
+		}
 		BallRoot->SetSimulatePhysics(false);
 		BallActor->SetActorLocation(HoldLoc, false, nullptr, ETeleportType::TeleportPhysics);
 		return;
 	}
 
-	// Not holding: auto-pickup if close and ball isn't moving fast
+	// Not holding: auto-pickup if close and ball isn't moving fast (the flight model keeps this velocity current too)
 	const FVector BallVel = BallRoot->GetComponentVelocity();
 	if (Dist <= PickupDistance && BallVel.Size() < 500.f)
 	{
@@ -439,7 +491,16 @@ void AFootballerController::TakeBall()
 		GM->NotifyPossession(GetControlledFootballer());
 	}
 
-	BallRoot->SetSimulatePhysics(false);
+	if (BallFlight && BallFlight->IsDriving()) BallFlight->Hold(BallActor->GetActorLocation());
+	else BallRoot->SetSimulatePhysics(false);
+}
+
+void AFootballerController::RecordInput(EReplayEvent Type, const FVector& Value) const
+{
+	if (ADefaultGameMode* GM = GetWorld()->GetAuthGameMode<ADefaultGameMode>())
+	{
+		GM->RecordReplayEvent(Type, GetControlledFootballer(), Value);
+	}
 }
 
 void AFootballerController::ReleaseBall(bool /*bKicked*/)
@@ -453,5 +514,6 @@ void AFootballerController::ReleaseBall(bool /*bKicked*/)
 		GM->ClearPossession(GetControlledFootballer());
 	}
 
-	BallRoot->SetSimulatePhysics(true);
+	if (BallFlight && BallFlight->IsDriving()) BallFlight->Release();
+	else BallRoot->SetSimulatePhysics(true);
 }
@@ -5,6 +5,7 @@
 #include "FootballerController.generated.h"
 
 class AFootballer;
+enum class EReplayEvent : uint8;
 
 UCLASS()
 class OSF_API AFootballerController : public APlayerController
@@ -50,6 +51,7 @@ private:
 
 	UPROPERTY() AActor* BallActor = nullptr;
 	UPROPERTY() class UPrimitiveComponent* BallRoot = nullptr;
+	UPROPERTY() class UBallFlightComponent* BallFlight = nullptr; // null or not driving: Chaos moves the ball
 
 	bool   bHasBall = false;
 	float  AxisForward = 0.f;
@@ -87,13 +89,20 @@ private:
 	AFootballer* FindClosestToBall() const;
 	AFootballer* FindCycle(bool bNext) const;
 	void GetCameraBasis(FVector& OutForward, FVector& OutRight) const;
+	FVector GetAimDirection(const AFootballer* Me) const; // stick in camera space, else facing
 	AActor* FindBallActor() const;
+	void HandleBallChanged(class ABallsack* NewBall);
+	void CacheBallComponents();
+	void HandleRosterChanged(int32 TeamID);
 
 	// --- Possession helpers ---
 	void UpdatePossession(float DeltaSeconds);
 	void TakeBall();
 	void ReleaseBall(bool bKicked = false);
 
+	// Input into the match recording, if one is running
+	void RecordInput(EReplayEvent Type, const FVector& Value = FVector::ZeroVector) const;
+
 	// Debug
 	void Screen(const FString& Msg, const FColor& C = FColor::Green, float T = 1.5f) const;
 	void DebugKeyD();
@@ -0,0 +1,25 @@
+#include "FormationRow.h"
+
+// Straight from the row map: no FindRow per name
+bool ReadFormationRows(const UDataTable* Table, TArray<FVector>& OutLocal, TArray<uint8>* OutRoles)
+{
+	OutLocal.Reset();
+	if (OutRoles) OutRoles->Reset();
+
+	const UScriptStruct* RowStruct = Table ? Table->GetRowStruct() : nullptr;
+	if (!RowStruct || !RowStruct->IsChildOf(FFormationRow::StaticStruct())) return false;
+
+	TArray<const FFormationRow*, TInlineAllocator<32>> Rows;
+	for (const TPair<FName, uint8*>& It : Table->GetRowMap())
+	{
+		Rows.Add(reinterpret_cast<const FFormationRow*>(It.Value));
+	}
+	Rows.StableSort([](const FFormationRow& A, const FFormationRow& B) { return A.Index < B.Index; });
+
+	for (const FFormationRow* Row : Rows)
+	{
+		OutLocal.Add(Row->LocalPosition);
+		if (OutRoles) OutRoles->Add(static_cast<uint8>(Row->Role));
+	}
+	return OutLocal.Num() > 0;
+}
@@ -24,3 +24,6 @@ struct FFormationRow : public FTableRowBase
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	EFootballRole Role = EFootballRole::MID;
 };
+
+/** Rows of a formation table in Index order; false if Table holds no FFormationRow rows. */
+OSF_API bool ReadFormationRows(const UDataTable* Table, TArray<FVector>& OutLocal, TArray<uint8>* OutRoles = nullptr);
@@ -0,0 +1,54 @@
+#include "FormationZoneAsset.h"
+
+#include "FormationRow.h"
+#include "Sim/MatchKernel.h"
+
+void UFormationZoneAsset::PostLoad()
+{
+    Super::PostLoad();
+    RebuildZones();
+}
+
+void UFormationZoneAsset::RebuildZones()
+{
+    const bool bValid = Zones.Assign(NumX, NumY, NumSlots, TableHalfLength, TableHalfWidth, Points);
+    UE_CLOG(!bValid && Points.Num() > 0, LogTemp, Warning,
+        TEXT("%s: table sizes do not match its %d points; not used"), *GetName(), Points.Num());
+}
+
+#if WITH_EDITOR
+void UFormationZoneAsset::Bake()
+{
+    TArray<FVector> Local;
+    if (!ReadFormationRows(Formation, Local)) FMatchKernel::MakeDefaultFormation(HalfLength, Local);
+
+    FTacticParams Tactics;
+    Tactics.HalfLength = HalfLength;
+    Tactics.HalfWidth = HalfWidth;
+    Tactics.HomeWeight = HomeWeight;
+    Tactics.AdvanceWithBall = AdvanceWithBall;
+    Tactics.RetreatWithBall = RetreatWithBall;
+
+    FFormationZoneBake Params;
+    Params.NumX = BakeNumX;
+    Params.NumY = BakeNumY;
+    Params.SlideX = SlideX;
+    Params.SlideY = SlideY;
+
+    Modify();
+    Zones.Bake(Tactics, Local, BakeNumSlots, Params);
+    NumX = Zones.GetNumX();
+    NumY = Zones.GetNumY();
+    NumSlots = Zones.GetNumSlots();
+    TableHalfLength = Zones.GetHalfLength();
+    TableHalfWidth = Zones.GetHalfWidth();
+    Points = Zones.GetPoints();
+    MarkPackageDirty();
+}
+
+void UFormationZoneAsset::PostEditChangeProperty(FPropertyChangedEvent& Event)
+{
+    Super::PostEditChangeProperty(Event);
+    RebuildZones(); // hand edits to the table apply at once
+}
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Sim/FormationZones.h"
+#include "FormationZoneAsset.generated.h"
+
+class UDataTable;
+
+/**
+ * A ball-zone shape table (FFormationZones) as an asset: baked in the editor
+ * from a formation and the team AI's rules, or authored by editing Points.
+ * Loaded once and read by every match that lists it in the game mode's
+ * FormationZones, for the formation it was made for.
+ */
+UCLASS(BlueprintType)
+class OSF_API UFormationZoneAsset : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // ---------- Bake ----------
+    // Formation the table is for; none = the game mode's FormationTable (or the built-in 4-4-2)
+    UPROPERTY(EditAnywhere, Category = "Bake") UDataTable* Formation = nullptr;
+
+    // Rules to bake from: the game mode's tunables of the same names
+    UPROPERTY(EditAnywhere, Category = "Bake") float HalfLength = 9000.f;
+    UPROPERTY(EditAnywhere, Category = "Bake") float HalfWidth = 6000.f;
+    UPROPERTY(EditAnywhere, Category = "Bake") float HomeWeight = 0.65f;
+    UPROPERTY(EditAnywhere, Category = "Bake") float AdvanceWithBall = 1400.f;
+    UPROPERTY(EditAnywhere, Category = "Bake") float RetreatWithBall = 1200.f;
+
+    // Ball grid, and how far the shape follows the ball along and across (0 = the rules' fixed shape)
+    UPROPERTY(EditAnywhere, Category = "Bake") int32 BakeNumX = 13;
+    UPROPERTY(EditAnywhere, Category = "Bake") int32 BakeNumY = 9;
+    UPROPERTY(EditAnywhere, Category = "Bake") int32 BakeNumSlots = 11;
+    UPROPERTY(EditAnywhere, Category = "Bake") float SlideX = 0.25f;
+    UPROPERTY(EditAnywhere, Category = "Bake") float SlideY = 0.35f;
+
+#if WITH_EDITOR
+    // Overwrites the table below from the settings above
+    UFUNCTION(CallInEditor, Category = "Bake") void Bake();
+
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& Event) override;
+#endif
+
+    // ---------- Table ----------
+    // [phase][y][x][slot][x, y], attack first; cm from the centre with team 0 attacking +X
+    UPROPERTY(EditAnywhere, Category = "Table") int32 NumX = 0;
+    UPROPERTY(EditAnywhere, Category = "Table") int32 NumY = 0;
+    UPROPERTY(EditAnywhere, Category = "Table") int32 NumSlots = 0;
+    UPROPERTY(EditAnywhere, Category = "Table") float TableHalfLength = 0.f;
+    UPROPERTY(EditAnywhere, Category = "Table") float TableHalfWidth = 0.f;
+    UPROPERTY(EditAnywhere, Category = "Table") TArray<int16> Points;
+
+    virtual void PostLoad() override;
+
+    /** The table, ready to sample; invalid until baked or authored with consistent sizes. */
+    const FFormationZones& GetZones() const { return Zones; }
+
+private:
+    void RebuildZones();
+
+    FFormationZones Zones;
+};
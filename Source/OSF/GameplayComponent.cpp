@@ -4,9 +4,11 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 
+#include "DefaultGameMode.h"
+
 UGameplayComponent::UGameplayComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 void UGameplayComponent::BeginPlay()
@@ -14,11 +16,6 @@ void UGameplayComponent::BeginPlay()
 	Super::BeginPlay();
 }
 
-void UGameplayComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-}
-
 // NOTE: Removed "const" to match header declaration and fix C2511.
 bool UGameplayComponent::CanKickBall(ACharacter* Character, AActor* Ball)
 {
@@ -55,6 +52,19 @@ void UGameplayComponent::MoveToBallForKick(ACharacter* Character, AActor* Ball,
 
 	const float TimeToTarget = (MaxSpeed > 0.f) ? (Distance / MaxSpeed) : 0.f;
 	FVector PredictedBall = BallPos + Ball->GetVelocity() * TimeToTarget;
+
+	// The match's shared prediction knows about drag, bounces and the ball slowing down
+	const ADefaultGameMode* GM = GetWorld() ? GetWorld()->GetAuthGameMode<ADefaultGameMode>() : nullptr;
+	if (GM && GM->GetBallPrediction().IsValid() && MaxSpeed > 0.f)
+	{
+		const FBallPrediction& Prediction = GM->GetBallPrediction();
+		const double Now = GetWorld()->GetTimeSeconds();
+		PredictedBall = Prediction.PositionAt(Now + TimeToTarget);
+
+		// One refinement: time to where the ball will be, not where it is
+		const float Refined = FVector::Dist2D(PredictedBall, CharPos) / MaxSpeed;
+		PredictedBall = Prediction.PositionAt(Now + Refined);
+	}
 	PredictedBall.Z = CharPos.Z;
 
 	FVector MoveDir = PredictedBall - CharPos;
@@ -3,6 +3,8 @@
 #include "Engine/EngineTypes.h" // for FAttachmentTransformRules
 #include "OSF.h"
 #include "Components/StaticMeshComponent.h"
+#include "OSFStats.h"
+#include "MatchRegistrySubsystem.h"
 
 // Fill out your copyright notice in the Description page of Project Settings.
 
@@ -11,8 +13,8 @@
 // Sets default values
 AGoal::AGoal()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Static posts; no per-frame work
+	PrimaryActorTick.bCanEverTick = false;
     
     RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneComponent"));
     
@@ -47,24 +49,24 @@ AGoal::AGoal()
 void AGoal::BeginPlay()
 {
 	Super::BeginPlay();
-	
+	if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this)) Registry->RegisterGoal(this);
 }
 
-// Called every frame
-void AGoal::Tick( float DeltaTime )
+void AGoal::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick( DeltaTime );
-
+	if (UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(this)) Registry->UnregisterGoal(this);
+	Super::EndPlay(EndPlayReason);
 }
 
 bool AGoal::IsLocationInGoal(FVector BallLocation)
 {
+    OSF_SCOPE(IsLocationInGoal);
+
     // Ball vector: X=4816.097 Y=-260.000 Z=203.153, Left vector: X=-4755.000 Y=-465.000 Z=50.000, Right vector: X=-4755.000 Y=465.000 Z=50.000
     // Ball vector: X=4816.097 Y=-260.000 Z=203.153, Left vector: X=4755.000 Y=-465.000 Z=50.000, Right vector: X=4755.000 Y=465.000 Z=50.000
     FVector LeftPostVector = this->LeftPost->GetComponentLocation();
     FVector RightPostVector = this->RightPost->GetComponentLocation();
     FVector CrossbarVector = this->Crossbar->GetComponentLocation();
-    UE_LOG(LogTemp, Warning, TEXT("Ball Vector: %s, Left Vector: %s, Right Vector: %s, Crossbar Vector: %s"), *BallLocation.ToString(), *LeftPostVector.ToString(), *RightPostVector.ToString(), *CrossbarVector.ToString());
     
     if (BallLocation.Z > 0 && BallLocation.Z < CrossbarVector.Z) {
         if (LeftPostVector.X < 0) {
@@ -17,8 +17,8 @@ public:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 	
-	// Called every frame
-	virtual void Tick( float DeltaSeconds ) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     
     void VibrateController(AActor* selfActor, AActor* otherActor, FVector normalImpulse, const FHitResult& hit);
     
@@ -31,6 +31,7 @@ public:
     UPROPERTY(Category = StaticMeshActor, VisibleAnywhere, BlueprintReadOnly)
     UStaticMeshComponent *Crossbar;
 
+    // Point test for Blueprints; goals in play are detected by the game mode's swept FPitchRules
     UFUNCTION(BlueprintCallable, Category = Custom)
     bool IsLocationInGoal(FVector ballLocation);
 	
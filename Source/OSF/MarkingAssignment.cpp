@@ -0,0 +1,205 @@
+#include "MarkingAssignment.h"
+
+#include "HAL/PlatformTime.h"
+
+#include "MatchSnapshot.h"
+
+namespace
+{
+    using FCostArray = TArray<float, TInlineAllocator<1024>>;
+    using FIdxArray = TArray<int32, TInlineAllocator<64>>;
+    using FPotArray = TArray<float, TInlineAllocator<64>>;
+
+    constexpr float Inf = TNumericLimits<float>::Max();
+
+    /**
+     * Square min-cost assignment, shortest-augmenting-path Hungarian.
+     * C is N*N row-major. V holds feasible column potentials on entry (V[j] <= C[i][j] for all i).
+     * On exit RowToCol[i] is the column assigned to row i and V the final potentials.
+     */
+    void SolveHungarian(int32 N, const FCostArray& C, FPotArray& V, FIdxArray& RowToCol)
+    {
+        // 1-based internally; column 0 is the virtual source.
+        FPotArray U;       U.SetNumZeroed(N + 1);
+        FPotArray V1;      V1.SetNumUninitialized(N + 1);
+        FIdxArray P;       P.SetNumZeroed(N + 1);   // P[j] = row matched to column j
+        FIdxArray Way;     Way.SetNumZeroed(N + 1);
+        FPotArray MinV;    MinV.SetNumUninitialized(N + 1);
+        TArray<bool, TInlineAllocator<64>> Used; Used.SetNumUninitialized(N + 1);
+
+        V1[0] = 0.f;
+        for (int32 j = 0; j < N; ++j) V1[j + 1] = V[j];
+
+        for (int32 i = 1; i <= N; ++i)
+        {
+            P[0] = i;
+            int32 J0 = 0;
+            for (int32 j = 0; j <= N; ++j) { MinV[j] = Inf; Used[j] = false; }
+
+            do
+            {
+                Used[J0] = true;
+                const int32 I0 = P[J0];
+                float Delta = Inf;
+                int32 J1 = 0;
+
+                for (int32 j = 1; j <= N; ++j)
+                {
+                    if (Used[j]) continue;
+                    const float Cur = C[(I0 - 1) * N + (j - 1)] - U[I0] - V1[j];
+                    if (Cur < MinV[j]) { MinV[j] = Cur; Way[j] = J0; }
+                    if (MinV[j] < Delta) { Delta = MinV[j]; J1 = j; }
+                }
+                for (int32 j = 0; j <= N; ++j)
+                {
+                    if (Used[j]) { U[P[j]] += Delta; V1[j] -= Delta; }
+                    else         { MinV[j] -= Delta; }
+                }
+                J0 = J1;
+            } while (P[J0] != 0);
+
+            do
+            {
+                const int32 J1 = Way[J0];
+                P[J0] = P[J1];
+                J0 = J1;
+            } while (J0 != 0);
+        }
+
+        RowToCol.SetNumUninitialized(N);
+        for (int32 j = 1; j <= N; ++j) RowToCol[P[j] - 1] = j - 1;
+        for (int32 j = 0; j < N; ++j) V[j] = V1[j + 1];
+    }
+}
+
+void FMarkingAssignment::Reset()
+{
+    PrevTargetSlot.Reset();
+    PrevColPotential.Reset();
+    LastSolveMicros = 0.0;
+    bLastWarmHit = false;
+    NumSwitches = 0;
+}
+
+void FMarkingAssignment::Solve(const FMatchSnapshot& Snap, int32 TeamID, TConstArrayView<int32> MarkerSlots, TArray<int32, TInlineAllocator<32>>& OutTargets)
+{
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    const int32 OppTeam = 1 - TeamID;
+    const int32 OppBegin = Snap.TeamBegin[OppTeam];
+    const int32 OppCount = Snap.TeamEnd[OppTeam] - OppBegin;
+    const int32 OurCount = Snap.TeamEnd[TeamID] - Snap.TeamBegin[TeamID];
+
+    OutTargets.Init(INDEX_NONE, MarkerSlots.Num());
+
+    // Columns: valid attackers only
+    FIdxArray ColSlot;
+    for (int32 s = 0; s < OppCount; ++s)
+    {
+        if (Snap.Valid[OppBegin + s]) ColSlot.Add(s);
+    }
+
+    const int32 Rows = MarkerSlots.Num();
+    const int32 Cols = ColSlot.Num();
+    const int32 N = FMath::Max(Rows, Cols);
+
+    if (PrevTargetSlot.Num() != OurCount) PrevTargetSlot.Init(INDEX_NONE, OurCount);
+    if (PrevColPotential.Num() != OppCount) PrevColPotential.Init(0.f, OppCount);
+
+    if (Rows == 0 || Cols == 0)
+    {
+        for (int32 s : MarkerSlots) PrevTargetSlot[s] = INDEX_NONE;
+        bLastWarmHit = false; NumSwitches = 0;
+        LastSolveMicros = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+        return;
+    }
+
+    // Padded square cost matrix; dummy rows/columns cost 0 (= leave unassigned)
+    FCostArray C;
+    C.SetNumZeroed(N * N);
+    for (int32 r = 0; r < Rows; ++r)
+    {
+        const int32 Mi = Snap.IndexOf(TeamID, MarkerSlots[r]);
+        const int32 Prev = PrevTargetSlot[MarkerSlots[r]];
+        for (int32 c = 0; c < Cols; ++c)
+        {
+            const int32 Ai = OppBegin + ColSlot[c];
+            const float DX = Snap.PosX[Mi] - Snap.PosX[Ai];
+            const float DY = Snap.PosY[Mi] - Snap.PosY[Ai];
+            float Cost = FMath::Sqrt(DX * DX + DY * DY);
+            if (Prev != ColSlot[c]) Cost += SwitchPenalty;
+            C[r * N + c] = Cost;
+        }
+    }
+
+    // Feasible potentials seeded from last tick: V[j] <= min_i C[i][j]
+    FPotArray V;
+    V.SetNumUninitialized(N);
+    for (int32 c = 0; c < N; ++c)
+    {
+        float ColMin = Inf;
+        for (int32 r = 0; r < N; ++r) ColMin = FMath::Min(ColMin, C[r * N + c]);
+        const float Seed = (c < Cols) ? PrevColPotential[ColSlot[c]] : 0.f;
+        V[c] = FMath::Min(Seed, ColMin);
+    }
+
+    // Warm check: is last tick's assignment still optimal under these costs?
+    FIdxArray RowToCol;
+    RowToCol.Init(INDEX_NONE, N);
+    bool bWarm = true;
+    {
+        TArray<bool, TInlineAllocator<64>> ColTaken;
+        ColTaken.Init(false, N);
+        for (int32 r = 0; r < Rows && bWarm; ++r)
+        {
+            const int32 Prev = PrevTargetSlot[MarkerSlots[r]];
+            const int32 c = (Prev == INDEX_NONE) ? INDEX_NONE : ColSlot.IndexOfByKey(Prev);
+            if (c == INDEX_NONE || ColTaken[c]) { bWarm = false; break; }
+            RowToCol[r] = c; ColTaken[c] = true;
+        }
+        // Remaining (dummy) rows take the free columns in order
+        int32 NextFree = 0;
+        for (int32 r = Rows; r < N && bWarm; ++r)
+        {
+            while (NextFree < N && ColTaken[NextFree]) ++NextFree;
+            RowToCol[r] = NextFree; ColTaken[NextFree] = true;
+        }
+        // Markers left over when there are fewer attackers
+        if (bWarm && Rows > Cols) bWarm = false;
+
+        // Complementary slackness: U_i = C[i][sigma(i)] - V[sigma(i)], all reduced costs >= 0
+        if (bWarm)
+        {
+            for (int32 r = 0; r < N && bWarm; ++r)
+            {
+                const float Ur = C[r * N + RowToCol[r]] - V[RowToCol[r]];
+                for (int32 c = 0; c < N; ++c)
+                {
+                    if (C[r * N + c] - Ur - V[c] < -KINDA_SMALL_NUMBER) { bWarm = false; break; }
+                }
+            }
+        }
+    }
+
+    if (!bWarm)
+    {
+        SolveHungarian(N, C, V, RowToCol);
+    }
+
+    // Publish + remember
+    NumSwitches = 0;
+    for (int32 r = 0; r < Rows; ++r)
+    {
+        const int32 c = RowToCol[r];
+        const int32 Slot = (c < Cols) ? ColSlot[c] : INDEX_NONE;
+        OutTargets[r] = (Slot != INDEX_NONE) ? OppBegin + Slot : INDEX_NONE;
+
+        int32& Prev = PrevTargetSlot[MarkerSlots[r]];
+        if (Prev != Slot) ++NumSwitches;
+        Prev = Slot;
+    }
+    for (int32 c = 0; c < Cols; ++c) PrevColPotential[ColSlot[c]] = V[c];
+
+    bLastWarmHit = bWarm;
+    LastSolveMicros = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+}
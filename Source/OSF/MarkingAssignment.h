@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMatchSnapshot;
+
+/**
+ * Optimal defender -> attacker marking for one team (Hungarian, min total cost).
+ *
+ * Cost is the XY distance from marker to attacker, plus SwitchPenalty when the
+ * pair differs from last tick's assignment, so markers only swap when it pays.
+ * State persists between Thinks and is used as a warm start: the previous
+ * assignment and column potentials are first checked for optimality under the
+ * new costs (O(n^2)); only if that fails does the full O(n^3) solve run, seeded
+ * with the previous potentials.
+ */
+struct OSF_API FMarkingAssignment
+{
+    /** Extra cost (cm) for changing a marker's target. */
+    float SwitchPenalty = 400.f;
+
+    /**
+     * MarkerSlots: slots of TeamID's players that mark this tick.
+     * OutTargets[k]: snapshot index of the attacker for MarkerSlots[k], or INDEX_NONE.
+     */
+    void Solve(const FMatchSnapshot& Snap, int32 TeamID, TConstArrayView<int32> MarkerSlots, TArray<int32, TInlineAllocator<32>>& OutTargets);
+
+    void Reset();
+
+    // ---------- Diagnostics ----------
+    double LastSolveMicros = 0.0;
+    bool   bLastWarmHit = false;   // previous assignment was still optimal
+    int32  NumSwitches = 0;        // markers that changed target last solve
+
+private:
+    // Indexed by our slot -> opponent slot (INDEX_NONE = unassigned)
+    TArray<int32> PrevTargetSlot;
+    // Indexed by opponent slot
+    TArray<float> PrevColPotential;
+};
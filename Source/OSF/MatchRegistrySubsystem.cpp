@@ -0,0 +1,126 @@
+#include "MatchRegistrySubsystem.h"
+
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+
+#include "Ballsack.h"
+#include "Footballer.h"
+#include "FootballTeam.h"
+#include "Goal.h"
+
+UMatchRegistrySubsystem* UMatchRegistrySubsystem::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UMatchRegistrySubsystem>() : nullptr;
+}
+
+bool UMatchRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ---------------- Ball ----------------
+void UMatchRegistrySubsystem::RegisterBall(ABallsack* InBall)
+{
+    if (!InBall || Ball == InBall) return;
+    UE_CLOG(Ball != nullptr, LogTemp, Warning, TEXT("MatchRegistry: second ball %s replaces %s"), *GetNameSafe(InBall), *GetNameSafe(Ball));
+    Ball = InBall;
+    OnBallChanged.Broadcast(Ball);
+}
+
+void UMatchRegistrySubsystem::UnregisterBall(ABallsack* InBall)
+{
+    if (!InBall || Ball != InBall) return;
+    Ball = nullptr;
+    OnBallChanged.Broadcast(nullptr);
+}
+
+// ---------------- Footballers ----------------
+void UMatchRegistrySubsystem::RegisterFootballer(AFootballer* Player)
+{
+    if (!Player || Footballers.Contains(Player)) return;
+    Footballers.Add(Player);
+    SetRosterTeam(Player, Player->TeamID);
+}
+
+void UMatchRegistrySubsystem::UnregisterFootballer(AFootballer* Player)
+{
+    if (Footballers.Remove(Player) == 0) return;
+    SetRosterTeam(Player, INDEX_NONE);
+}
+
+void UMatchRegistrySubsystem::NotifyTeamChanged(AFootballer* Player)
+{
+    // Unregistered players (team set before BeginPlay) are picked up when they register
+    if (Player && RosterTeams.Contains(Player)) SetRosterTeam(Player, Player->TeamID);
+}
+
+void UMatchRegistrySubsystem::SetRosterTeam(AFootballer* Player, int32 NewTeamID)
+{
+    if (NewTeamID != 0 && NewTeamID != 1) NewTeamID = INDEX_NONE;
+
+    int32 OldTeamID = INDEX_NONE;
+    if (NewTeamID == INDEX_NONE)
+    {
+        RosterTeams.RemoveAndCopyValue(Player, OldTeamID);
+    }
+    else
+    {
+        int32& Known = RosterTeams.FindOrAdd(Player, INDEX_NONE);
+        OldTeamID = Known;
+        Known = NewTeamID;
+    }
+    if (OldTeamID == NewTeamID) return;
+
+    bRostersDirty = true;
+    if (OldTeamID != INDEX_NONE) OnRosterChanged.Broadcast(OldTeamID);
+    if (NewTeamID != INDEX_NONE) OnRosterChanged.Broadcast(NewTeamID);
+}
+
+const TArray<AFootballer*>& UMatchRegistrySubsystem::GetRoster(int32 TeamID) const
+{
+    static const TArray<AFootballer*> Empty;
+    if (TeamID != 0 && TeamID != 1) return Empty;
+
+    if (bRostersDirty) RebuildRosters();
+    return Rosters[TeamID];
+}
+
+void UMatchRegistrySubsystem::RebuildRosters() const
+{
+    Rosters[0].Reset();
+    Rosters[1].Reset();
+    for (AFootballer* P : Footballers)
+    {
+        if (IsValid(P) && (P->TeamID == 0 || P->TeamID == 1)) Rosters[P->TeamID].Add(P);
+    }
+    bRostersDirty = false;
+}
+
+// ---------------- Teams / goals ----------------
+void UMatchRegistrySubsystem::RegisterTeam(AFootballTeam* Team)
+{
+    if (!Team || (Team->TeamID != 0 && Team->TeamID != 1)) return;
+    UnregisterTeam(Team); // re-registering after a TeamID change moves it
+    Teams[Team->TeamID] = Team;
+}
+
+void UMatchRegistrySubsystem::UnregisterTeam(AFootballTeam* Team)
+{
+    for (AFootballTeam*& T : Teams)
+    {
+        if (T == Team) T = nullptr;
+    }
+}
+
+void UMatchRegistrySubsystem::RegisterGoal(AGoal* Goal)
+{
+    if (!Goal || Goals.Contains(Goal)) return;
+    Goals.Add(Goal);
+    OnGoalsChanged.Broadcast();
+}
+
+void UMatchRegistrySubsystem::UnregisterGoal(AGoal* Goal)
+{
+    if (Goals.Remove(Goal) > 0) OnGoalsChanged.Broadcast();
+}
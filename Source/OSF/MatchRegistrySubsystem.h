@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "MatchRegistrySubsystem.generated.h"
+
+class ABallsack;
+class AFootballer;
+class AFootballTeam;
+class AGoal;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnMatchBallChanged, ABallsack* /*NewBall, may be null*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnMatchRosterChanged, int32 /*TeamID*/);
+DECLARE_MULTICAST_DELEGATE(FOnMatchGoalsChanged);
+
+/**
+ * Where the match actors are, without scanning the world.
+ *
+ * The ball, footballers, teams and goals register on BeginPlay and unregister
+ * on EndPlay. Lookups are O(1); team rosters are rebuilt from the footballer
+ * list only after a change (registration or a TeamID change reported through
+ * NotifyTeamChanged), and OnRosterChanged fires only for the teams a player
+ * actually left or joined. Listeners bind to the change delegates instead of polling.
+ */
+UCLASS()
+class OSF_API UMatchRegistrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Registry of WorldContext's world, or null (no world, or not a game/PIE world). */
+    static UMatchRegistrySubsystem* Get(const UObject* WorldContext);
+
+    // ---------- Registration ----------
+    void RegisterBall(ABallsack* Ball);
+    void UnregisterBall(ABallsack* Ball);
+
+    void RegisterFootballer(AFootballer* Player);
+    void UnregisterFootballer(AFootballer* Player);
+    void NotifyTeamChanged(AFootballer* Player);
+
+    /** Also call after changing the team's TeamID. */
+    void RegisterTeam(AFootballTeam* Team);
+    void UnregisterTeam(AFootballTeam* Team);
+
+    void RegisterGoal(AGoal* Goal);
+    void UnregisterGoal(AGoal* Goal);
+
+    // ---------- Queries ----------
+    UFUNCTION(BlueprintPure, Category = "Match")
+    ABallsack* GetBall() const { return Ball; }
+
+    const TArray<AFootballer*>& GetFootballers() const { return Footballers; }
+
+    /** Footballers with TeamID 0 or 1, in registration order. */
+    const TArray<AFootballer*>& GetRoster(int32 TeamID) const;
+
+    UFUNCTION(BlueprintPure, Category = "Match")
+    AFootballTeam* GetTeam(int32 TeamID) const { return (TeamID == 0 || TeamID == 1) ? Teams[TeamID] : nullptr; }
+
+    const TArray<AGoal*>& GetGoals() const { return Goals; }
+
+    // ---------- Change notifications ----------
+    FOnMatchBallChanged OnBallChanged;
+    FOnMatchRosterChanged OnRosterChanged;
+    FOnMatchGoalsChanged OnGoalsChanged;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void RebuildRosters() const;
+
+    /** Moves Player's roster entry to NewTeamID (INDEX_NONE = off the rosters) and notifies the teams involved. */
+    void SetRosterTeam(AFootballer* Player, int32 NewTeamID);
+
+    UPROPERTY() ABallsack* Ball = nullptr;
+    UPROPERTY() TArray<AFootballer*> Footballers;
+    UPROPERTY() AFootballTeam* Teams[2] = { nullptr, nullptr };
+    UPROPERTY() TArray<AGoal*> Goals;
+
+    // Team each registered footballer was last rostered under, to notify only real changes
+    TMap<TObjectKey<AFootballer>, int32> RosterTeams;
+
+    // Derived from Footballers on demand
+    mutable TArray<AFootballer*> Rosters[2];
+    mutable bool bRostersDirty = true;
+};
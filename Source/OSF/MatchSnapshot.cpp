@@ -0,0 +1,198 @@
+#include "MatchSnapshot.h"
+
+#include "Math/VectorRegister.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+#include "Footballer.h"
+
+void FMatchSnapshot::Build(const TArray<AFootballer*>& Team0, const TArray<AFootballer*>& Team1,
+                           const AActor* Ball, const FVector& FallbackBallLoc)
+{
+    Num = Team0.Num() + Team1.Num();
+    NumPadded = Align(Num, 4);
+
+    TeamBegin[0] = 0;           TeamEnd[0] = Team0.Num();
+    TeamBegin[1] = Team0.Num(); TeamEnd[1] = Num;
+
+    // SetNum keeps capacity between Thinks, so steady state does not allocate.
+    PosX.SetNumUninitialized(NumPadded); PosY.SetNumUninitialized(NumPadded); PosZ.SetNumUninitialized(NumPadded);
+    VelX.SetNumUninitialized(NumPadded); VelY.SetNumUninitialized(NumPadded); VelZ.SetNumUninitialized(NumPadded);
+    Team.SetNumUninitialized(NumPadded);
+    Slot.SetNumUninitialized(NumPadded);
+    Valid.SetNumUninitialized(NumPadded);
+    Human.SetNumUninitialized(NumPadded);
+    Players.SetNumUninitialized(NumPadded);
+    SetMovementColumns();
+
+    auto Fill = [this](int32 i, AFootballer* P, int32 TeamID, int32 SlotIdx)
+        {
+            Team[i] = static_cast<uint8>(TeamID);
+            Slot[i] = SlotIdx;
+            Players[i] = P;
+
+            if (IsValid(P))
+            {
+                const FVector L = P->GetActorLocation();
+                const FVector V = P->GetVelocity();
+                PosX[i] = L.X; PosY[i] = L.Y; PosZ[i] = L.Z;
+                VelX[i] = V.X; VelY[i] = V.Y; VelZ[i] = V.Z;
+                Valid[i] = 1;
+                Human[i] = (P->GetController() && P->GetController()->IsPlayerController()) ? 1 : 0;
+
+                const FVector F = P->GetActorForwardVector().GetSafeNormal2D();
+                FaceX[i] = F.X; FaceY[i] = F.Y;
+                if (const UCharacterMovementComponent* Move = P->GetCharacterMovement())
+                {
+                    MaxSpeed[i] = FMath::Max(Move->GetMaxSpeed(), 1.f);
+                    MaxAccel[i] = FMath::Max(Move->GetMaxAcceleration(), 1.f);
+                    TurnRate[i] = FMath::DegreesToRadians(FMath::Max(Move->RotationRate.Yaw, 1.f));
+                }
+            }
+            else
+            {
+                PosX[i] = FarSentinel; PosY[i] = FarSentinel; PosZ[i] = 0.f;
+                VelX[i] = 0.f; VelY[i] = 0.f; VelZ[i] = 0.f;
+                Valid[i] = 0;
+                Human[i] = 0;
+            }
+        };
+
+    for (int32 s = 0; s < Team0.Num(); ++s) Fill(TeamBegin[0] + s, Team0[s], 0, s);
+    for (int32 s = 0; s < Team1.Num(); ++s) Fill(TeamBegin[1] + s, Team1[s], 1, s);
+    for (int32 i = Num; i < NumPadded; ++i) Fill(i, nullptr, 0, INDEX_NONE);
+
+    bHasBall = Ball != nullptr;
+    BallPos = Ball ? Ball->GetActorLocation() : FallbackBallLoc;
+    BallVel = Ball ? Ball->GetVelocity() : FVector::ZeroVector;
+    BallAhead = BallPos;
+}
+
+void FMatchSnapshot::InitPoints(int32 NumTeam0, int32 NumTeam1)
+{
+    Num = NumTeam0 + NumTeam1;
+    NumPadded = Align(Num, 4);
+
+    TeamBegin[0] = 0;        TeamEnd[0] = NumTeam0;
+    TeamBegin[1] = NumTeam0; TeamEnd[1] = Num;
+
+    PosX.SetNumUninitialized(NumPadded); PosY.SetNumUninitialized(NumPadded); PosZ.SetNumUninitialized(NumPadded);
+    VelX.SetNumUninitialized(NumPadded); VelY.SetNumUninitialized(NumPadded); VelZ.SetNumUninitialized(NumPadded);
+    Team.SetNumUninitialized(NumPadded);
+    Slot.SetNumUninitialized(NumPadded);
+    Valid.SetNumUninitialized(NumPadded);
+    Human.SetNumUninitialized(NumPadded);
+    Players.SetNumUninitialized(NumPadded);
+    SetMovementColumns();
+
+    for (int32 i = 0; i < NumPadded; ++i)
+    {
+        const bool bReal = i < Num;
+        const int32 TeamID = (i >= NumTeam0 && bReal) ? 1 : 0;
+        const float P = bReal ? 0.f : FarSentinel;
+        PosX[i] = P; PosY[i] = P; PosZ[i] = 0.f;
+        VelX[i] = 0.f; VelY[i] = 0.f; VelZ[i] = 0.f;
+        Team[i] = static_cast<uint8>(TeamID);
+        Slot[i] = bReal ? i - TeamBegin[TeamID] : INDEX_NONE;
+        Valid[i] = bReal ? 1 : 0;
+        Human[i] = 0;
+        Players[i] = nullptr;
+    }
+
+    bHasBall = true;
+    BallPos = BallVel = BallAhead = FVector::ZeroVector;
+}
+
+void FMatchSnapshot::SetMovementColumns()
+{
+    // Defaults every lane can divide by; Build overwrites them for real players
+    MaxSpeed.Init(600.f, NumPadded);
+    MaxAccel.Init(2048.f, NumPadded);
+    TurnRate.Init(FMath::DegreesToRadians(720.f), NumPadded);
+    FaceX.Init(1.f, NumPadded);
+    FaceY.Init(0.f, NumPadded);
+
+    InterceptT.Init(TNumericLimits<float>::Max(), NumPadded);
+    InterceptX.Init(0.f, NumPadded);
+    InterceptY.Init(0.f, NumPadded);
+    InterceptOrder.SetNumUninitialized(NumPadded);
+    for (int32 i = 0; i < NumPadded; ++i) InterceptOrder[i] = i;
+    bHasIntercepts = false;
+}
+
+int32 FMatchSnapshot::Find(const AFootballer* P) const
+{
+    if (!P) return INDEX_NONE;
+    for (int32 i = 0; i < Num; ++i)
+    {
+        if (Players[i] == P) return i;
+    }
+    return INDEX_NONE;
+}
+
+// ---------------- Kernels ----------------
+void FMatchSnapshot::DistSq2D(int32 Begin, int32 End, const FVector& Pt, float* Out) const
+{
+    const int32 A0 = Begin & ~3;
+    const float* RESTRICT Xs = PosX.GetData();
+    const float* RESTRICT Ys = PosY.GetData();
+
+    const VectorRegister4Float Px = VectorSetFloat1(static_cast<float>(Pt.X));
+    const VectorRegister4Float Py = VectorSetFloat1(static_cast<float>(Pt.Y));
+
+    for (int32 i = A0; i < End; i += 4)
+    {
+        const VectorRegister4Float Dx = VectorSubtract(VectorLoad(Xs + i), Px);
+        const VectorRegister4Float Dy = VectorSubtract(VectorLoad(Ys + i), Py);
+        VectorStore(VectorMultiplyAdd(Dx, Dx, VectorMultiply(Dy, Dy)), Out + (i - A0));
+    }
+}
+
+int32 FMatchSnapshot::Nearest(int32 Begin, int32 End, const FVector& Pt, const uint8* Exclude, float* OutDistSq) const
+{
+    if (Begin >= End) return INDEX_NONE;
+
+    const int32 A0 = Begin & ~3;
+    FSnapshotScratch D2;
+    D2.SetNumUninitialized(Align(End - A0, 4));
+    DistSq2D(Begin, End, Pt, D2.GetData());
+
+    int32 Best = INDEX_NONE; float BestD = TNumericLimits<float>::Max();
+    for (int32 i = Begin; i < End; ++i)
+    {
+        if (!Valid[i] || (Exclude && Exclude[i])) continue;
+        const float D = D2[i - A0];
+        if (D < BestD) { BestD = D; Best = i; }
+    }
+    if (OutDistSq) *OutDistSq = BestD;
+    return Best;
+}
+
+int32 FMatchSnapshot::KNearest(int32 Begin, int32 End, const FVector& Pt, int32 K, int32* OutIdx, const uint8* Exclude) const
+{
+    if (Begin >= End || K <= 0) return 0;
+
+    const int32 A0 = Begin & ~3;
+    FSnapshotScratch D2;
+    D2.SetNumUninitialized(Align(End - A0, 4));
+    DistSq2D(Begin, End, Pt, D2.GetData());
+
+    // K is tiny (chasers, support), so an insertion list beats a heap.
+    int32 Count = 0;
+    for (int32 i = Begin; i < End; ++i)
+    {
+        if (!Valid[i] || (Exclude && Exclude[i])) continue;
+        const float D = D2[i - A0];
+
+        int32 Pos = Count;
+        while (Pos > 0 && D2[OutIdx[Pos - 1] - A0] > D) --Pos;
+        if (Pos >= K) continue;
+
+        const int32 Last = FMath::Min(Count, K - 1);
+        for (int32 j = Last; j > Pos; --j) OutIdx[j] = OutIdx[j - 1];
+        OutIdx[Pos] = i;
+        Count = FMath::Min(Count + 1, K);
+    }
+    return Count;
+}
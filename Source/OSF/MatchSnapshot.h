@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class AFootballer;
+
+/**
+ * Packed per-Think copy of the match state the team AI reads.
+ * Built once at the start of ADefaultGameMode::Think so the decision code never
+ * chases AActor/USceneComponent pointers for positions.
+ *
+ * Layout: team 0 players first (slot order), then team 1 (slot order).
+ * Float arrays are padded to a multiple of 4 so the proximity kernels always
+ * run in full 4-wide lanes; padding and invalid players sit at a far sentinel.
+ */
+struct OSF_API FMatchSnapshot
+{
+    // ---------- Per-player columns ----------
+    TArray<float> PosX, PosY, PosZ;
+    TArray<float> VelX, VelY, VelZ;
+    TArray<uint8> Team;
+    TArray<int32> Slot;
+    TArray<uint8> Valid;
+    TArray<uint8> Human;   // possessed by a PlayerController
+    TArray<AFootballer*> Players;
+
+    // Movement limits and heading, for the intercept solver
+    TArray<float> MaxSpeed, MaxAccel; // cm/s, cm/s^2
+    TArray<float> TurnRate;           // rad/s
+    TArray<float> FaceX, FaceY;       // unit XY heading
+
+    // ---------- Intercepts (FInterceptSolver::Solve) ----------
+    TArray<float> InterceptT;         // seconds from now until the player can play the ball
+    TArray<float> InterceptX, InterceptY;
+    TArray<int32> InterceptOrder;     // per team, [TeamBegin, TeamEnd): snapshot indices, earliest first
+    bool bHasIntercepts = false;
+
+    int32 TeamBegin[2] = { 0, 0 };
+    int32 TeamEnd[2] = { 0, 0 };
+
+    int32 Num = 0;        // real entries
+    int32 NumPadded = 0;  // Num rounded up to 4
+
+    // ---------- Ball ----------
+    FVector BallPos = FVector::ZeroVector;
+    FVector BallVel = FVector::ZeroVector;
+    FVector BallAhead = FVector::ZeroVector; // predicted ball position FTacticParams::BallLeadTime ahead; BallPos if none
+    bool    bHasBall = false;
+
+    /** Far-away XY for padding/invalid lanes; squared distances stay finite. */
+    static constexpr float FarSentinel = 1.0e8f;
+
+    void Build(const TArray<AFootballer*>& Team0, const TArray<AFootballer*>& Team1,
+               const AActor* Ball, const FVector& FallbackBallLoc);
+
+    /**
+     * Actor-free layout for the offline simulator: NumTeam0 + NumTeam1 valid entries
+     * with null Players and zeroed columns; the caller writes positions, velocities and ball
+     * (and movement limits if intercepts are wanted).
+     */
+    void InitPoints(int32 NumTeam0, int32 NumTeam1);
+
+    FORCEINLINE int32 IndexOf(int32 TeamID, int32 SlotIdx) const { return TeamBegin[TeamID] + SlotIdx; }
+    FORCEINLINE bool  IsValidEntry(int32 i) const { return i >= 0 && i < Num && Valid[i] != 0; }
+
+    FORCEINLINE FVector GetPos(int32 i) const { return FVector(PosX[i], PosY[i], PosZ[i]); }
+    FORCEINLINE FVector GetVel(int32 i) const { return FVector(VelX[i], VelY[i], VelZ[i]); }
+
+    /** Team's r-th fastest player to the ball, or INDEX_NONE without intercepts. */
+    FORCEINLINE int32 Interceptor(int32 TeamID, int32 Rank) const
+    {
+        const int32 i = TeamBegin[TeamID] + Rank;
+        return (bHasIntercepts && i < TeamEnd[TeamID] && Valid[InterceptOrder[i]]) ? InterceptOrder[i] : INDEX_NONE;
+    }
+
+    /** Resets the movement and intercept columns to defaults for NumPadded lanes. */
+    void SetMovementColumns();
+
+    /** Snapshot index of P, or INDEX_NONE. */
+    int32 Find(const AFootballer* P) const;
+
+    // ---------- Proximity kernels (2D, XY) ----------
+
+    /**
+     * Squared XY distance from Pt for every entry in [Begin, End), four lanes at a time.
+     * Out[k] holds entry (Begin & ~3) + k; caller sizes Out to at least End - (Begin & ~3) rounded up to 4.
+     */
+    void DistSq2D(int32 Begin, int32 End, const FVector& Pt, float* Out) const;
+
+    /** Nearest valid entry in [Begin, End) not flagged in Exclude (indexed by snapshot index, may be null). */
+    int32 Nearest(int32 Begin, int32 End, const FVector& Pt, const uint8* Exclude = nullptr, float* OutDistSq = nullptr) const;
+
+    /** Up to K nearest valid entries in [Begin, End), closest first. Returns count written. */
+    int32 KNearest(int32 Begin, int32 End, const FVector& Pt, int32 K, int32* OutIdx, const uint8* Exclude = nullptr) const;
+
+    /** Valid entries in [Begin, End) strictly inside Radius (XY), skipping SkipIdx. Returns count appended. */
+    template<typename AllocatorType>
+    int32 WithinRadius(int32 Begin, int32 End, const FVector& Pt, float Radius, int32 SkipIdx, TArray<int32, AllocatorType>& Out) const;
+};
+
+/** Scratch sized for the kernels above; stays on the stack up to 256 players. */
+using FSnapshotScratch = TArray<float, TInlineAllocator<256>>;
+
+template<typename AllocatorType>
+int32 FMatchSnapshot::WithinRadius(int32 Begin, int32 End, const FVector& Pt, float Radius, int32 SkipIdx, TArray<int32, AllocatorType>& Out) const
+{
+    if (Begin >= End) return 0;
+
+    const int32 A0 = Begin & ~3;
+    FSnapshotScratch D2;
+    D2.SetNumUninitialized(Align(End - A0, 4));
+    DistSq2D(Begin, End, Pt, D2.GetData());
+
+    const float R2 = Radius * Radius;
+    int32 Added = 0;
+    for (int32 i = Begin; i < End; ++i)
+    {
+        if (i == SkipIdx || !Valid[i]) continue;
+        if (D2[i - A0] < R2) { Out.Add(i); ++Added; }
+    }
+    return Added;
+}
@@ -0,0 +1,139 @@
+#include "MatchTickSubsystem.h"
+
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+
+#include "OSFStats.h"
+
+UMatchTickSubsystem* UMatchTickSubsystem::Get(const UObject* WorldContext)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UMatchTickSubsystem>() : nullptr;
+}
+
+bool UMatchTickSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMatchTickSubsystem::Deinitialize()
+{
+    for (FGroup& G : Groups)
+    {
+        if (G.Function && G.Function->IsTickFunctionRegistered()) G.Function->UnRegisterTickFunction();
+        G.Function.Reset();
+        G.Entries.Reset();
+    }
+    Super::Deinitialize();
+}
+
+// ---------------- Registration ----------------
+void UMatchTickSubsystem::Register(UObject* Owner, IMatchBatchTickable* Tickable, ETickingGroup Group)
+{
+    if (!Owner || !Tickable || Group >= TG_MAX) return;
+
+    for (const FGroup& G : Groups)
+    {
+        if (G.Entries.ContainsByPredicate([Tickable](const FEntry& E) { return E.Tickable == Tickable; })) return;
+    }
+
+    FGroup& G = Groups[Group];
+    G.Entries.Add({ Owner, Tickable });
+
+    // The group's tick function exists only once something uses the group
+    if (!G.Function)
+    {
+        G.Function = MakeUnique<FMatchBatchTickFunction>();
+        G.Function->Owner = this;
+        G.Function->TickGroup = Group;
+        G.Function->EndTickGroup = Group;
+        G.Function->bCanEverTick = true;
+        G.Function->bStartWithTickEnabled = true;
+    }
+    if (!G.Function->IsTickFunctionRegistered())
+    {
+        if (ULevel* Level = GetWorld() ? GetWorld()->PersistentLevel : nullptr) G.Function->RegisterTickFunction(Level);
+    }
+}
+
+void UMatchTickSubsystem::Unregister(IMatchBatchTickable* Tickable)
+{
+    if (!Tickable) return;
+
+    for (FGroup& G : Groups)
+    {
+        const int32 Idx = G.Entries.IndexOfByPredicate([Tickable](const FEntry& E) { return E.Tickable == Tickable; });
+        if (Idx == INDEX_NONE) continue;
+
+        if (G.bTicking)
+        {
+            G.Entries[Idx].Tickable = nullptr;
+            G.bNeedsCompact = true;
+        }
+        else
+        {
+            G.Entries.RemoveAtSwap(Idx);
+        }
+        return;
+    }
+}
+
+int32 UMatchTickSubsystem::GetNumRegistered() const
+{
+    int32 N = 0;
+    for (const FGroup& G : Groups) N += G.Entries.Num();
+    return N;
+}
+
+// ---------------- Ticking ----------------
+void UMatchTickSubsystem::RunGroup(ETickingGroup Group, float DeltaSeconds)
+{
+    OSF_SCOPE(BatchTick);
+
+    FGroup& G = Groups[Group];
+    G.bTicking = true;
+
+    // Index loop: entries registered from inside a BatchTick may grow the array
+    int32 Ran = 0;
+    for (int32 i = 0; i < G.Entries.Num(); ++i)
+    {
+        const FEntry& E = G.Entries[i];
+        if (!E.Tickable) continue;
+        if (!E.Owner.IsValid())
+        {
+            G.Entries[i].Tickable = nullptr;
+            G.bNeedsCompact = true;
+            continue;
+        }
+        E.Tickable->BatchTick(DeltaSeconds);
+        ++Ran;
+    }
+
+    G.bTicking = false;
+    if (G.bNeedsCompact)
+    {
+        G.Entries.RemoveAllSwap([](const FEntry& E) { return E.Tickable == nullptr; });
+        G.bNeedsCompact = false;
+    }
+
+    // Unbatched, each entry would have been a tick function of its own
+    INC_DWORD_STAT_BY(STAT_OSF_TickFunctionsUnbatched, Ran);
+    INC_DWORD_STAT(STAT_OSF_TickFunctionsBatched);
+}
+
+void FMatchBatchTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                          const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Owner && TickType != LEVELTICK_ViewportsOnly) Owner->RunGroup(TickGroup, DeltaTime);
+}
+
+FString FMatchBatchTickFunction::DiagnosticMessage()
+{
+    return FString::Printf(TEXT("UMatchTickSubsystem[%s]"), *UEnum::GetValueAsString(TickGroup.GetValue()));
+}
+
+FName FMatchBatchTickFunction::DiagnosticContext(bool bDetailed)
+{
+    return FName(TEXT("MatchBatchTick"));
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MatchTickSubsystem.generated.h"
+
+class UMatchTickSubsystem;
+
+/** Per-frame work run from a shared batch tick instead of an own tick function. */
+class OSF_API IMatchBatchTickable
+{
+public:
+    virtual ~IMatchBatchTickable() = default;
+    virtual void BatchTick(float DeltaSeconds) = 0;
+};
+
+/** One of these per tick group in use; runs every entry of that group. */
+struct FMatchBatchTickFunction : public FTickFunction
+{
+    UMatchTickSubsystem* Owner = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                             const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+    virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+/**
+ * Batched ticking for the per-player match objects.
+ *
+ * With 22 players and their controllers, one tick function each costs more in
+ * tick task manager dispatch than the work they do. Objects that need a
+ * per-frame update instead register here for a tick group; each group in use
+ * gets a single tick function that walks a contiguous entry list in one pass.
+ * Objects with nothing to do per frame should not tick at all (`dumpticks`
+ * lists what is left).
+ */
+UCLASS()
+class OSF_API UMatchTickSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Tick manager of WorldContext's world, or null (no world, or not a game/PIE world). */
+    static UMatchTickSubsystem* Get(const UObject* WorldContext);
+
+    /** Owner is checked for validity before each call; register from BeginPlay, unregister from EndPlay. */
+    void Register(UObject* Owner, IMatchBatchTickable* Tickable, ETickingGroup Group = TG_PrePhysics);
+    void Unregister(IMatchBatchTickable* Tickable);
+
+    int32 GetNumRegistered() const;
+
+    virtual void Deinitialize() override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    friend struct FMatchBatchTickFunction;
+
+    struct FEntry
+    {
+        TWeakObjectPtr<UObject> Owner;
+        IMatchBatchTickable* Tickable = nullptr; // null: removed while ticking, compacted after the pass
+    };
+
+    struct FGroup
+    {
+        TArray<FEntry> Entries;
+        TUniquePtr<FMatchBatchTickFunction> Function;
+        bool bTicking = false;
+        bool bNeedsCompact = false;
+    };
+
+    void RunGroup(ETickingGroup Group, float DeltaSeconds);
+
+    FGroup Groups[TG_MAX];
+};
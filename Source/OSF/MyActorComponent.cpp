@@ -2,7 +2,7 @@
 
 UMyActorComponent::UMyActorComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 void UMyActorComponent::BeginPlay()
@@ -10,7 +10,3 @@ void UMyActorComponent::BeginPlay()
 	Super::BeginPlay();
 }
 
-void UMyActorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-}
@@ -2,7 +2,7 @@
 
 UNewActorComponent::UNewActorComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 void UNewActorComponent::BeginPlay()
@@ -10,7 +10,3 @@ void UNewActorComponent::BeginPlay()
 	Super::BeginPlay();
 }
 
-void UNewActorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-}
@@ -14,7 +14,7 @@ public class OSF : ModuleRules
 
         PrivateDependencyModuleNames.AddRange(new string[]
         {
-            "Slate", "SlateCore"
+            "Slate", "SlateCore", "Json", "PhysicsCore"
         });
     }
 }
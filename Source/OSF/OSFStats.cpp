@@ -0,0 +1,43 @@
+#include "OSFStats.h"
+
+CSV_DEFINE_CATEGORY_MODULE(OSF_API, OSF, true);
+
+UE_TRACE_CHANNEL_DEFINE(OSFChannel);
+
+DEFINE_STAT(STAT_OSF_Think);
+DEFINE_STAT(STAT_OSF_PlanTeam);
+DEFINE_STAT(STAT_OSF_DecidePlayers);
+DEFINE_STAT(STAT_OSF_DecidePlayer);
+DEFINE_STAT(STAT_OSF_ApplyIntent);
+DEFINE_STAT(STAT_OSF_PathFlush);
+DEFINE_STAT(STAT_OSF_UpdatePossession);
+DEFINE_STAT(STAT_OSF_FindBallActor);
+DEFINE_STAT(STAT_OSF_CacheRefs);
+DEFINE_STAT(STAT_OSF_IsLocationInGoal);
+DEFINE_STAT(STAT_OSF_BatchTick);
+DEFINE_STAT(STAT_OSF_PitchRules);
+DEFINE_STAT(STAT_OSF_BallFlight);
+DEFINE_STAT(STAT_OSF_BallPrediction);
+DEFINE_STAT(STAT_OSF_Intercept);
+DEFINE_STAT(STAT_OSF_PassEval);
+DEFINE_STAT(STAT_OSF_ShotEval);
+DEFINE_STAT(STAT_OSF_KickSolve);
+DEFINE_STAT(STAT_OSF_PitchControl);
+DEFINE_STAT(STAT_OSF_ReplayRecord);
+
+DEFINE_STAT(STAT_OSF_AIPlayersUpdated);
+DEFINE_STAT(STAT_OSF_AIPlayersDeferred);
+DEFINE_STAT(STAT_OSF_AICostMaxMicros);
+DEFINE_STAT(STAT_OSF_PitchControlCells);
+DEFINE_STAT(STAT_OSF_PitchControlMicros);
+
+DEFINE_STAT(STAT_OSF_TickFunctionsUnbatched);
+DEFINE_STAT(STAT_OSF_TickFunctionsBatched);
+
+DEFINE_STAT(STAT_OSF_BallPredictionSamples);
+
+DEFINE_STAT(STAT_OSF_GroundTraces);
+DEFINE_STAT(STAT_OSF_MoveRequests);
+DEFINE_STAT(STAT_OSF_PathQueries);
+
+DEFINE_STAT(STAT_OSF_PossessionChanges);
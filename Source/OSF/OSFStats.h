@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+// `stat OSF` in any console (including a dedicated server)
+DECLARE_STATS_GROUP(TEXT("OSF"), STATGROUP_OSF, STATCAT_Advanced);
+
+// `-csvprofile` / csvprofile start: per-frame timings of the match hot paths
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(OSF_API, OSF);
+
+// Insights: `-trace=cpu,OSF` (or `trace.enable OSF`) for the scopes below
+UE_TRACE_CHANNEL_EXTERN(OSFChannel, OSF_API);
+
+/** Cycle stat STAT_OSF_<Name> plus a CPU trace scope of the same name on OSFChannel. */
+#define OSF_SCOPE(Name) \
+    SCOPE_CYCLE_COUNTER(STAT_OSF_##Name); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(OSF_##Name, OSFChannel)
+
+// ---------- Cycles ----------
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Think"), STAT_OSF_Think, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Plan team"), STAT_OSF_PlanTeam, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Decide players"), STAT_OSF_DecidePlayers, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Decide player"), STAT_OSF_DecidePlayer, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply intent"), STAT_OSF_ApplyIntent, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Path flush"), STAT_OSF_PathFlush, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update possession"), STAT_OSF_UpdatePossession, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Find ball actor"), STAT_OSF_FindBallActor, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cache refs"), STAT_OSF_CacheRefs, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Is location in goal"), STAT_OSF_IsLocationInGoal, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batch tick"), STAT_OSF_BatchTick, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pitch rules"), STAT_OSF_PitchRules, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball flight"), STAT_OSF_BallFlight, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball prediction"), STAT_OSF_BallPrediction, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Intercept solve"), STAT_OSF_Intercept, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pass evaluation"), STAT_OSF_PassEval, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Shot evaluation"), STAT_OSF_ShotEval, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Kick solve"), STAT_OSF_KickSolve, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pitch control"), STAT_OSF_PitchControl, STATGROUP_OSF, OSF_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Replay record"), STAT_OSF_ReplayRecord, STATGROUP_OSF, OSF_API);
+
+// ---------- AI scheduling ----------
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("AI players updated / frame"), STAT_OSF_AIPlayersUpdated, STATGROUP_OSF, OSF_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("AI players deferred / frame"), STAT_OSF_AIPlayersDeferred, STATGROUP_OSF, OSF_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("AI cost, slowest player (us)"), STAT_OSF_AICostMaxMicros, STATGROUP_OSF, OSF_API);
+
+// Pitch control updates with the team plan, not every frame: these hold the last update
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pitch control cells, last update"), STAT_OSF_PitchControlCells, STATGROUP_OSF, OSF_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Pitch control last update (us)"), STAT_OSF_PitchControlMicros, STATGROUP_OSF, OSF_API);
+
+// ---------- Ticking ----------
+// Unbatched: what the batched objects would dispatch with a tick function each; batched: what is dispatched
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tick functions / frame, unbatched"), STAT_OSF_TickFunctionsUnbatched, STATGROUP_OSF, OSF_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tick functions / frame, batched"), STAT_OSF_TickFunctionsBatched, STATGROUP_OSF, OSF_API);
+
+// ---------- Ball ----------
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ball prediction samples / frame"), STAT_OSF_BallPredictionSamples, STATGROUP_OSF, OSF_API);
+
+// ---------- World queries ----------
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground traces / frame"), STAT_OSF_GroundTraces, STATGROUP_OSF, OSF_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("MoveTo requests / frame"), STAT_OSF_MoveRequests, STATGROUP_OSF, OSF_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path queries / frame"), STAT_OSF_PathQueries, STATGROUP_OSF, OSF_API);
+
+// ---------- Match ----------
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Possession changes"), STAT_OSF_PossessionChanges, STATGROUP_OSF, OSF_API);
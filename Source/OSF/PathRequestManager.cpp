@@ -0,0 +1,187 @@
+#include "PathRequestManager.h"
+
+#include "AIController.h"
+#include "AITypes.h"
+#include "NavigationSystem.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Engine/World.h"
+
+#include "OSFStats.h"
+
+void FPathRequestManager::Request(AAIController* AIC, const FVector& Goal, float AcceptanceRadius)
+{
+    if (!AIC) return;
+    ++NumRequested;
+    INC_DWORD_STAT(STAT_OSF_MoveRequests);
+
+    // Same goal as the move we are already on (or waiting for)?
+    if (const FActiveMove* Move = Active.Find(AIC))
+    {
+        if (FVector::DistSquared2D(Move->Goal, Goal) <= FMath::Square(GoalTolerance))
+        {
+            const bool bInFlight = Move->QueryId != 0;
+            const UPathFollowingComponent* PFC = AIC->GetPathFollowingComponent();
+            const bool bFollowing = PFC && PFC->GetStatus() == EPathFollowingStatus::Moving
+                && PFC->GetPath().IsValid() && PFC->GetPath()->IsValid();
+
+            if (bInFlight || bFollowing)
+            {
+                ++NumSuppressed;
+                return;
+            }
+        }
+    }
+
+    // Already there: nothing to path, but a move toward an older goal must not carry the pawn away
+    if (const APawn* Pawn = AIC->GetPawn())
+    {
+        if (FVector::DistSquared2D(Pawn->GetActorLocation(), Goal) <= FMath::Square(AcceptanceRadius))
+        {
+            Cancel(AIC);
+            ++NumSuppressed;
+            return;
+        }
+    }
+
+    // Coalesce: last request per controller wins
+    for (FPending& P : Pending)
+    {
+        if (P.Controller.Get() == AIC)
+        {
+            P.Goal = Goal;
+            P.AcceptanceRadius = AcceptanceRadius;
+            ++NumSuppressed;
+            return;
+        }
+    }
+    Pending.Add({ AIC, Goal, AcceptanceRadius });
+}
+
+void FPathRequestManager::Flush(UWorld* World)
+{
+    OSF_SCOPE(PathFlush);
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+
+    for (const FPending& P : Pending)
+    {
+        AAIController* AIC = P.Controller.Get();
+        if (!AIC || !AIC->GetPawn()) continue;
+
+        const FNavAgentProperties& Agent = AIC->GetNavAgentPropertiesRef();
+        const ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(Agent, AIC->GetNavAgentLocation()) : nullptr;
+        if (!NavData)
+        {
+            ++NumFailed;
+            continue;
+        }
+
+        FVector Goal = P.Goal;
+        FNavLocation Projected;
+        if (NavSys->ProjectPointToNavigation(Goal, Projected, INVALID_NAVEXTENT, NavData))
+        {
+            Goal = Projected.Location;
+        }
+
+        FPathFindingQuery Query(AIC, *NavData, AIC->GetNavAgentLocation(), Goal,
+            UNavigationQueryFilter::GetQueryFilter(*NavData, AIC, AIC->GetDefaultNavigationFilterClass()));
+        Query.SetAllowPartialPaths(true);
+
+        const uint32 QueryId = NavSys->FindPathAsync(Agent, Query,
+            FNavPathQueryDelegate::CreateWeakLambda(Owner.Get(),
+                [this](uint32 Id, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+                {
+                    OnPathFound(Id, Result, Path);
+                }));
+
+        if (QueryId == INVALID_NAVQUERYID)
+        {
+            ++NumFailed;
+            continue;
+        }
+
+        FActiveMove& Move = Active.FindOrAdd(AIC);
+        if (Move.QueryId != 0)
+        {
+            // Superseded: the old result will be ignored when it lands
+            QueryOwners.Remove(Move.QueryId);
+            --NumInFlight;
+        }
+        Move.Controller = AIC;
+        Move.Goal = P.Goal;
+        Move.AcceptanceRadius = P.AcceptanceRadius;
+        Move.QueryId = QueryId;
+        QueryOwners.Add(QueryId, AIC);
+
+        ++NumIssued;
+        INC_DWORD_STAT(STAT_OSF_PathQueries);
+        ++NumInFlight;
+    }
+    Pending.Reset();
+
+    // Drop controllers that went away (possession swaps respawn AI controllers)
+    for (auto It = Active.CreateIterator(); It; ++It)
+    {
+        if (!It->Value.Controller.IsValid())
+        {
+            if (It->Value.QueryId != 0) { QueryOwners.Remove(It->Value.QueryId); --NumInFlight; }
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FPathRequestManager::OnPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+    TObjectKey<AAIController> Key;
+    if (!QueryOwners.RemoveAndCopyValue(QueryId, Key)) return; // superseded
+    --NumInFlight;
+
+    FActiveMove* Move = Active.Find(Key);
+    if (!Move) return;
+    Move->QueryId = 0;
+
+    AAIController* AIC = Move->Controller.Get();
+    if (!AIC || Result != ENavigationQueryResult::Success || !Path.IsValid())
+    {
+        ++NumFailed;
+        return;
+    }
+
+    FAIMoveRequest MoveReq(Move->Goal);
+    MoveReq.SetAcceptanceRadius(Move->AcceptanceRadius);
+    MoveReq.SetReachTestIncludesAgentRadius(true);
+    MoveReq.SetUsePathfinding(true);
+    MoveReq.SetAllowPartialPath(true);
+    MoveReq.SetCanStrafe(false);
+
+    Path->EnableRecalculationOnInvalidation(true);
+    AIC->RequestMove(MoveReq, Path);
+    ++NumCompleted;
+}
+
+void FPathRequestManager::Cancel(AAIController* AIC)
+{
+    Pending.RemoveAll([AIC](const FPending& P) { return P.Controller.Get() == AIC; });
+
+    FActiveMove Move;
+    if (!Active.RemoveAndCopyValue(AIC, Move)) return;
+    if (Move.QueryId != 0)
+    {
+        QueryOwners.Remove(Move.QueryId);
+        --NumInFlight;
+    }
+
+    const UPathFollowingComponent* PFC = AIC->GetPathFollowingComponent();
+    if (PFC && PFC->GetStatus() != EPathFollowingStatus::Idle)
+    {
+        AIC->StopMovement();
+    }
+}
+
+void FPathRequestManager::Reset()
+{
+    Active.Reset();
+    QueryOwners.Reset();
+    Pending.Reset();
+    NumInFlight = 0;
+}
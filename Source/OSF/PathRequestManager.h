@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "NavigationSystemTypes.h"
+#include "NavigationData.h"
+
+class AAIController;
+class UWorld;
+
+/**
+ * Collects the MoveTo requests made during a Think and turns them into as few
+ * navmesh queries as possible:
+ *  - a goal within GoalTolerance of the controller's active goal is suppressed
+ *    while that path is in flight or still being followed;
+ *  - a goal the pawn already stands on is suppressed, and any move or query
+ *    toward an older goal is cancelled;
+ *  - everything else is submitted together on Flush as async FindPathAsync
+ *    queries; results are handed to the controller with RequestMove.
+ */
+struct OSF_API FPathRequestManager
+{
+    /** Re-path only when the goal moves further than this (cm, 2D). */
+    float GoalTolerance = 120.f;
+
+    /** Owner used to scope the async callbacks (usually the game mode). */
+    void Init(UObject* InOwner) { Owner = InOwner; }
+
+    /** Queue a move; coalesced per controller until Flush. */
+    void Request(AAIController* AIC, const FVector& Goal, float AcceptanceRadius);
+
+    /** Submit everything queued since the last Flush. */
+    void Flush(UWorld* World);
+
+    void Reset();
+
+    // ---------- Counters (cumulative) ----------
+    int32 NumRequested = 0;   // Request() calls
+    int32 NumSuppressed = 0;  // dropped: same goal / already there
+    int32 NumIssued = 0;      // async queries submitted
+    int32 NumCompleted = 0;   // paths handed to controllers
+    int32 NumFailed = 0;      // query failed or no nav data
+    int32 NumInFlight = 0;
+
+private:
+    struct FActiveMove
+    {
+        TWeakObjectPtr<AAIController> Controller;
+        FVector Goal = FVector::ZeroVector;
+        float   AcceptanceRadius = 0.f;
+        uint32  QueryId = 0;    // non-zero while a query is in flight
+    };
+
+    struct FPending
+    {
+        TWeakObjectPtr<AAIController> Controller;
+        FVector Goal;
+        float   AcceptanceRadius;
+    };
+
+    void OnPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+    /** Drops AIC's pending request and in-flight query, and stops the move it is following. */
+    void Cancel(AAIController* AIC);
+
+    TWeakObjectPtr<UObject> Owner;
+    TMap<TObjectKey<AAIController>, FActiveMove> Active;
+    TMap<uint32, TObjectKey<AAIController>> QueryOwners;
+    TArray<FPending> Pending;
+};
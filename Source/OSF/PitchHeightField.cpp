@@ -0,0 +1,88 @@
+#include "PitchHeightField.h"
+
+#include "Engine/World.h"
+#include "CollisionQueryParams.h"
+
+void FPitchHeightField::Build(UWorld* World, const FVector& Centre, float HalfLength, float HalfWidth, float InSpacing,
+                              float TraceUp, float TraceDown, ECollisionChannel Channel, const AActor* IgnoreActor)
+{
+    Reset();
+    if (!World || InSpacing <= KINDA_SMALL_NUMBER) return;
+
+    Spacing = InSpacing;
+    InvSpacing = 1.f / InSpacing;
+
+    // One extra cell each side so clamped field points never land on the border.
+    const float ExtX = HalfLength + Spacing;
+    const float ExtY = HalfWidth + Spacing;
+    NumX = FMath::CeilToInt(2.f * ExtX * InvSpacing) + 1;
+    NumY = FMath::CeilToInt(2.f * ExtY * InvSpacing) + 1;
+    Origin = FVector2D(Centre.X - ExtX, Centre.Y - ExtY);
+
+    Heights.SetNumUninitialized(NumX * NumY);
+
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(PitchHeightFieldBuild), false);
+    Params.bReturnPhysicalMaterial = false;
+    if (IgnoreActor) Params.AddIgnoredActor(IgnoreActor);
+
+    for (int32 IY = 0; IY < NumY; ++IY)
+    {
+        const float Y = Origin.Y + IY * Spacing;
+        for (int32 IX = 0; IX < NumX; ++IX)
+        {
+            const float X = Origin.X + IX * Spacing;
+            const FVector Start(X, Y, Centre.Z + TraceUp);
+            const FVector End(X, Y, Centre.Z - TraceDown);
+
+            FHitResult Hit;
+            const bool bHit = World->LineTraceSingleByChannel(Hit, Start, End, Channel, Params);
+            Heights[IY * NumX + IX] = bHit ? Hit.Location.Z : Centre.Z;
+        }
+    }
+}
+
+void FPitchHeightField::Reset()
+{
+    Heights.Reset();
+    NumX = NumY = 0;
+    Spacing = InvSpacing = 0.f;
+}
+
+bool FPitchHeightField::Contains(float X, float Y) const
+{
+    if (!IsBuilt()) return false;
+    const float FX = (X - Origin.X) * InvSpacing;
+    const float FY = (Y - Origin.Y) * InvSpacing;
+    return FX >= 0.f && FY >= 0.f && FX <= float(NumX - 1) && FY <= float(NumY - 1);
+}
+
+bool FPitchHeightField::Sample(float X, float Y, float& OutZ, FVector* OutNormal) const
+{
+    if (!Contains(X, Y)) return false;
+
+    const float FX = (X - Origin.X) * InvSpacing;
+    const float FY = (Y - Origin.Y) * InvSpacing;
+
+    const int32 IX = FMath::Min(FMath::FloorToInt(FX), NumX - 2);
+    const int32 IY = FMath::Min(FMath::FloorToInt(FY), NumY - 2);
+    const float TX = FX - IX;
+    const float TY = FY - IY;
+
+    const float Z00 = At(IX, IY);
+    const float Z10 = At(IX + 1, IY);
+    const float Z01 = At(IX, IY + 1);
+    const float Z11 = At(IX + 1, IY + 1);
+
+    const float Z0 = FMath::Lerp(Z00, Z10, TX);
+    const float Z1 = FMath::Lerp(Z01, Z11, TX);
+    OutZ = FMath::Lerp(Z0, Z1, TY);
+
+    if (OutNormal)
+    {
+        // Analytic gradient of the bilinear patch
+        const float DZDX = FMath::Lerp(Z10 - Z00, Z11 - Z01, TY) * InvSpacing;
+        const float DZDY = (Z1 - Z0) * InvSpacing;
+        *OutNormal = FVector(-DZDX, -DZDY, 1.f).GetSafeNormal();
+    }
+    return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UWorld;
+class AActor;
+
+/**
+ * Ground heights sampled once on a regular XY grid over the pitch.
+ * Replaces per-call line traces for grounding; lookups are bilinear.
+ * Points the build trace missed store Centre.Z, as a missed live trace returns the pitch centre's height.
+ */
+struct OSF_API FPitchHeightField
+{
+    /** Trace the grid. Covers Centre ± (HalfLength, HalfWidth) plus one cell of margin. */
+    void Build(UWorld* World, const FVector& Centre, float HalfLength, float HalfWidth, float InSpacing,
+               float TraceUp, float TraceDown, ECollisionChannel Channel, const AActor* IgnoreActor);
+
+    void Reset();
+
+    bool IsBuilt() const { return Heights.Num() > 0; }
+
+    /** True if (X, Y) is covered by the grid. */
+    bool Contains(float X, float Y) const;
+
+    /** Bilinear height at (X, Y); false outside the grid. OutNormal (optional) is the surface normal. */
+    bool Sample(float X, float Y, float& OutZ, FVector* OutNormal = nullptr) const;
+
+    int32 GetNumSamples() const { return Heights.Num(); }
+
+private:
+    FORCEINLINE float At(int32 IX, int32 IY) const { return Heights[IY * NumX + IX]; }
+
+    FVector2D Origin = FVector2D::ZeroVector; // grid point (0,0)
+    float     Spacing = 0.f;
+    float     InvSpacing = 0.f;
+    int32     NumX = 0;
+    int32     NumY = 0;
+    TArray<float> Heights; // row-major, Y rows of NumX
+};
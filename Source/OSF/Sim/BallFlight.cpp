@@ -0,0 +1,254 @@
+#include "Sim/BallFlight.h"
+
+namespace
+{
+    /** Cross-section in m^2 and radius in m, for the SI aerodynamic constants. */
+    FORCEINLINE float AreaM2(float RadiusCm) { const float R = RadiusCm * 0.01f; return PI * R * R; }
+
+    /** Smallest T in [0, 1] where P0 + T * D enters the sphere, or a negative value. */
+    float SweepSphere(const FVector& P0, const FVector& D, const FVector& Centre, float R)
+    {
+        const FVector Oc = P0 - Centre;
+        const float A = D.SizeSquared();
+        const float B = FVector::DotProduct(D, Oc);
+        const float C = Oc.SizeSquared() - R * R;
+        const float Disc = B * B - A * C;
+        if (A < KINDA_SMALL_NUMBER || C <= 0.f || Disc < 0.f) return -1.f;
+        const float T = (-B - FMath::Sqrt(Disc)) / A;
+        return T <= 1.f ? T : -1.f;
+    }
+
+    /** Smallest T in [0, 1] where P0 + T * D enters the capsule A-B of radius R, or a negative value. */
+    float SweepCapsule(const FVector& P0, const FVector& D, const FVector& A, const FVector& B, float R)
+    {
+        // Side: the infinite cylinder, kept where the entry projects between the ends
+        float Best = -1.f;
+        const FVector Ba = B - A, Oa = P0 - A;
+        const float BaBa = Ba.SizeSquared();
+        const float BaD = FVector::DotProduct(Ba, D);
+        const float BaOa = FVector::DotProduct(Ba, Oa);
+        const float Qa = BaBa * D.SizeSquared() - BaD * BaD;
+        const float Qb = BaBa * FVector::DotProduct(D, Oa) - BaOa * BaD;
+        const float Qc = BaBa * Oa.SizeSquared() - BaOa * BaOa - R * R * BaBa;
+        const float Disc = Qb * Qb - Qa * Qc;
+        if (Qa > KINDA_SMALL_NUMBER && Qc > 0.f && Disc >= 0.f)
+        {
+            const float T = (-Qb - FMath::Sqrt(Disc)) / Qa;
+            const float Y = BaOa + T * BaD;
+            if (T >= 0.f && T <= 1.f && Y > 0.f && Y < BaBa) Best = T;
+        }
+
+        // Ends
+        for (const FVector& End : { A, B })
+        {
+            const float T = SweepSphere(P0, D, End, R);
+            if (T >= 0.f && (Best < 0.f || T < Best)) Best = T;
+        }
+        return Best;
+    }
+}
+
+void FBallFlight::PlaceAtRest(FBallState& S, const FVector& Location) const
+{
+    S.Pos = FVector(Location.X, Location.Y, GroundZ + Params.Radius);
+    S.Vel = S.Spin = FVector::ZeroVector;
+    S.bRolling = true;
+}
+
+void FBallFlight::Advance(FBallState& S, float Time) const
+{
+    const float MaxH = FMath::Max(Params.MaxStep, 1.e-4f);
+    while (Time > KINDA_SMALL_NUMBER)
+    {
+        if (S.IsAtRest()) return;
+        const float H = FMath::Min(Time, MaxH);
+        Step(S, H);
+        Time -= H;
+    }
+}
+
+void FBallFlight::Predict(const FBallState& S0, float Duration, float SampleDt, TArray<FBallState>& Out) const
+{
+    SampleDt = FMath::Max(SampleDt, 1.e-3f);
+    const int32 Num = FMath::FloorToInt(Duration / SampleDt) + 1;
+    Out.Reset(Num);
+
+    FBallState S = S0;
+    Out.Add(S);
+    for (int32 i = 1; i < Num; ++i)
+    {
+        Advance(S, SampleDt);
+        Out.Add(S);
+    }
+}
+
+void FBallFlight::Step(FBallState& S, float H) const
+{
+    if (S.bRolling && S.Vel.Z > Params.RollSpeedZ) S.bRolling = false; // kicked up
+
+    const FVector From = S.Pos;
+    if (S.bRolling) StepRolling(S, H);
+    else            StepAir(S, H);
+
+    if (Obstacles.Num() > 0) CollideObstacles(From, S);
+}
+
+// ---------------- Air ----------------
+FVector FBallFlight::AirAccel(const FVector& V, const FVector& W) const
+{
+    const float Area = AreaM2(Params.Radius);
+
+    // a = -k |v| v with k in 1/cm: (1/2 rho C_D A / m) is per metre
+    const float DragK = 0.5f * Params.AirDensity * Params.DragCoeff * Area / Params.Mass * 0.01f;
+    // a = k (w x v), k dimensionless
+    const float MagnusK = 0.5f * Params.AirDensity * Area * (Params.Radius * 0.01f) * Params.MagnusCoeff / Params.Mass;
+
+    return FVector(0.f, 0.f, -Params.Gravity) - V * (DragK * V.Size()) + MagnusK * FVector::CrossProduct(W, V);
+}
+
+void FBallFlight::StepAir(FBallState& S, float H) const
+{
+    // RK4 on (p, v); spin is constant within the step
+    const FVector W = S.Spin;
+    const FVector P0 = S.Pos, V0 = S.Vel;
+
+    const FVector A1 = AirAccel(V0, W);
+    const FVector V1 = V0 + A1 * (0.5f * H);
+    const FVector A2 = AirAccel(V1, W);
+    const FVector V2 = V0 + A2 * (0.5f * H);
+    const FVector A3 = AirAccel(V2, W);
+    const FVector V3 = V0 + A3 * H;
+    const FVector A4 = AirAccel(V3, W);
+
+    S.Pos = P0 + (V0 + 2.f * V1 + 2.f * V2 + V3) * (H / 6.f);
+    S.Vel = V0 + (A1 + 2.f * A2 + 2.f * A3 + A4) * (H / 6.f);
+    S.Spin = W * FMath::Exp(-Params.SpinDecay * H);
+
+    const float Floor = GroundZ + Params.Radius;
+    if (S.Pos.Z <= Floor && S.Vel.Z < 0.f)
+    {
+        S.Pos.Z = Floor;
+        Bounce(S);
+    }
+}
+
+void FBallFlight::Bounce(FBallState& S) const
+{
+    const float R = Params.Radius;
+    const float Vn = S.Vel.Z;
+
+    // Contact point slip (ground normal +Z, contact at -R Z)
+    const FVector Vt(S.Vel.X, S.Vel.Y, 0.f);
+    const FVector Slip = Vt + FVector::CrossProduct(S.Spin, FVector(0.f, 0.f, -R));
+    const float SlipSize = Slip.Size();
+
+    if (SlipSize > KINDA_SMALL_NUMBER)
+    {
+        // Hollow sphere (I = 2/3 m R^2): slip stops after removing 2/5 of it
+        const float MaxDv = 0.4f * SlipSize;
+        const float Dv = FMath::Min(Params.GroundFriction * (1.f + Params.Restitution) * FMath::Abs(Vn), MaxDv);
+        const FVector DeltaV = -Slip * (Dv / SlipSize);
+
+        S.Vel += DeltaV;
+        // dw = (m / I) (r x dv), r = -R Z
+        S.Spin += FVector::CrossProduct(FVector(0.f, 0.f, -R), DeltaV) * (1.5f / (R * R));
+    }
+
+    S.Vel.Z = -Params.Restitution * Vn;
+    if (S.Vel.Z < Params.RollSpeedZ)
+    {
+        S.Vel.Z = 0.f;
+        S.bRolling = true;
+    }
+}
+
+// ---------------- Pitch ----------------
+void FBallFlight::StepRolling(FBallState& S, float H) const
+{
+    const float R = Params.Radius;
+    const FVector V(S.Vel.X, S.Vel.Y, 0.f);
+    const float Speed = V.Size();
+
+    if (Speed <= Params.RestSpeed)
+    {
+        S.Vel = S.Spin = FVector::ZeroVector;
+        S.Pos.Z = GroundZ + R;
+        return;
+    }
+
+    // dv/dt = -(c + k v^2): v(t) = sqrt(c/k) tan(atan(v0 sqrt(k/c)) - sqrt(ck) t)
+    const float C = Params.RollingResistance * Params.Gravity;
+    const float K = 0.5f * Params.AirDensity * Params.DragCoeff * AreaM2(R) / Params.Mass * 0.01f;
+    const FVector Dir = V / Speed;
+
+    float NewSpeed, Dist;
+    if (K <= 0.f || C <= 0.f)
+    {
+        NewSpeed = FMath::Max(Speed - C * H, 0.f);
+        Dist = 0.5f * (Speed + NewSpeed) * H;
+    }
+    else
+    {
+        const float Root = FMath::Sqrt(C / K);
+        const float Rate = FMath::Sqrt(C * K);
+        const float Phase0 = FMath::Atan(Speed / Root);
+        const float TStop = Phase0 / Rate;
+        const float T = FMath::Min(H, TStop);
+        const float Phase = Phase0 - Rate * T;
+
+        NewSpeed = (T < TStop) ? Root * FMath::Tan(Phase) : 0.f;
+        // Integral of v dt = (1/k) ln(cos(phase) / cos(phase0))
+        Dist = FMath::Loge(FMath::Cos(Phase) / FMath::Cos(Phase0)) / K;
+    }
+
+    S.Pos += Dir * Dist;
+    S.Pos.Z = GroundZ + R;
+    S.Vel = Dir * NewSpeed;
+    // Rolling without slip: w = (n x v) / R
+    S.Spin = FVector::CrossProduct(FVector::UpVector, S.Vel) / R;
+}
+
+// ---------------- Goal frame ----------------
+void FBallFlight::CollideObstacles(const FVector& From, FBallState& S) const
+{
+    // First frame member the step's path runs into: the ball stops at the contact and bounces
+    // (the rest of the step is dropped), so a shot faster than post width per step still hits
+    const FVector Delta = S.Pos - From;
+    const FBallCapsule* Hit = nullptr;
+    float HitT = 2.f;
+    for (const FBallCapsule& Cap : Obstacles)
+    {
+        const float T = SweepCapsule(From, Delta, Cap.A, Cap.B, Params.Radius + Cap.Radius);
+        if (T >= 0.f && T < HitT) { HitT = T; Hit = &Cap; }
+    }
+    if (Hit)
+    {
+        const FVector P = From + Delta * HitT;
+        const FVector C = FMath::ClosestPointOnSegment(P, Hit->A, Hit->B);
+        const FVector N = (P - C).GetSafeNormal();
+        S.Pos = C + N * (Params.Radius + Hit->Radius);
+
+        const float Vn = FVector::DotProduct(S.Vel, N);
+        if (Vn < 0.f) S.Vel -= (1.f + Params.PostRestitution) * Vn * N;
+        if (S.bRolling && S.Vel.Z > Params.RollSpeedZ) S.bRolling = false;
+    }
+
+    // Anything still overlapping (started inside, or resting against a post) is pushed out
+    for (const FBallCapsule& Cap : Obstacles)
+    {
+        const FVector C = FMath::ClosestPointOnSegment(S.Pos, Cap.A, Cap.B);
+        const FVector D = S.Pos - C;
+        const float Reach = Params.Radius + Cap.Radius;
+        const float Dist2 = D.SizeSquared();
+        if (Dist2 >= Reach * Reach || Dist2 < KINDA_SMALL_NUMBER) continue;
+
+        const FVector N = D * FMath::InvSqrt(Dist2);
+        S.Pos = C + N * Reach;
+
+        const float Vn = FVector::DotProduct(S.Vel, N);
+        if (Vn < 0.f) S.Vel -= (1.f + Params.PostRestitution) * Vn * N;
+
+        // Off the post the ball may leave the pitch again
+        if (S.bRolling && S.Vel.Z > Params.RollSpeedZ) S.bRolling = false;
+    }
+}
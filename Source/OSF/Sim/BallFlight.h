@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Ball and pitch constants. Lengths in cm, masses in kg; aerodynamic constants in SI as usually quoted. */
+struct FBallParams
+{
+    float Radius = 11.f;
+    float Mass = 0.43f;
+    float Gravity = 980.f;          // cm/s^2, down -Z
+
+    float AirDensity = 1.225f;      // kg/m^3
+    float DragCoeff = 0.25f;        // quadratic drag, C_D
+    float MagnusCoeff = 1.f;        // C_L = MagnusCoeff * r|w| / |v|
+    float SpinDecay = 0.1f;         // 1/s, in the air
+
+    float Restitution = 0.65f;      // pitch, normal
+    float GroundFriction = 0.4f;    // pitch, Coulomb during a bounce
+    float RollingResistance = 0.08f; // rolling decel = mu_r * g
+    float PostRestitution = 0.7f;   // goal frame
+
+    float RollSpeedZ = 40.f;        // bounces slower than this (cm/s) settle into rolling
+    float RestSpeed = 2.f;          // rolling slower than this stops
+    float MaxStep = 1.f / 120.f;    // internal fixed step (s)
+};
+
+struct FBallState
+{
+    FVector Pos = FVector::ZeroVector;
+    FVector Vel = FVector::ZeroVector;
+    FVector Spin = FVector::ZeroVector; // angular velocity, rad/s
+    bool bRolling = false;
+
+    bool IsAtRest() const { return bRolling && Vel.IsZero(); }
+};
+
+/** Goal frame member: a segment with thickness. */
+struct FBallCapsule
+{
+    FVector A = FVector::ZeroVector;
+    FVector B = FVector::ZeroVector;
+    float Radius = 0.f;
+};
+
+/**
+ * Deterministic ball flight over a flat pitch.
+ *
+ * In the air: gravity, quadratic drag and the Magnus force of the spin,
+ * integrated with RK4. On the pitch: bounces with restitution and Coulomb
+ * friction that trades slip for spin (hollow sphere), and once a bounce is
+ * too small, rolling with constant resistance and drag, solved in closed form
+ * over each step. Goal posts and crossbar are capsules, and the ball's path over
+ * each step is swept against them, so a hard shot cannot step through a post.
+ *
+ * Everything is plain math on a fixed internal step, with no physics scene or
+ * traces, so the AI can call Predict freely.
+ */
+class OSF_API FBallFlight
+{
+public:
+    FBallParams Params;
+    float GroundZ = 0.f;
+    TArray<FBallCapsule> Obstacles;
+
+    /** Advances S by Time, in steps of at most Params.MaxStep. */
+    void Advance(FBallState& S, float Time) const;
+
+    /** Samples the path every SampleDt for Duration (first sample is S0 itself). */
+    void Predict(const FBallState& S0, float Duration, float SampleDt, TArray<FBallState>& Out) const;
+
+    /** Puts S on the pitch at XY with no motion. */
+    void PlaceAtRest(FBallState& S, const FVector& Location) const;
+
+private:
+    void Step(FBallState& S, float H) const;
+    void StepAir(FBallState& S, float H) const;
+    void StepRolling(FBallState& S, float H) const;
+    void Bounce(FBallState& S) const;
+    void CollideObstacles(const FVector& From, FBallState& S) const;
+
+    FVector AirAccel(const FVector& V, const FVector& W) const;
+};
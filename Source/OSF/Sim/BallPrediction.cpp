@@ -0,0 +1,106 @@
+#include "Sim/BallPrediction.h"
+
+#include "OSFStats.h"
+
+void FBallPrediction::Configure(float InHorizon, float SampleRate)
+{
+    Dt = 1.f / FMath::Max(SampleRate, 1.f);
+    const int32 Capacity = FMath::Max(2, FMath::CeilToInt(FMath::Max(InHorizon, Dt) / Dt) + 1);
+    Ring.SetNum(Capacity);
+    Head = Count = 0;
+}
+
+void FBallPrediction::Update(const FBallFlight& Model, const FBallState& Current, double Now)
+{
+    OSF_SCOPE(BallPrediction);
+    if (Ring.Num() == 0) Configure();
+
+    LastSimulated = 0;
+    bLastRebuilt = false;
+
+    // Still on the predicted path (and the same pitch)? Then slide the window.
+    if (Count > 0 && Now >= StartTime && Now <= GetEndTime() && Model.GroundZ == GroundZ)
+    {
+        const FBallState Expected = At(Now);
+        if (FVector::DistSquared(Expected.Pos, Current.Pos) <= PosTolerance * PosTolerance &&
+            FVector::DistSquared(Expected.Vel, Current.Vel) <= VelTolerance * VelTolerance)
+        {
+            // Keep the sample at or just before Now as the first one
+            const int32 Drop = FMath::Min(FMath::FloorToInt(float(Now - StartTime) / Dt), Count - 1);
+            Head = (Head + Drop) % Ring.Num();
+            Count -= Drop;
+            StartTime += Drop * Dt;
+            Extend(Model);
+            INC_DWORD_STAT_BY(STAT_OSF_BallPredictionSamples, LastSimulated);
+            return;
+        }
+    }
+
+    Rebuild(Model, Current, Now);
+    INC_DWORD_STAT_BY(STAT_OSF_BallPredictionSamples, LastSimulated);
+}
+
+void FBallPrediction::Rebuild(const FBallFlight& Model, const FBallState& Current, double Now)
+{
+    bLastRebuilt = true;
+    GroundZ = Model.GroundZ;
+    Head = 0;
+    Count = 1;
+    StartTime = Now;
+    Ring[0] = Current;
+    Extend(Model);
+}
+
+void FBallPrediction::Extend(const FBallFlight& Model)
+{
+    const int32 Capacity = Ring.Num();
+    while (Count < Capacity)
+    {
+        FBallState S = Sample(Count - 1);
+        Model.Advance(S, Dt);
+        Ring[(Head + Count) % Capacity] = S;
+        ++Count;
+        ++LastSimulated;
+    }
+}
+
+FBallState FBallPrediction::At(double Time) const
+{
+    if (Count == 0) return FBallState();
+
+    const float U = FMath::Clamp(float(Time - StartTime) / Dt, 0.f, float(Count - 1));
+    const int32 I = FMath::Min(FMath::FloorToInt(U), Count - 2);
+    if (I < 0) return Sample(0);
+
+    const float Alpha = U - I;
+    const FBallState& A = Sample(I);
+    const FBallState& B = Sample(I + 1);
+
+    FBallState Out = A;
+    Out.Pos = FMath::Lerp(A.Pos, B.Pos, Alpha);
+    Out.Vel = FMath::Lerp(A.Vel, B.Vel, Alpha);
+    Out.Spin = FMath::Lerp(A.Spin, B.Spin, Alpha);
+    return Out;
+}
+
+bool FBallPrediction::FirstWithinReach(const FVector& P, float Reach, float MaxHeight, double FromTime,
+                                       double& OutTime, FVector* OutPos) const
+{
+    if (Count == 0) return false;
+
+    const int32 First = FMath::Clamp(FMath::FloorToInt(float(FromTime - StartTime) / Dt), 0, Count - 1);
+    const float Reach2 = Reach * Reach;
+    const float TopZ = GroundZ + MaxHeight;
+
+    for (int32 i = First; i < Count; ++i)
+    {
+        const FBallState& S = Sample(i);
+        if (S.Pos.Z > TopZ) continue;
+        if (FVector::DistSquared2D(S.Pos, P) > Reach2) continue;
+
+        OutTime = FMath::Max(StartTime + i * Dt, FromTime);
+        if (OutPos) *OutPos = S.Pos;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sim/BallFlight.h"
+
+/**
+ * The ball's future, computed once per physics step and shared by every AI query.
+ *
+ * A fixed ring of FBallFlight states at SampleRate covering Horizon seconds
+ * from the last Update. While the ball follows the prediction, an update only
+ * drops the samples now in the past and simulates the few new ones at the far
+ * end; a kick, touch or teleport (the ball is not where the ring says) rebuilds
+ * the ring from the new state. Storage is allocated once in Configure.
+ */
+class OSF_API FBallPrediction
+{
+public:
+    /** Allocates the ring; clears the prediction. */
+    void Configure(float InHorizon = 3.f, float SampleRate = 60.f);
+
+    /** Call after each physics step with the ball's state at Now. */
+    void Update(const FBallFlight& Model, const FBallState& Current, double Now);
+
+    void Reset() { Count = 0; }
+    bool IsValid() const { return Count > 0; }
+
+    /** Interpolated state at Time; clamped to the covered span. O(1). */
+    FBallState At(double Time) const;
+    FVector PositionAt(double Time) const { return At(Time).Pos; }
+
+    /**
+     * Earliest time in [FromTime, end of horizon] the ball is within Reach of P
+     * (2D) and no higher than MaxHeight above the pitch. False if it never is.
+     */
+    bool FirstWithinReach(const FVector& P, float Reach, float MaxHeight, double FromTime,
+                          double& OutTime, FVector* OutPos = nullptr) const;
+
+    double GetStartTime() const { return StartTime; }
+    double GetEndTime() const { return StartTime + (Count - 1) * Dt; }
+    float GetSampleDt() const { return Dt; }
+    int32 Num() const { return Count; }
+
+    /** Sample i from the start (0 = the state at GetStartTime()). */
+    const FBallState& Sample(int32 i) const { return Ring[(Head + i) % Ring.Num()]; }
+
+    // ---------- Last update ----------
+    bool bLastRebuilt = false;
+    int32 LastSimulated = 0; // samples computed by the last Update
+
+private:
+    void Rebuild(const FBallFlight& Model, const FBallState& Current, double Now);
+    void Extend(const FBallFlight& Model);
+
+    TArray<FBallState> Ring;
+    int32 Head = 0;
+    int32 Count = 0;
+    double StartTime = 0.0;
+    float Dt = 1.f / 60.f;
+    float GroundZ = 0.f;
+
+    // Drift allowed before the ring is thrown away
+    float PosTolerance = 2.f;    // cm
+    float VelTolerance = 20.f;   // cm/s
+};
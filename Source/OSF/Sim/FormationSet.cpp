@@ -0,0 +1,111 @@
+#include "Sim/FormationSet.h"
+
+// ---------------- Formations ----------------
+int32 FFormationSet::Add(FName Name, TConstArrayView<FVector> Local)
+{
+    int32 Index = Find(Name);
+    if (Index == INDEX_NONE)
+    {
+        Index = Names.Add(Name);
+        Locals.AddDefaulted();
+        Zones.Add(nullptr);
+    }
+    Locals[Index] = Local;
+    bDirty = true;
+    return Index;
+}
+
+// ---------------- Compile ----------------
+void FFormationSet::Compile(const FMatchKernel& Kernel, int32 NumSlots)
+{
+    const FTacticParams& T = Kernel.Tactics;
+    CompiledSlots = Names.Num() > 0 ? FMath::Max(NumSlots, 0) : 0;
+    Points.SetNumUninitialized(Names.Num() * NumShapes * 2 * CompiledSlots);
+
+    // Same order of operations as the kernel's runtime path: mirror, shift, clamp, ground
+    for (int32 F = 0; F < Names.Num(); ++F)
+    {
+        for (int32 TeamID = 0; TeamID < 2; ++TeamID)
+        {
+            const float Dir = (TeamID == 0) ? +1.f : -1.f;
+            for (int32 Slot = 0; Slot < CompiledSlots; ++Slot)
+            {
+                const FVector L = FMatchKernel::FormationSlot(Locals[F], Slot);
+                const FVector Base = T.FieldCentre + FVector(L.X * Dir, L.Y * Dir, L.Z);
+
+                const float ShiftX[NumShapes] = { 0.f, T.AdvanceWithBall * 0.5f * Dir, -T.RetreatWithBall * 0.5f * Dir };
+                for (int32 S = 0; S < NumShapes; ++S)
+                {
+                    const FVector P = Kernel.Ground(Kernel.ClampToField(Base + FVector(ShiftX[S], 0.f, 0.f)));
+                    Points[PointIndex(F, static_cast<EFormationShape>(S), TeamID, Slot)] = FVector3f(P);
+                }
+            }
+        }
+    }
+
+    CompiledCentre = T.FieldCentre;
+    CompiledHalfLength = T.HalfLength;
+    CompiledHalfWidth = T.HalfWidth;
+    CompiledAdvance = T.AdvanceWithBall;
+    CompiledRetreat = T.RetreatWithBall;
+    bDirty = false;
+
+    for (FTeamBlend& B : Teams)
+    {
+        if (!Names.IsValidIndex(B.From) || !Names.IsValidIndex(B.To)) B = FTeamBlend();
+    }
+}
+
+bool FFormationSet::IsCompiledFor(const FMatchKernel& Kernel, int32 NumSlots) const
+{
+    const FTacticParams& T = Kernel.Tactics;
+    return !bDirty
+        && CompiledSlots == (Names.Num() > 0 ? NumSlots : 0)
+        && CompiledCentre == T.FieldCentre
+        && CompiledHalfLength == T.HalfLength
+        && CompiledHalfWidth == T.HalfWidth
+        && CompiledAdvance == T.AdvanceWithBall
+        && CompiledRetreat == T.RetreatWithBall;
+}
+
+// ---------------- Selection ----------------
+void FFormationSet::SwitchTo(int32 TeamID, int32 Index, float Seconds)
+{
+    if (TeamID < 0 || TeamID > 1 || !Names.IsValidIndex(Index)) return;
+
+    FTeamBlend& B = Teams[TeamID];
+    if (Index == B.From && Index != B.To)
+    {
+        // Back the way it came, from where it is
+        Swap(B.From, B.To);
+        B.Alpha = 1.f - B.Alpha;
+    }
+    else if (Index != B.To)
+    {
+        B.From = (B.Alpha >= 0.5f) ? B.To : B.From;
+        B.To = Index;
+        B.Alpha = 0.f;
+    }
+
+    B.Rate = (Seconds > 0.f) ? 1.f / Seconds : 0.f;
+    if (B.Rate == 0.f) B.Alpha = 1.f;
+}
+
+void FFormationSet::SetBlend(int32 TeamID, int32 From, int32 To, float Alpha)
+{
+    if (TeamID < 0 || TeamID > 1 || !Names.IsValidIndex(From) || !Names.IsValidIndex(To)) return;
+
+    FTeamBlend& B = Teams[TeamID];
+    B.From = From;
+    B.To = To;
+    B.Alpha = FMath::Clamp(Alpha, 0.f, 1.f);
+    B.Rate = 0.f;
+}
+
+void FFormationSet::Advance(float DeltaSeconds)
+{
+    for (FTeamBlend& B : Teams)
+    {
+        if (B.Rate > 0.f && B.Alpha < 1.f) B.Alpha = FMath::Min(B.Alpha + B.Rate * DeltaSeconds, 1.f);
+    }
+}
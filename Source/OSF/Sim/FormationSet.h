@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sim/MatchKernel.h"
+
+class FFormationZones;
+
+/**
+ * Formations compiled to world space: every slot of every formation, for
+ * both teams and each EFormationShape, mirrored, shifted, clamped to the
+ * field and grounded once, in one flat array. FMatchKernel::Home reads a
+ * point instead of redoing that transform (and a ground query) per player
+ * per Think.
+ *
+ * Each team plays one formation or a blend of two. Switching and blending
+ * only move indices and a weight, so they are free at runtime and never
+ * allocate; blended points lerp between grounded points, which is exact on
+ * a flat pitch and close on a gentle one. Compile again whenever the pitch,
+ * the ground or AdvanceWithBall/RetreatWithBall change (IsCompiledFor).
+ *
+ * A formation can also carry a ball-zone table (FFormationZones); once a
+ * team has settled on it, the kernel takes held shape from the table.
+ *
+ * Home is read-only and safe from several threads; everything else is for
+ * the owning thread between Thinks.
+ */
+class OSF_API FFormationSet
+{
+public:
+    // ---------- Formations ----------
+    /** Adds Name, or replaces its points (local, slot order); either way the set needs compiling. Returns its index. */
+    int32 Add(FName Name, TConstArrayView<FVector> Local);
+
+    int32 Num() const { return Names.Num(); }
+    int32 Find(FName Name) const { return Names.IndexOfByKey(Name); }
+    FName GetName(int32 Index) const { return Names.IsValidIndex(Index) ? Names[Index] : NAME_None; }
+
+    /** Optional ball-zone table for formation Index; not owned, and may be shared with other sets. */
+    void SetZones(int32 Index, const FFormationZones* InZones) { if (Zones.IsValidIndex(Index)) Zones[Index] = InZones; }
+
+    // ---------- Compile ----------
+    /** World points for NumSlots slots per team (extra slots as FMatchKernel::FormationSlot) with Kernel's pitch, shifts and ground. */
+    void Compile(const FMatchKernel& Kernel, int32 NumSlots);
+
+    /** True when the compiled points are current for Kernel's tactics and NumSlots. */
+    bool IsCompiledFor(const FMatchKernel& Kernel, int32 NumSlots) const;
+    bool IsCompiled() const { return CompiledSlots > 0; }
+
+    /** Next IsCompiledFor fails, e.g. after the ground changed under the points. */
+    void Invalidate() { bDirty = true; }
+
+    // ---------- Selection ----------
+    /**
+     * Moves TeamID to formation Index over Seconds (0 = at once). Mid-blend, switching back
+     * reverses from where the team is; a third formation starts from whichever one dominates.
+     */
+    void SwitchTo(int32 TeamID, int32 Index, float Seconds);
+
+    /** Holds TeamID at Alpha (0..1) between two formations until the next SwitchTo or SetBlend. */
+    void SetBlend(int32 TeamID, int32 From, int32 To, float Alpha);
+
+    /** Runs the timed blends. */
+    void Advance(float DeltaSeconds);
+
+    /** Formation TeamID is playing or heading to. */
+    int32 GetFormation(int32 TeamID) const { return Teams[TeamID].To; }
+
+    /** Zone table of TeamID's formation; null without one and while blending (the blended homes apply then). */
+    const FFormationZones* GetZones(int32 TeamID) const
+    {
+        const FTeamBlend& B = Teams[TeamID];
+        return (B.Alpha >= 1.f || B.From == B.To) && Zones.IsValidIndex(B.To) ? Zones[B.To] : nullptr;
+    }
+
+    // ---------- Query ----------
+    bool HasSlot(int32 Slot) const { return Slot >= 0 && Slot < CompiledSlots; }
+
+    /** TeamID's grounded home for Slot (HasSlot) in Shape, blended. */
+    FORCEINLINE FVector Home(int32 TeamID, int32 Slot, EFormationShape Shape) const
+    {
+        const FTeamBlend& B = Teams[TeamID];
+        const FVector3f& To = Points[PointIndex(B.To, Shape, TeamID, Slot)];
+        if (B.Alpha >= 1.f || B.From == B.To) return FVector(To);
+        return FVector(FMath::Lerp(Points[PointIndex(B.From, Shape, TeamID, Slot)], To, B.Alpha));
+    }
+
+private:
+    static constexpr int32 NumShapes = 3;
+
+    FORCEINLINE int32 PointIndex(int32 Formation, EFormationShape Shape, int32 TeamID, int32 Slot) const
+    {
+        return ((Formation * NumShapes + static_cast<int32>(Shape)) * 2 + TeamID) * CompiledSlots + Slot;
+    }
+
+    struct FTeamBlend
+    {
+        int32 From = 0;
+        int32 To = 0;
+        float Alpha = 1.f;
+        float Rate = 0.f;   // alpha per second; 0 holds
+    };
+
+    TArray<FName> Names;
+    TArray<TArray<FVector>> Locals;
+    TArray<const FFormationZones*> Zones;
+
+    // [formation][shape][team][slot]
+    TArray<FVector3f> Points;
+    int32 CompiledSlots = 0;
+    bool bDirty = true;
+
+    // What Points were compiled with
+    FVector CompiledCentre = FVector::ZeroVector;
+    float CompiledHalfLength = 0.f;
+    float CompiledHalfWidth = 0.f;
+    float CompiledAdvance = 0.f;
+    float CompiledRetreat = 0.f;
+
+    FTeamBlend Teams[2];
+};
@@ -0,0 +1,96 @@
+#include "Sim/FormationZones.h"
+
+#include "Sim/MatchKernel.h"
+
+// ---------------- Build ----------------
+void FFormationZones::Bake(const FTacticParams& Tactics, TConstArrayView<FVector> Formation, int32 InNumSlots, const FFormationZoneBake& Params)
+{
+    Reset();
+    if (InNumSlots <= 0 || Formation.Num() == 0) return;
+
+    NumX = FMath::Max(Params.NumX, 2);
+    NumY = FMath::Max(Params.NumY, 2);
+    NumSlots = InNumSlots;
+    HalfLength = Tactics.HalfLength;
+    HalfWidth = Tactics.HalfWidth;
+    Points.SetNumUninitialized(2 * NumY * NumX * NumSlots * 2);
+
+    // Team 0 about a centre at the origin: the kernel's home blend toward the phase's shifted home,
+    // with the shifted home following the ball by Slide
+    auto Clamp = [this](const FVector& P)
+        {
+            return FVector(FMath::Clamp<double>(P.X, -HalfLength, HalfLength), FMath::Clamp<double>(P.Y, -HalfWidth, HalfWidth), 0.f);
+        };
+    auto Store = [](double V) { return static_cast<int16>(FMath::Clamp(FMath::RoundToInt(V), -32767, 32767)); };
+
+    int16* Out = Points.GetData();
+    for (int32 Phase = 0; Phase < 2; ++Phase)
+    {
+        const float ShiftX = (Phase == 0) ? Tactics.AdvanceWithBall * 0.5f : -Tactics.RetreatWithBall * 0.5f;
+        for (int32 IY = 0; IY < NumY; ++IY)
+        {
+            const float BallY = -HalfWidth + 2.f * HalfWidth * IY / (NumY - 1);
+            for (int32 IX = 0; IX < NumX; ++IX)
+            {
+                const float BallX = -HalfLength + 2.f * HalfLength * IX / (NumX - 1);
+                const FVector Slide(ShiftX + BallX * Params.SlideX, BallY * Params.SlideY, 0.f);
+                for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+                {
+                    const FVector L = FMatchKernel::FormationSlot(Formation, Slot);
+                    const FVector P = FMath::Lerp(Clamp(L), Clamp(L + Slide), 1.f - Tactics.HomeWeight);
+                    *Out++ = Store(P.X);
+                    *Out++ = Store(P.Y);
+                }
+            }
+        }
+    }
+}
+
+bool FFormationZones::Assign(int32 InNumX, int32 InNumY, int32 InNumSlots, float InHalfLength, float InHalfWidth, TConstArrayView<int16> InPoints)
+{
+    Reset();
+    if (InNumX < 2 || InNumY < 2 || InNumSlots <= 0 || InHalfLength <= 0.f || InHalfWidth <= 0.f) return false;
+    if (InPoints.Num() != 2 * InNumY * InNumX * InNumSlots * 2) return false;
+
+    NumX = InNumX;
+    NumY = InNumY;
+    NumSlots = InNumSlots;
+    HalfLength = InHalfLength;
+    HalfWidth = InHalfWidth;
+    Points = InPoints;
+    return true;
+}
+
+void FFormationZones::Reset()
+{
+    NumX = NumY = NumSlots = 0;
+    HalfLength = HalfWidth = 0.f;
+    Points.Reset();
+}
+
+// ---------------- Query ----------------
+FVector FFormationZones::Sample(const FTacticParams& Tactics, bool bAttacking, int32 TeamID, int32 Slot, const FVector& Ball) const
+{
+    const FVector& C = Tactics.FieldCentre;
+    const float Dir = (TeamID == 0) ? +1.f : -1.f;
+
+    // Ball on the grid, in team 0's orientation
+    const float U = FMath::Clamp((static_cast<float>(Ball.X - C.X) * Dir / Tactics.HalfLength + 1.f) * 0.5f * (NumX - 1), 0.f, NumX - 1.f);
+    const float V = FMath::Clamp((static_cast<float>(Ball.Y - C.Y) * Dir / Tactics.HalfWidth + 1.f) * 0.5f * (NumY - 1), 0.f, NumY - 1.f);
+    const int32 IX = FMath::Min(static_cast<int32>(U), NumX - 2);
+    const int32 IY = FMath::Min(static_cast<int32>(V), NumY - 2);
+    const float FX = U - IX;
+    const float FY = V - IY;
+
+    const int32 Stride = NumSlots * 2;
+    const int16* P00 = Points.GetData() + (((bAttacking ? 0 : NumY) + IY) * NumX + IX) * Stride + Slot * 2;
+    const int16* P10 = P00 + Stride;
+    const int16* P01 = P00 + NumX * Stride;
+    const int16* P11 = P01 + Stride;
+
+    const float X = FMath::Lerp(FMath::Lerp<float>(P00[0], P10[0], FX), FMath::Lerp<float>(P01[0], P11[0], FX), FY);
+    const float Y = FMath::Lerp(FMath::Lerp<float>(P00[1], P10[1], FX), FMath::Lerp<float>(P01[1], P11[1], FX), FY);
+
+    // Scaled to this pitch, back to TeamID's orientation
+    return FVector(C.X + X * (Tactics.HalfLength / HalfLength) * Dir, C.Y + Y * (Tactics.HalfWidth / HalfWidth) * Dir, C.Z);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FTacticParams;
+
+/** How a baked table follows the ball, on top of the kernel's home blend and phase shifts. */
+struct FFormationZoneBake
+{
+    int32 NumX = 13;      // ball grid points along the pitch, goal line to goal line
+    int32 NumY = 9;       // and across it, touchline to touchline
+    float SlideX = 0.25f; // share of the ball's distance from the centre the shape follows, along
+    float SlideY = 0.35f; // and across (0, 0 = the kernel's rules exactly: the same target everywhere)
+};
+
+/**
+ * Where each slot holds its shape for a given ball position, attacking and
+ * defending: a table over a grid of ball positions, sampled bilinearly. One
+ * sample is eight int16 reads and two lerps, in place of the home, shift,
+ * clamp and HomeWeight blend per player.
+ *
+ * Points are cm from the field centre in team 0's orientation (X toward the
+ * goal it attacks); team 1 reads the mirrored ball and mirrors the result. A
+ * pitch of another size than the bake's scales both, so one table serves any
+ * pitch. Tables are immutable once built and safe to share between matches
+ * and threads.
+ */
+class OSF_API FFormationZones
+{
+public:
+    /** Bakes from the kernel's rules for Formation (local, slot order; extra slots as FMatchKernel::FormationSlot). */
+    void Bake(const FTacticParams& Tactics, TConstArrayView<FVector> Formation, int32 InNumSlots, const FFormationZoneBake& Params);
+
+    /** A stored table ([phase][y][x][slot][x, y], attack first); false, and empty, if the sizes disagree. */
+    bool Assign(int32 InNumX, int32 InNumY, int32 InNumSlots, float InHalfLength, float InHalfWidth, TConstArrayView<int16> InPoints);
+
+    void Reset();
+
+    bool IsValid() const { return NumSlots > 0; }
+    bool HasSlot(int32 Slot) const { return Slot >= 0 && Slot < NumSlots; }
+
+    int32 GetNumX() const { return NumX; }
+    int32 GetNumY() const { return NumY; }
+    int32 GetNumSlots() const { return NumSlots; }
+    float GetHalfLength() const { return HalfLength; }
+    float GetHalfWidth() const { return HalfWidth; }
+    TConstArrayView<int16> GetPoints() const { return Points; }
+
+    /** TeamID's shape point for Slot (HasSlot) with the ball at Ball, on Tactics' pitch; Z is the field centre's. */
+    FVector Sample(const FTacticParams& Tactics, bool bAttacking, int32 TeamID, int32 Slot, const FVector& Ball) const;
+
+private:
+    int32 NumX = 0;
+    int32 NumY = 0;
+    int32 NumSlots = 0;
+    float HalfLength = 0.f; // pitch the table was baked for
+    float HalfWidth = 0.f;
+    TArray<int16> Points;
+};
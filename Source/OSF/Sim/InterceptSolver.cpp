@@ -0,0 +1,113 @@
+#include "Sim/InterceptSolver.h"
+
+#include "Math/VectorRegister.h"
+
+#include "MatchSnapshot.h"
+#include "OSFStats.h"
+#include "Sim/BallPrediction.h"
+#include "Sim/ReachModel.h"
+
+// ---------------- Path ----------------
+void FInterceptSolver::ResetPath(float InDt, float InGroundZ)
+{
+    Dt = FMath::Max(InDt, KINDA_SMALL_NUMBER);
+    GroundZ = InGroundZ;
+    PathX.Reset();
+    PathY.Reset();
+    Playable.Reset();
+}
+
+void FInterceptSolver::AddPathPoint(const FVector& P)
+{
+    PathX.Add(static_cast<float>(P.X));
+    PathY.Add(static_cast<float>(P.Y));
+    Playable.Add(P.Z - GroundZ <= Params.MaxHeight ? 1 : 0);
+}
+
+void FInterceptSolver::SetPath(const FBallPrediction& Prediction, double Now, float InDt, float InGroundZ)
+{
+    ResetPath(InDt, InGroundZ);
+    if (!Prediction.IsValid()) return;
+
+    const int32 N = FMath::Max(1, FMath::FloorToInt(float(Prediction.GetEndTime() - Now) / Dt) + 1);
+    for (int32 k = 0; k < N; ++k)
+    {
+        AddPathPoint(Prediction.PositionAt(Now + k * Dt));
+    }
+}
+
+// ---------------- Solve ----------------
+void FInterceptSolver::Solve(FMatchSnapshot& Snap) const
+{
+    OSF_SCOPE(Intercept);
+    Snap.bHasIntercepts = false;
+    if (PathX.Num() == 0 || Snap.Num == 0) return;
+
+    for (int32 i = 0; i < Snap.NumPadded; i += 4)
+    {
+        SolveLanes(Snap, i, Snap.InterceptT.GetData() + i, Snap.InterceptX.GetData() + i, Snap.InterceptY.GetData() + i);
+    }
+
+    // Rank each team; eleven entries, so insertion sort
+    for (int32 TeamID = 0; TeamID < 2; ++TeamID)
+    {
+        const int32 Begin = Snap.TeamBegin[TeamID];
+        const int32 End = Snap.TeamEnd[TeamID];
+        for (int32 i = Begin; i < End; ++i)
+        {
+            if (!Snap.Valid[i]) Snap.InterceptT[i] = TNumericLimits<float>::Max();
+
+            int32 Pos = i;
+            while (Pos > Begin && Snap.InterceptT[Snap.InterceptOrder[Pos - 1]] > Snap.InterceptT[i])
+            {
+                Snap.InterceptOrder[Pos] = Snap.InterceptOrder[Pos - 1];
+                --Pos;
+            }
+            Snap.InterceptOrder[Pos] = i;
+        }
+    }
+    Snap.bHasIntercepts = true;
+}
+
+void FInterceptSolver::SolveLanes(const FMatchSnapshot& Snap, int32 Begin, float* OutT, float* OutX, float* OutY) const
+{
+    const FReachLanes Lanes = FReachLanes::Load(Snap, Begin, Params.ControlRadius, Params.ReactionTime);
+    const VectorRegister4Float Zero = VectorZeroFloat();
+
+    VectorRegister4Float BestT = VectorSetFloat1(TNumericLimits<float>::Max());
+    VectorRegister4Float BestX = Zero;
+    VectorRegister4Float BestY = Zero;
+    VectorRegister4Float Found = Zero;
+
+    const int32 N = PathX.Num();
+    for (int32 k = 0; k < N; ++k)
+    {
+        if (!Playable[k]) continue;
+
+        const VectorRegister4Float Bx = VectorSetFloat1(PathX[k]);
+        const VectorRegister4Float By = VectorSetFloat1(PathY[k]);
+        const VectorRegister4Float Tk = VectorSetFloat1(k * Dt);
+
+        const VectorRegister4Float Hit = VectorSelect(Found, Zero, VectorCompareLE(Lanes.TimeTo(Bx, By), Tk));
+        BestT = VectorSelect(Hit, Tk, BestT);
+        BestX = VectorSelect(Hit, Bx, BestX);
+        BestY = VectorSelect(Hit, By, BestY);
+        Found = VectorBitwiseOr(Found, Hit);
+        if (VectorMaskBits(Found) == 0xF) break;
+    }
+
+    // Never in time: run to where the path ends
+    if (VectorMaskBits(Found) != 0xF)
+    {
+        const VectorRegister4Float Bx = VectorSetFloat1(PathX[N - 1]);
+        const VectorRegister4Float By = VectorSetFloat1(PathY[N - 1]);
+        const VectorRegister4Float T = VectorMax(Lanes.TimeTo(Bx, By), VectorSetFloat1((N - 1) * Dt));
+        BestT = VectorSelect(Found, BestT, T);
+        BestX = VectorSelect(Found, BestX, Bx);
+        BestY = VectorSelect(Found, BestY, By);
+    }
+
+    VectorStore(BestT, OutT);
+    VectorStore(BestX, OutX);
+    VectorStore(BestY, OutY);
+}
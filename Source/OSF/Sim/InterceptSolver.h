@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMatchSnapshot;
+class FBallPrediction;
+
+/** Reaction, turning and reach shared by every player. */
+struct FInterceptParams
+{
+    float ReactionTime = 0.1f;   // s before a player starts moving
+    float ControlRadius = 70.f;  // cm from the ball at which a player can play it
+    float MaxHeight = 180.f;     // cm above the pitch; higher samples cannot be played
+};
+
+/**
+ * Earliest time every player can reach the ball's predicted path.
+ *
+ * The path is a short list of ball positions at a fixed step from now (the
+ * shared FBallPrediction resampled, or anything else the caller has). A player
+ * reaches a point after their reaction time, the time to turn towards it at
+ * their turn rate, and an accelerate-then-cruise run from their current speed
+ * along that direction, capped at their max speed (FReachLanes, shared with
+ * pitch control). The intercept is the first path point they reach no later
+ * than the ball does; if there is none within the path, the last point and
+ * the time to get there.
+ *
+ * Solve runs four players per SIMD lane group over the path samples and stops
+ * once all four have an intercept, then ranks each team in the snapshot.
+ */
+class OSF_API FInterceptSolver
+{
+public:
+    FInterceptParams Params;
+
+    // ---------- Path ----------
+    void ResetPath(float InDt, float InGroundZ);
+    void AddPathPoint(const FVector& P);
+
+    /** The prediction from Now over its horizon, one point per Dt. */
+    void SetPath(const FBallPrediction& Prediction, double Now, float InDt, float InGroundZ);
+
+    int32 NumPathPoints() const { return PathX.Num(); }
+
+    // ---------- Solve ----------
+    /** Fills Snap.InterceptT/X/Y and InterceptOrder for every lane. */
+    void Solve(FMatchSnapshot& Snap) const;
+
+private:
+    void SolveLanes(const FMatchSnapshot& Snap, int32 Begin, float* OutT, float* OutX, float* OutY) const;
+
+    // SoA so the solver loads ball X/Y as scalars straight into the lanes
+    TArray<float> PathX, PathY;
+    TArray<uint8> Playable;
+    float Dt = 1.f / 15.f;
+    float GroundZ = 0.f;
+};
@@ -0,0 +1,541 @@
+#include "Sim/KickSolver.h"
+
+#include "Math/VectorRegister.h"
+
+#include "OSFStats.h"
+
+namespace
+{
+    /** Cross-section in m^2, for the SI aerodynamic constants (as FBallFlight). */
+    FORCEINLINE float AreaM2(float RadiusCm) { const float R = RadiusCm * 0.01f; return PI * R * R; }
+
+    // Finite-difference steps for the Jacobian
+    constexpr float SpeedProbe = 20.f;       // cm/s
+    constexpr float ElevationProbe = 0.01f;  // rad
+
+    // Newton steps are capped so a bad guess cannot throw the ball somewhere unrelated
+    constexpr float MaxElevationStep = 0.2f;
+
+    FORCEINLINE VectorRegister4Float LerpLanes(const VectorRegister4Float& A, const VectorRegister4Float& B, const VectorRegister4Float& F)
+    {
+        return VectorMultiplyAdd(VectorSubtract(B, A), F, A);
+    }
+}
+
+/** Per lane: how the ball got to the target's distance, and where it was at the goal's time. */
+struct FKickSolver::FLaneResult
+{
+    alignas(16) float CrossT[4];
+    alignas(16) float CrossY[4];
+    alignas(16) float CrossZ[4];
+    alignas(16) float CrossSpeed[4];
+    alignas(16) float EndX[4];   // furthest along the kick (the target's distance once reached)
+    alignas(16) float AtX[4];
+    alignas(16) float AtY[4];
+    alignas(16) float AtZ[4];
+    int32 ReachedMask = 0;
+
+    bool Reached(int32 Lane) const { return (ReachedMask >> Lane) & 1; }
+};
+
+// ---------------- Configure ----------------
+void FKickSolver::ValueRange(EKickGoal Goal, const FKickSolverParams& P, float& OutMin, float& OutMax)
+{
+    switch (Goal)
+    {
+    case EKickGoal::LaunchSpeed:  OutMin = P.MinSpeed; OutMax = P.MaxSpeed; break;
+    case EKickGoal::ArrivalTime:  OutMin = 0.25f; OutMax = 0.6f * P.MaxTime; break;
+    default:                      OutMin = 0.f; OutMax = 0.5f * P.MaxSpeed; break;
+    }
+}
+
+void FKickSolver::Configure(const FBallParams& InBall, float InGroundZ)
+{
+    Ball = InBall;
+    GroundZ = InGroundZ;
+
+    const float Area = AreaM2(Ball.Radius);
+    DragK = 0.5f * Ball.AirDensity * Ball.DragCoeff * Area / Ball.Mass * 0.01f;
+    MagnusK = 0.5f * Ball.AirDensity * Area * (Ball.Radius * 0.01f) * Ball.MagnusCoeff / Ball.Mass;
+
+    // Ground-level targets over distance x goal value. Each distance starts from the
+    // solution one bin closer (continuation); the first, and any that failed, from the vacuum guess.
+    static_assert(NumValueBins % 4 == 0, "Value bins are solved four lanes at a time");
+    Guesses.SetNumUninitialized(6 * NumDistBins * NumValueBins);
+
+    const FVector From(0.f, 0.f, GroundZ + Ball.Radius);
+    for (int32 GoalIdx = 0; GoalIdx < 3; ++GoalIdx)
+    {
+        for (int32 Ground = 0; Ground < 2; ++Ground)
+        {
+            FKickQuery Query;
+            Query.Goal = static_cast<EKickGoal>(GoalIdx);
+            Query.bGround = Ground == 1;
+
+            float VMin, VMax;
+            ValueRange(Query.Goal, Params, VMin, VMax);
+            FVector2f* Table = Guesses.GetData() + TableIndex(Query.Goal, Query.bGround) * NumDistBins * NumValueBins;
+
+            for (int32 V0 = 0; V0 < NumValueBins; V0 += 4)
+            {
+                FKickTarget Targets[4];
+                FKickSolution Sol[4];
+                float GuessV[4], GuessPhi[4];
+                for (int32 d = 0; d < NumDistBins; ++d)
+                {
+                    const float H = Params.MaxDistance * float(d + 1) / NumDistBins;
+                    for (int32 Lane = 0; Lane < 4; ++Lane)
+                    {
+                        FKickTarget& T = Targets[Lane];
+                        T.From = From;
+                        T.To = From + FVector(H, 0.f, 0.f);
+                        T.Value = FMath::Lerp(VMin, VMax, float(V0 + Lane) / float(NumValueBins - 1));
+                        if (d == 0 || !Sol[Lane].bConverged) ColdGuess(Query, H, T.Value, GuessV[Lane], GuessPhi[Lane]);
+                        else { GuessV[Lane] = Sol[Lane].Speed; GuessPhi[Lane] = Sol[Lane].Elevation; }
+                    }
+                    SolveGroup(Query, Targets, 4, GuessV, GuessPhi, Params.MaxIterations, Sol);
+                    for (int32 Lane = 0; Lane < 4; ++Lane)
+                    {
+                        Table[d * NumValueBins + V0 + Lane] = FVector2f(Sol[Lane].Speed, Sol[Lane].Elevation);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ---------------- Guesses ----------------
+void FKickSolver::ColdGuess(const FKickQuery& Query, float H, float Value, float& OutV, float& OutPhi) const
+{
+    const float G = Ball.Gravity;
+    const float Roll = Ball.RollingResistance * G;
+    H = FMath::Max(H, 1.f);
+    OutPhi = 0.f;
+
+    switch (Query.Goal)
+    {
+    case EKickGoal::LaunchSpeed:
+        OutV = Value;
+        break;
+    case EKickGoal::ArrivalTime:
+    {
+        // Drag costs about e^(kH/2) of the mean speed; in the air, rise for half the time
+        const float T = FMath::Max(Value, 0.05f);
+        const float VH = H / T * FMath::Exp(0.5f * DragK * H);
+        if (Query.bGround)
+        {
+            OutV = VH + 0.5f * Roll * T;
+            return;
+        }
+        const float VZ = 0.5f * G * T;
+        OutV = FMath::Sqrt(VH * VH + VZ * VZ);
+        OutPhi = FMath::Atan2(VZ, VH);
+        return;
+    }
+    default:
+        // Rolling resistance takes 2cH off v^2, drag a factor e^(kH) off v
+        OutV = FMath::Sqrt(Value * Value + (Query.bGround ? 2.f * Roll * H : 0.f)) * FMath::Exp(DragK * H);
+        break;
+    }
+
+    if (!Query.bGround)
+    {
+        // Vacuum range equation, low branch
+        const float V = FMath::Max(OutV, 1.f);
+        OutPhi = 0.5f * FMath::Asin(FMath::Min(G * H / (V * V), 1.f));
+    }
+}
+
+void FKickSolver::Guess(const FKickQuery& Query, float H, float Value, float& OutV, float& OutPhi) const
+{
+    if (!IsConfigured())
+    {
+        ColdGuess(Query, H, Value, OutV, OutPhi);
+        return;
+    }
+
+    // Bilinear over (distance, value); distances sit at MaxDistance * (d + 1) / NumDistBins
+    float VMin, VMax;
+    ValueRange(Query.Goal, Params, VMin, VMax);
+    const float U = FMath::Clamp(H / Params.MaxDistance * NumDistBins - 1.f, 0.f, float(NumDistBins - 1));
+    const float W = FMath::Clamp((Value - VMin) / FMath::Max(VMax - VMin, KINDA_SMALL_NUMBER) * (NumValueBins - 1), 0.f, float(NumValueBins - 1));
+    const int32 D0 = FMath::Min(FMath::FloorToInt(U), NumDistBins - 2);
+    const int32 V0 = FMath::Min(FMath::FloorToInt(W), NumValueBins - 2);
+    const float Fd = U - D0;
+    const float Fv = W - V0;
+
+    const FVector2f* Table = Guesses.GetData() + TableIndex(Query.Goal, Query.bGround) * NumDistBins * NumValueBins;
+    auto At = [Table](int32 d, int32 v) { return Table[d * NumValueBins + v]; };
+    const FVector2f G = FMath::Lerp(FMath::Lerp(At(D0, V0), At(D0 + 1, V0), Fd), FMath::Lerp(At(D0, V0 + 1), At(D0 + 1, V0 + 1), Fd), Fv);
+
+    OutV = (Query.Goal == EKickGoal::LaunchSpeed) ? Value : G.X;
+    OutPhi = G.Y;
+}
+
+// ---------------- Forward model ----------------
+void FKickSolver::Simulate(const FKickQuery& Query, const float* V, const float* Phi, const float* Psi, const float* Side,
+                           const float* H, const float* Z0, const float* TAt, FLaneResult& Out) const
+{
+    // Launch in the kick's frame: x towards the target, y left, z up
+    alignas(16) float Vx0[4], Vy0[4], Vz0[4], Back0[4];
+    for (int32 Lane = 0; Lane < 4; ++Lane)
+    {
+        float SinPhi, CosPhi, SinPsi, CosPsi;
+        FMath::SinCos(&SinPhi, &CosPhi, Phi[Lane]);
+        FMath::SinCos(&SinPsi, &CosPsi, Psi[Lane]);
+        Vx0[Lane] = V[Lane] * CosPhi * CosPsi;
+        Vy0[Lane] = V[Lane] * CosPhi * SinPsi;
+        Vz0[Lane] = V[Lane] * SinPhi;
+        Back0[Lane] = Query.bGround ? 0.f : Params.LoftBackspin * V[Lane];
+    }
+
+    const float Dt = FMath::Max(Params.Step, 1.e-3f);
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = VectorOneFloat();
+    const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+    const VectorRegister4Float AllLanes = VectorCompareEQ(Zero, Zero);
+    const VectorRegister4Float Tiny = VectorSetFloat1(KINDA_SMALL_NUMBER);
+    const VectorRegister4Float VDt = VectorSetFloat1(Dt);
+    const VectorRegister4Float HalfDt = VectorSetFloat1(0.5f * Dt);
+
+    const VectorRegister4Float Gravity = VectorSetFloat1(Ball.Gravity);
+    const VectorRegister4Float Drag = VectorSetFloat1(DragK);
+    const VectorRegister4Float Magnus = VectorSetFloat1(MagnusK);
+    const VectorRegister4Float SpinDecay = VectorSetFloat1(FMath::Exp(-Ball.SpinDecay * Dt));
+    const VectorRegister4Float Floor = VectorSetFloat1(GroundZ + Ball.Radius);
+    const VectorRegister4Float Radius = VectorSetFloat1(Ball.Radius);
+    const VectorRegister4Float SpinPerDv = VectorSetFloat1(1.5f / Ball.Radius);
+    const VectorRegister4Float Restitution = VectorSetFloat1(Ball.Restitution);
+    const VectorRegister4Float Friction = VectorSetFloat1(Ball.GroundFriction * (1.f + Ball.Restitution));
+    const VectorRegister4Float MaxSlipLoss = VectorSetFloat1(0.4f);
+    const VectorRegister4Float RollDecel = VectorSetFloat1(Ball.RollingResistance * Ball.Gravity);
+    const VectorRegister4Float RollSpeedZ = VectorSetFloat1(Ball.RollSpeedZ);
+    const VectorRegister4Float RestSpeed = VectorSetFloat1(Ball.RestSpeed);
+    const VectorRegister4Float Target = VectorLoad(H);
+    const VectorRegister4Float TimeAt = VectorLoad(TAt);
+
+    VectorRegister4Float X = Zero, Y = Zero, Z = VectorLoad(Z0);
+    VectorRegister4Float Vx = VectorLoad(Vx0), Vy = VectorLoad(Vy0), Vz = VectorLoad(Vz0);
+    VectorRegister4Float B = VectorLoad(Back0), S = VectorLoad(Side);
+    VectorRegister4Float Speed = VectorSqrt(VectorMultiplyAdd(Vx, Vx, VectorMultiplyAdd(Vy, Vy, VectorMultiply(Vz, Vz))));
+
+    VectorRegister4Float Rolling = Query.bGround ? AllLanes : Zero;
+    VectorRegister4Float Stopped = Zero;
+    VectorRegister4Float Crossed = Zero;
+    VectorRegister4Float PastT = VectorCompareLE(TimeAt, Zero);
+    VectorRegister4Float CrossT = Zero, CrossY = Zero, CrossZ = Zero, CrossSpeed = Zero;
+    VectorRegister4Float AtX = Zero, AtY = Zero, AtZ = Zero;
+    VectorRegister4Float Landed = Zero, LandX = Zero, LandSpeed = Zero;
+
+    // -k|v|v + k_m (w x v) - g, with w = (0, -B, S): backspin lifts, side spin curls
+    auto AirAccel = [&](const VectorRegister4Float& Ux, const VectorRegister4Float& Uy, const VectorRegister4Float& Uz,
+                        VectorRegister4Float& Ax, VectorRegister4Float& Ay, VectorRegister4Float& Az)
+        {
+            const VectorRegister4Float D = VectorMultiply(Drag, VectorSqrt(VectorMultiplyAdd(Ux, Ux, VectorMultiplyAdd(Uy, Uy, VectorMultiply(Uz, Uz)))));
+            Ax = VectorSubtract(VectorNegate(VectorMultiply(Magnus, VectorMultiplyAdd(B, Uz, VectorMultiply(S, Uy)))), VectorMultiply(D, Ux));
+            Ay = VectorSubtract(VectorMultiply(Magnus, VectorMultiply(S, Ux)), VectorMultiply(D, Uy));
+            Az = VectorSubtract(VectorSubtract(VectorMultiply(Magnus, VectorMultiply(B, Ux)), Gravity), VectorMultiply(D, Uz));
+        };
+
+    float Time = 0.f;
+    const int32 MaxSteps = FMath::CeilToInt(Params.MaxTime / Dt);
+    for (int32 Step = 0; Step < MaxSteps; ++Step)
+    {
+        const VectorRegister4Float Done = (Query.Goal == EKickGoal::ArrivalTime) ? VectorBitwiseOr(PastT, Stopped) : VectorBitwiseOr(Crossed, Stopped);
+        if (VectorMaskBits(Done) == 0xF) break;
+
+        // Air: midpoint rule
+        VectorRegister4Float Ax, Ay, Az;
+        AirAccel(Vx, Vy, Vz, Ax, Ay, Az);
+        const VectorRegister4Float Mx = VectorMultiplyAdd(Ax, HalfDt, Vx);
+        const VectorRegister4Float My = VectorMultiplyAdd(Ay, HalfDt, Vy);
+        const VectorRegister4Float Mz = VectorMultiplyAdd(Az, HalfDt, Vz);
+        AirAccel(Mx, My, Mz, Ax, Ay, Az);
+        const VectorRegister4Float AirX = VectorMultiplyAdd(Mx, VDt, X);
+        const VectorRegister4Float AirY = VectorMultiplyAdd(My, VDt, Y);
+        VectorRegister4Float AirZ = VectorMultiplyAdd(Mz, VDt, Z);
+        VectorRegister4Float AirVx = VectorMultiplyAdd(Ax, VDt, Vx);
+        VectorRegister4Float AirVy = VectorMultiplyAdd(Ay, VDt, Vy);
+        VectorRegister4Float AirVz = VectorMultiplyAdd(Az, VDt, Vz);
+
+        // Bounce: friction on the contact slip (hollow sphere, at most 2/5 of it), restitution on the normal
+        const VectorRegister4Float Hit = VectorSelect(Rolling, Zero, VectorBitwiseAnd(VectorCompareLE(AirZ, Floor), VectorCompareLT(AirVz, Zero)));
+        const VectorRegister4Float FirstLanding = VectorSelect(VectorBitwiseOr(Landed, Crossed), Zero, Hit);
+        LandX = VectorSelect(FirstLanding, AirX, LandX);
+        LandSpeed = VectorSelect(FirstLanding, VectorSqrt(VectorMultiplyAdd(AirVx, AirVx, VectorMultiplyAdd(AirVy, AirVy, VectorMultiply(AirVz, AirVz)))), LandSpeed);
+        Landed = VectorBitwiseOr(Landed, FirstLanding);
+        const VectorRegister4Float SlipX = VectorMultiplyAdd(Radius, B, AirVx);
+        const VectorRegister4Float Slip = VectorSqrt(VectorMultiplyAdd(SlipX, SlipX, VectorMultiply(AirVy, AirVy)));
+        const VectorRegister4Float Loss = VectorMin(VectorMultiply(Friction, VectorAbs(AirVz)), VectorMultiply(MaxSlipLoss, Slip));
+        const VectorRegister4Float LossScale = VectorDivide(Loss, VectorMax(Slip, Tiny));
+        const VectorRegister4Float Dvx = VectorNegate(VectorMultiply(SlipX, LossScale));
+        const VectorRegister4Float Rebound = VectorNegate(VectorMultiply(Restitution, AirVz));
+        const VectorRegister4Float Settle = VectorBitwiseAnd(Hit, VectorCompareLT(Rebound, RollSpeedZ));
+        B = VectorSelect(Hit, VectorMultiplyAdd(SpinPerDv, Dvx, B), B);
+        AirVx = VectorSelect(Hit, VectorAdd(AirVx, Dvx), AirVx);
+        AirVy = VectorSelect(Hit, VectorSubtract(AirVy, VectorMultiply(AirVy, LossScale)), AirVy);
+        AirVz = VectorSelect(Hit, VectorSelect(Settle, Zero, Rebound), AirVz);
+        AirZ = VectorSelect(Hit, Floor, AirZ);
+
+        // Rolling: resistance plus drag against the motion, midpoint speed
+        const VectorRegister4Float Roll = VectorSqrt(VectorMultiplyAdd(Vx, Vx, VectorMultiply(Vy, Vy)));
+        const VectorRegister4Float RollMid = VectorMax(VectorSubtract(Roll, VectorMultiply(VectorMultiplyAdd(Drag, VectorMultiply(Roll, Roll), RollDecel), HalfDt)), Zero);
+        VectorRegister4Float RollNew = VectorMax(VectorSubtract(Roll, VectorMultiply(VectorMultiplyAdd(Drag, VectorMultiply(RollMid, RollMid), RollDecel), VDt)), Zero);
+        RollNew = VectorSelect(VectorCompareLE(RollNew, RestSpeed), Zero, RollNew);
+        const VectorRegister4Float Keep = VectorDivide(RollNew, VectorMax(Roll, Tiny));
+        const VectorRegister4Float Travel = VectorMultiply(VectorMultiply(VectorAdd(One, Keep), Half), VDt);
+
+        const VectorRegister4Float PrevX = X, PrevY = Y, PrevZ = Z, PrevSpeed = Speed;
+        X = VectorSelect(Rolling, VectorMultiplyAdd(Vx, Travel, X), AirX);
+        Y = VectorSelect(Rolling, VectorMultiplyAdd(Vy, Travel, Y), AirY);
+        Z = VectorSelect(Rolling, Z, AirZ);
+        Vx = VectorSelect(Rolling, VectorMultiply(Vx, Keep), AirVx);
+        Vy = VectorSelect(Rolling, VectorMultiply(Vy, Keep), AirVy);
+        Vz = VectorSelect(Rolling, Zero, AirVz);
+        Stopped = VectorBitwiseAnd(Rolling, VectorCompareLE(RollNew, Zero));
+        Rolling = VectorBitwiseOr(Rolling, Settle);
+        B = VectorMultiply(B, SpinDecay);
+        S = VectorMultiply(S, SpinDecay);
+        Speed = VectorSqrt(VectorMultiplyAdd(Vx, Vx, VectorMultiplyAdd(Vy, Vy, VectorMultiply(Vz, Vz))));
+
+        const VectorRegister4Float PrevTime = VectorSetFloat1(Time);
+        Time += Dt;
+
+        // Through the target's distance this step
+        const VectorRegister4Float Cross = VectorSelect(Crossed, Zero, VectorCompareGE(X, Target));
+        const VectorRegister4Float F = VectorDivide(VectorSubtract(Target, PrevX), VectorMax(VectorSubtract(X, PrevX), Tiny));
+        CrossT = VectorSelect(Cross, VectorMultiplyAdd(F, VDt, PrevTime), CrossT);
+        CrossY = VectorSelect(Cross, LerpLanes(PrevY, Y, F), CrossY);
+        CrossZ = VectorSelect(Cross, LerpLanes(PrevZ, Z, F), CrossZ);
+        CrossSpeed = VectorSelect(Cross, LerpLanes(PrevSpeed, Speed, F), CrossSpeed);
+        Crossed = VectorBitwiseOr(Crossed, Cross);
+
+        // Past the goal's time this step
+        const VectorRegister4Float Due = VectorSelect(PastT, Zero, VectorCompareGE(VectorSetFloat1(Time), TimeAt));
+        const VectorRegister4Float G = VectorDivide(VectorSubtract(TimeAt, PrevTime), VDt);
+        AtX = VectorSelect(Due, LerpLanes(PrevX, X, G), AtX);
+        AtY = VectorSelect(Due, LerpLanes(PrevY, Y, G), AtY);
+        AtZ = VectorSelect(Due, LerpLanes(PrevZ, Z, G), AtZ);
+        PastT = VectorBitwiseOr(PastT, Due);
+    }
+
+    // Short of the target, or stopped before the time: where the ball ended up
+    const VectorRegister4Float TimeNow = VectorSetFloat1(Time);
+    VectorStore(VectorSelect(Crossed, CrossT, TimeNow), Out.CrossT);
+    VectorStore(VectorSelect(Crossed, CrossY, Y), Out.CrossY);
+    // Lofted kicks aim at the target on the first flight. One that lands short counts as that far
+    // below the pitch at the target, and at its landing speed, so both keep moving smoothly past the bounce.
+    const VectorRegister4Float Short = VectorSubtract(Floor, VectorSubtract(Target, LandX));
+    VectorStore(VectorSelect(Landed, Short, VectorSelect(Crossed, CrossZ, Z)), Out.CrossZ);
+    VectorStore(VectorSelect(Landed, LandSpeed, VectorSelect(Crossed, CrossSpeed, Speed)), Out.CrossSpeed);
+    VectorStore(VectorSelect(Crossed, Target, X), Out.EndX);
+    VectorStore(VectorSelect(PastT, AtX, X), Out.AtX);
+    VectorStore(VectorSelect(PastT, AtY, Y), Out.AtY);
+    VectorStore(VectorSelect(PastT, AtZ, Z), Out.AtZ);
+    Out.ReachedMask = VectorMaskBits(Crossed);
+}
+
+// ---------------- Newton ----------------
+void FKickSolver::SolveGroup(const FKickQuery& Query, const FKickTarget* Targets, int32 Num, const float* GuessV, const float* GuessPhi,
+                             int32 MaxIterations, FKickSolution* Out) const
+{
+    const bool bSolveSpeed = Query.Goal != EKickGoal::LaunchSpeed;
+    const bool bSolvePhi = !Query.bGround;
+    const bool bUsesCross = Query.Goal != EKickGoal::ArrivalTime;
+    const float MinSpeed = Query.MinSpeed > 0.f ? Query.MinSpeed : Params.MinSpeed;
+    const float MaxSpeed = FMath::Max(Query.MaxSpeed > 0.f ? Query.MaxSpeed : Params.MaxSpeed, MinSpeed);
+    const float MaxPhi = FMath::DegreesToRadians(Params.MaxElevationDeg);
+    const float Floor = GroundZ + Ball.Radius;
+
+    alignas(16) float V[4], Phi[4], Psi[4], Side[4], H[4], Z0[4], ZT[4], TAt[4];
+    FVector Dir[4];
+    bool bActive[4];
+    for (int32 Lane = 0; Lane < 4; ++Lane)
+    {
+        // Spare lanes repeat the last target; their results are dropped
+        const FKickTarget& T = Targets[FMath::Min(Lane, Num - 1)];
+        const FVector Flat(T.To.X - T.From.X, T.To.Y - T.From.Y, 0.f);
+        H[Lane] = static_cast<float>(Flat.Size());
+        Dir[Lane] = H[Lane] > KINDA_SMALL_NUMBER ? Flat / H[Lane] : FVector::ForwardVector;
+        Z0[Lane] = Query.bGround ? Floor : FMath::Max(static_cast<float>(T.From.Z), Floor);
+        ZT[Lane] = Query.bGround ? Floor : FMath::Max(static_cast<float>(T.To.Z), Floor);
+        TAt[Lane] = (Query.Goal == EKickGoal::ArrivalTime) ? FMath::Max(T.Value, Params.Step) : 0.f;
+        V[Lane] = bSolveSpeed ? FMath::Clamp(GuessV[Lane], MinSpeed, MaxSpeed) : FMath::Max(T.Value, 0.f);
+        Phi[Lane] = bSolvePhi ? FMath::Clamp(GuessPhi[Lane], 0.f, MaxPhi) : 0.f;
+        Psi[Lane] = 0.f;
+        Side[Lane] = Query.bGround ? 0.f : T.SideSpin;
+
+        // Nothing to solve for a target under the ball
+        bActive[Lane] = Lane < Num && H[Lane] >= 1.f;
+        if (Lane < Num) Out[Lane] = FKickSolution();
+    }
+
+    // The goal's residuals: R0 is the one the speed moves most (the elevation for LaunchSpeed), R1 the height; Miss is sideways
+    auto Residuals = [&](const FLaneResult& R, int32 Lane, float& R0, float& R1, float& Miss)
+        {
+            const FKickTarget& T = Targets[FMath::Min(Lane, Num - 1)];
+            switch (Query.Goal)
+            {
+            case EKickGoal::LaunchSpeed:  R0 = R.CrossZ[Lane] - ZT[Lane]; R1 = 0.f; Miss = R.CrossY[Lane]; break;
+            case EKickGoal::ArrivalTime:  R0 = R.AtX[Lane] - H[Lane]; R1 = R.AtZ[Lane] - ZT[Lane]; Miss = R.AtY[Lane]; break;
+            default:                      R0 = R.CrossSpeed[Lane] - T.Value; R1 = R.CrossZ[Lane] - ZT[Lane]; Miss = R.CrossY[Lane]; break;
+            }
+        };
+
+    FLaneResult Base, ProbeV, ProbeP;
+    alignas(16) float Probe[4];
+    for (int32 Iter = 0; ; ++Iter)
+    {
+        Simulate(Query, V, Phi, Psi, Side, H, Z0, TAt, Base);
+
+        bool bAllDone = true;
+        for (int32 Lane = 0; Lane < Num; ++Lane)
+        {
+            if (!bActive[Lane]) continue;
+
+            float R0, R1, Miss;
+            Residuals(Base, Lane, R0, R1, Miss);
+            const bool bReached = !bUsesCross || Base.Reached(Lane);
+            bool bOk = bReached && FMath::Abs(Miss) <= Params.Tolerance;
+            switch (Query.Goal)
+            {
+            case EKickGoal::LaunchSpeed:  bOk &= !bSolvePhi || FMath::Abs(R0) <= Params.Tolerance; break;
+            case EKickGoal::ArrivalTime:  bOk &= FMath::Abs(R0) <= Params.Tolerance && (!bSolvePhi || FMath::Abs(R1) <= Params.Tolerance); break;
+            default:                      bOk &= FMath::Abs(R0) <= Params.SpeedTolerance && (!bSolvePhi || FMath::Abs(R1) <= Params.Tolerance); break;
+            }
+            Out[Lane].Iterations = Iter;
+            Out[Lane].bConverged = bOk;
+            if (bOk) bActive[Lane] = false;
+            else bAllDone = false;
+        }
+        if (bAllDone || Iter >= MaxIterations || (!bSolveSpeed && !bSolvePhi)) break;
+
+        // Jacobian columns by forward differences
+        if (bSolveSpeed)
+        {
+            for (int32 Lane = 0; Lane < 4; ++Lane) Probe[Lane] = V[Lane] + SpeedProbe;
+            Simulate(Query, Probe, Phi, Psi, Side, H, Z0, TAt, ProbeV);
+        }
+        if (bSolvePhi)
+        {
+            for (int32 Lane = 0; Lane < 4; ++Lane) Probe[Lane] = Phi[Lane] + ElevationProbe;
+            Simulate(Query, V, Probe, Psi, Side, H, Z0, TAt, ProbeP);
+        }
+
+        for (int32 Lane = 0; Lane < Num; ++Lane)
+        {
+            if (!bActive[Lane]) continue;
+
+            // Short of the target: more speed, or more loft towards the longest range, before Newton can help
+            if (bUsesCross && !Base.Reached(Lane))
+            {
+                if (bSolveSpeed) V[Lane] = FMath::Min(V[Lane] * 1.25f, MaxSpeed);
+                if (bSolvePhi && !bSolveSpeed) Phi[Lane] = FMath::Min(Phi[Lane] + 0.5f * (0.6f - Phi[Lane]), MaxPhi);
+                continue;
+            }
+
+            float R0, R1, Miss;
+            Residuals(Base, Lane, R0, R1, Miss);
+            float DV = 0.f, DPhi = 0.f;
+            if (bSolveSpeed && bSolvePhi)
+            {
+                float A0, A1, AMiss, P0, P1, PMiss;
+                Residuals(ProbeV, Lane, A0, A1, AMiss);
+                Residuals(ProbeP, Lane, P0, P1, PMiss);
+                const float J00 = (A0 - R0) / SpeedProbe, J10 = (A1 - R1) / SpeedProbe;
+                const float J01 = (P0 - R0) / ElevationProbe, J11 = (P1 - R1) / ElevationProbe;
+                const float Det = J00 * J11 - J01 * J10;
+                if (FMath::Abs(Det) > 1.e-3f * (FMath::Abs(J00 * J11) + FMath::Abs(J01 * J10)) + KINDA_SMALL_NUMBER)
+                {
+                    DV = (R1 * J01 - R0 * J11) / Det;
+                    DPhi = (R0 * J10 - R1 * J00) / Det;
+                }
+                else
+                {
+                    // Rolling through the target: the height says nothing, solve each on its own
+                    DV = FMath::Abs(J00) > KINDA_SMALL_NUMBER ? -R0 / J00 : 0.f;
+                    DPhi = FMath::Abs(J11) > KINDA_SMALL_NUMBER ? -R1 / J11 : 0.f;
+                }
+            }
+            else if (bSolveSpeed)
+            {
+                float A0, A1, AMiss;
+                Residuals(ProbeV, Lane, A0, A1, AMiss);
+                const float J = (A0 - R0) / SpeedProbe;
+                DV = FMath::Abs(J) > KINDA_SMALL_NUMBER ? -R0 / J : 0.f;
+            }
+            else
+            {
+                float P0, P1, PMiss;
+                Residuals(ProbeP, Lane, P0, P1, PMiss);
+                const float J = (P0 - R0) / ElevationProbe;
+                DPhi = FMath::Abs(J) > KINDA_SMALL_NUMBER ? -R0 / J : 0.f;
+            }
+
+            const float MaxDV = 0.5f * V[Lane] + 100.f;
+            V[Lane] = bSolveSpeed ? FMath::Clamp(V[Lane] + FMath::Clamp(DV, -MaxDV, MaxDV), MinSpeed, MaxSpeed) : V[Lane];
+            Phi[Lane] = bSolvePhi ? FMath::Clamp(Phi[Lane] + FMath::Clamp(DPhi, -MaxElevationStep, MaxElevationStep), 0.f, MaxPhi) : 0.f;
+            // Curl: turn the aim by the angle of the sideways miss
+            Psi[Lane] -= FMath::Atan2(Miss, H[Lane]);
+        }
+    }
+
+    // Last simulation is of the returned kick
+    for (int32 Lane = 0; Lane < Num; ++Lane)
+    {
+        FKickSolution& S = Out[Lane];
+        if (H[Lane] < 1.f)
+        {
+            S.bReached = S.bConverged = true;
+            continue;
+        }
+
+        float R0, R1, Miss;
+        Residuals(Base, Lane, R0, R1, Miss);
+        const FVector Aim = Dir[Lane] * FMath::Cos(Psi[Lane]) + FVector::CrossProduct(FVector::UpVector, Dir[Lane]) * FMath::Sin(Psi[Lane]);
+        const FVector Left = FVector::CrossProduct(FVector::UpVector, Aim);
+
+        S.Speed = V[Lane];
+        S.Elevation = Phi[Lane];
+        S.Velocity = Aim * (V[Lane] * FMath::Cos(Phi[Lane])) + FVector::UpVector * (V[Lane] * FMath::Sin(Phi[Lane]));
+        // Ground kicks leave rolling; lofted ones with the backspin the model assumed
+        S.Spin = Query.bGround ? FVector::CrossProduct(FVector::UpVector, S.Velocity) / Ball.Radius
+                               : Left * (-Params.LoftBackspin * V[Lane]) + FVector::UpVector * Side[Lane];
+        S.bReached = Base.Reached(Lane);
+        S.Time = (Query.Goal == EKickGoal::ArrivalTime) ? TAt[Lane] : Base.CrossT[Lane];
+        S.ArrivalSpeed = Base.CrossSpeed[Lane];
+
+        const float Height = (Query.Goal == EKickGoal::LaunchSpeed) ? R0 : (bSolvePhi ? R1 : 0.f);
+        const float Along = (Query.Goal == EKickGoal::ArrivalTime) ? R0 : H[Lane] - Base.EndX[Lane];
+        S.Error = FMath::Sqrt(Height * Height + Along * Along + Miss * Miss);
+    }
+}
+
+// ---------------- Solve ----------------
+void FKickSolver::Solve(const FKickQuery& Query, TConstArrayView<FKickTarget> Targets, TArrayView<FKickSolution> Out) const
+{
+    OSF_SCOPE(KickSolve);
+    check(Out.Num() >= Targets.Num());
+
+    float GuessV[4], GuessPhi[4];
+    for (int32 i = 0; i < Targets.Num(); i += 4)
+    {
+        const int32 Num = FMath::Min(4, Targets.Num() - i);
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            // The tables are for ground-level targets; tilt the guess by the rise to a raised one
+            const FKickTarget& T = Targets[i + FMath::Min(Lane, Num - 1)];
+            const float H = static_cast<float>(FVector::Dist2D(T.From, T.To));
+            Guess(Query, H, T.Value, GuessV[Lane], GuessPhi[Lane]);
+            if (!Query.bGround) GuessPhi[Lane] += FMath::Atan2(static_cast<float>(T.To.Z - T.From.Z), FMath::Max(H, 1.f));
+        }
+        SolveGroup(Query, Targets.GetData() + i, Num, GuessV, GuessPhi, Params.MaxIterations, Out.GetData() + i);
+    }
+}
+
+FKickSolution FKickSolver::Solve(const FKickQuery& Query, const FKickTarget& Target) const
+{
+    FKickSolution Result;
+    Solve(Query, MakeArrayView(&Target, 1), MakeArrayView(&Result, 1));
+    return Result;
+}
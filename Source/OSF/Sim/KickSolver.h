@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sim/BallFlight.h"
+
+/** What the kick has to achieve besides reaching the target. */
+enum class EKickGoal : uint8
+{
+    LaunchSpeed,    // FKickTarget::Value is the speed off the boot; solve the elevation
+    ArrivalTime,    // Value is the time to the target (s); solve speed and elevation
+    ArrivalSpeed,   // Value is the ball speed at the target; solve speed and elevation
+};
+
+/** Shared by every target of one Solve call. */
+struct FKickQuery
+{
+    EKickGoal Goal = EKickGoal::ArrivalSpeed;
+    bool bGround = false;     // keep the ball on the pitch: elevation 0, speed only
+    float MinSpeed = 0.f;     // launch speed limits; 0 = the solver's
+    float MaxSpeed = 0.f;
+};
+
+struct FKickTarget
+{
+    FVector From = FVector::ZeroVector;  // ball centre now
+    FVector To = FVector::ZeroVector;    // ball centre on arrival (Z ignored for ground kicks)
+    float Value = 0.f;                   // per EKickGoal
+    float SideSpin = 0.f;                // rad/s about +Z, curls left when positive; the aim allows for it
+};
+
+struct FKickSolution
+{
+    FVector Velocity = FVector::ZeroVector;
+    FVector Spin = FVector::ZeroVector;  // rad/s, world axes; for UBallFlightComponent::Launch
+    float Speed = 0.f;
+    float Elevation = 0.f;     // rad
+    float Time = 0.f;          // s until the ball reaches the target's distance (the goal's time for ArrivalTime)
+    float ArrivalSpeed = 0.f;
+    float Error = 0.f;         // cm from the target when it gets there
+    int32 Iterations = 0;
+    bool bReached = false;     // the ball gets as far as the target at all
+    bool bConverged = false;   // every residual of the goal within tolerance
+};
+
+struct FKickSolverParams
+{
+    float MinSpeed = 200.f;
+    float MaxSpeed = 3500.f;
+    float MaxElevationDeg = 60.f;
+    float LoftBackspin = 0.01f;    // rad/s of backspin per cm/s of a lofted kick
+
+    float Step = 1.f / 30.f;       // forward model step (s), midpoint rule
+    float MaxTime = 5.f;           // flights are followed this long at most
+    int32 MaxIterations = 8;
+
+    float Tolerance = 5.f;         // cm
+    float SpeedTolerance = 10.f;   // cm/s
+    float MaxDistance = 6000.f;    // range of the warm-start tables
+};
+
+/**
+ * Inverse kick: the launch speed, elevation, aim and spin that put the ball
+ * at a target, with a given launch speed, arrival time or arrival speed.
+ *
+ * The forward model is FBallFlight's (quadratic drag, Magnus lift from
+ * backspin and curl from side spin, bounces with friction, rolling with
+ * resistance and drag) in the vertical plane of the kick, without the goal
+ * frame, on a coarser fixed step. Newton iteration with finite-difference
+ * Jacobians drives the goal's residuals to zero; the aim is corrected for
+ * curl from the sideways miss on the same pass.
+ *
+ * Targets go four per SIMD register through the forward model. First guesses
+ * come from tables Configure builds over distance and goal value by solving
+ * its own grid, so a typical target converges in two or three iterations.
+ * Solve is const and allocation-free; one solver serves every evaluator.
+ */
+class OSF_API FKickSolver
+{
+public:
+    static constexpr int32 NumDistBins = 16;
+    static constexpr int32 NumValueBins = 8;
+
+    FKickSolverParams Params;
+
+    /** The ball to aim (usually the flight component's model); builds the warm-start tables. */
+    void Configure(const FBallParams& InBall, float InGroundZ);
+    bool IsConfigured() const { return Guesses.Num() > 0; }
+    const FBallParams& GetBall() const { return Ball; }
+
+    /** One solution per target; Out must be at least as long as Targets. */
+    void Solve(const FKickQuery& Query, TConstArrayView<FKickTarget> Targets, TArrayView<FKickSolution> Out) const;
+
+    FKickSolution Solve(const FKickQuery& Query, const FKickTarget& Target) const;
+
+private:
+    struct FLaneResult;
+
+    void SolveGroup(const FKickQuery& Query, const FKickTarget* Targets, int32 Num, const float* GuessV, const float* GuessPhi,
+                    int32 MaxIterations, FKickSolution* Out) const;
+    void Simulate(const FKickQuery& Query, const float* V, const float* Phi, const float* Psi, const float* Side,
+                  const float* H, const float* Z0, const float* TAt, FLaneResult& Out) const;
+
+    void Guess(const FKickQuery& Query, float H, float Value, float& OutV, float& OutPhi) const;
+    void ColdGuess(const FKickQuery& Query, float H, float Value, float& OutV, float& OutPhi) const;
+    static void ValueRange(EKickGoal Goal, const FKickSolverParams& P, float& OutMin, float& OutMax);
+    static int32 TableIndex(EKickGoal Goal, bool bGround) { return static_cast<int32>(Goal) * 2 + (bGround ? 1 : 0); }
+
+    FBallParams Ball;
+    float GroundZ = 0.f;
+
+    // Derived from Ball in Configure
+    float DragK = 0.f;     // 1/cm
+    float MagnusK = 0.f;
+
+    // [Goal * 2 + Ground][Dist][Value] = (speed, elevation)
+    TArray<FVector2f> Guesses;
+};
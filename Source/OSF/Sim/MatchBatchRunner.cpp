@@ -0,0 +1,149 @@
+#include "Sim/MatchBatchRunner.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Parse.h"
+
+int32 FMatchBatchRunner::SeedFor(int32 BaseSeed, int32 MatchIndex)
+{
+    return static_cast<int32>(HashCombine(GetTypeHash(BaseSeed), GetTypeHash(MatchIndex)));
+}
+
+void FMatchBatchRunner::Run(const FPointMassConfig& Config, int32 NumMatches, int32 BaseSeed,
+                            TArray<FPointMassResult>& OutResults, FMatchBatchSummary* OutSummary)
+{
+    const double Start = FPlatformTime::Seconds();
+
+    OutResults.Reset();
+    OutResults.SetNum(FMath::Max(NumMatches, 0));
+
+    ParallelFor(TEXT("OSF.MatchBatch"), OutResults.Num(), 1, [&](int32 i)
+        {
+            FPointMassMatch Match(Config);
+            Match.Run(SeedFor(BaseSeed, i), OutResults[i]);
+        }, EParallelForFlags::Unbalanced);
+
+    if (OutSummary)
+    {
+        *OutSummary = Summarise(OutResults);
+        OutSummary->WallSeconds = FPlatformTime::Seconds() - Start;
+    }
+}
+
+FMatchBatchSummary FMatchBatchRunner::Summarise(TConstArrayView<FPointMassResult> Results)
+{
+    FMatchBatchSummary S;
+    S.NumMatches = Results.Num();
+    if (S.NumMatches == 0) return S;
+
+    double Controlled[2] = { 0.0, 0.0 };
+    for (const FPointMassResult& R : Results)
+    {
+        for (int32 TeamID = 0; TeamID < 2; ++TeamID)
+        {
+            S.MeanGoals[TeamID] += R.Goals[TeamID];
+            S.MeanShots[TeamID] += R.Shots[TeamID];
+            Controlled[TeamID] += R.PossessionSeconds[TeamID + 1];
+        }
+        if (R.Goals[0] > R.Goals[1]) S.WinRate[0] += 1.0;
+        else if (R.Goals[1] > R.Goals[0]) S.WinRate[1] += 1.0;
+        else S.DrawRate += 1.0;
+    }
+
+    const double Inv = 1.0 / S.NumMatches;
+    const double ControlledTotal = FMath::Max(Controlled[0] + Controlled[1], UE_SMALL_NUMBER);
+    for (int32 TeamID = 0; TeamID < 2; ++TeamID)
+    {
+        S.MeanGoals[TeamID] *= Inv;
+        S.MeanShots[TeamID] *= Inv;
+        S.WinRate[TeamID] *= Inv;
+        S.PossessionShare[TeamID] = Controlled[TeamID] / ControlledTotal;
+    }
+    S.DrawRate *= Inv;
+    return S;
+}
+
+// ---------------- Console ----------------
+namespace
+{
+    /** "A.HomeWeight=0.5" sets team 0, "B." team 1, no prefix both. */
+    void ParseTacticOverrides(const FString& Args, FPointMassConfig& Config)
+    {
+        struct FField { const TCHAR* Name; float FTacticParams::* Member; };
+        static const FField Fields[] =
+        {
+            { TEXT("HomeWeight"),         &FTacticParams::HomeWeight },
+            { TEXT("AdvanceWithBall"),    &FTacticParams::AdvanceWithBall },
+            { TEXT("RetreatWithBall"),    &FTacticParams::RetreatWithBall },
+            { TEXT("SupportAhead"),       &FTacticParams::SupportAhead },
+            { TEXT("SupportWide"),        &FTacticParams::SupportWide },
+            { TEXT("SpaceSearch"),        &FTacticParams::SpaceSearch },
+            { TEXT("SeparationStrength"), &FTacticParams::SeparationStrength },
+            { TEXT("KeeperDepth"),        &FTacticParams::KeeperDepth },
+            { TEXT("KeeperChaseRadius"),  &FTacticParams::KeeperChaseRadius },
+            { TEXT("MarkSwitchPenalty"),  &FTacticParams::MarkSwitchPenalty },
+        };
+
+        for (const FField& F : Fields)
+        {
+            float Value;
+            if (FParse::Value(*Args, *FString::Printf(TEXT(" %s="), F.Name), Value))
+            {
+                Config.Tactics[0].*F.Member = Value;
+                Config.Tactics[1].*F.Member = Value;
+            }
+            if (FParse::Value(*Args, *FString::Printf(TEXT("A.%s="), F.Name), Value)) Config.Tactics[0].*F.Member = Value;
+            if (FParse::Value(*Args, *FString::Printf(TEXT("B.%s="), F.Name), Value)) Config.Tactics[1].*F.Member = Value;
+        }
+    }
+
+    void RunBatchCommand(const TArray<FString>& Args)
+    {
+        const FString Joined = TEXT(" ") + FString::Join(Args, TEXT(" "));
+
+        FPointMassConfig Config;
+        int32 Matches = 100;
+        int32 Seed = 1;
+        FParse::Value(*Joined, TEXT("Matches="), Matches);
+        FParse::Value(*Joined, TEXT("Seed="), Seed);
+        FParse::Value(*Joined, TEXT("Duration="), Config.Duration);
+        FParse::Value(*Joined, TEXT("Dt="), Config.Dt);
+        FParse::Value(*Joined, TEXT("PlayersPerTeam="), Config.PlayersPerTeam);
+        ParseTacticOverrides(Joined, Config);
+
+        // ZoneSlide=x: held shape from ball-zone tables baked once per team and shared by every match
+        FFormationZones Zones[2];
+        FFormationZoneBake Bake;
+        if (FParse::Value(*Joined, TEXT("ZoneSlide="), Bake.SlideX))
+        {
+            Bake.SlideY = Bake.SlideX;
+            TArray<FVector> Formation;
+            FMatchKernel::MakeDefaultFormation(Config.Tactics[0].HalfLength, Formation);
+            for (int32 TeamID = 0; TeamID < 2; ++TeamID)
+            {
+                FTacticParams Tactics = Config.Tactics[TeamID];
+                Tactics.HalfLength = Config.Tactics[0].HalfLength;
+                Tactics.HalfWidth = Config.Tactics[0].HalfWidth;
+                Zones[TeamID].Bake(Tactics, Formation, Config.PlayersPerTeam, Bake);
+                Config.Zones[TeamID] = &Zones[TeamID];
+            }
+        }
+
+        TArray<FPointMassResult> Results;
+        FMatchBatchSummary S;
+        FMatchBatchRunner::Run(Config, Matches, Seed, Results, &S);
+
+        UE_LOG(LogTemp, Display, TEXT("MatchBatch: %d matches in %.2f s (%.1f/s)"),
+            S.NumMatches, S.WallSeconds, S.WallSeconds > 0.0 ? S.NumMatches / S.WallSeconds : 0.0);
+        UE_LOG(LogTemp, Display, TEXT("  A: goals %.2f  shots %.1f  possession %.1f%%  wins %.1f%%"),
+            S.MeanGoals[0], S.MeanShots[0], 100.0 * S.PossessionShare[0], 100.0 * S.WinRate[0]);
+        UE_LOG(LogTemp, Display, TEXT("  B: goals %.2f  shots %.1f  possession %.1f%%  wins %.1f%%"),
+            S.MeanGoals[1], S.MeanShots[1], 100.0 * S.PossessionShare[1], 100.0 * S.WinRate[1]);
+        UE_LOG(LogTemp, Display, TEXT("  draws %.1f%%"), 100.0 * S.DrawRate);
+    }
+
+    FAutoConsoleCommand GMatchBatchCommand(
+        TEXT("osf.Sim.Batch"),
+        TEXT("Offline point-mass matches: Matches=N Seed=S Duration=s Dt=s PlayersPerTeam=N ZoneSlide=x [A.|B.]HomeWeight=x ..."),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunBatchCommand));
+}
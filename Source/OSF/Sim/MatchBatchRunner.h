@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Sim/PointMassMatch.h"
+
+struct FMatchBatchSummary
+{
+    int32  NumMatches = 0;
+    double WallSeconds = 0.0;
+    double MeanGoals[2] = { 0.0, 0.0 };
+    double MeanShots[2] = { 0.0, 0.0 };
+    double PossessionShare[2] = { 0.0, 0.0 }; // of controlled time
+    double WinRate[2] = { 0.0, 0.0 };
+    double DrawRate = 0.0;
+};
+
+/**
+ * Runs many independent point-mass matches across the task graph.
+ *
+ * Each match owns its state and an FRandomStream seeded from (BaseSeed, match
+ * index), so results do not depend on thread count or scheduling. Matches are
+ * handed out one at a time (EParallelForFlags::Unbalanced), so idle workers pick
+ * up the remainder while long matches are still running.
+ */
+struct OSF_API FMatchBatchRunner
+{
+    static int32 SeedFor(int32 BaseSeed, int32 MatchIndex);
+
+    static void Run(const FPointMassConfig& Config, int32 NumMatches, int32 BaseSeed,
+                    TArray<FPointMassResult>& OutResults, FMatchBatchSummary* OutSummary = nullptr);
+
+    static FMatchBatchSummary Summarise(TConstArrayView<FPointMassResult> Results);
+};
@@ -0,0 +1,386 @@
+#include "Sim/MatchKernel.h"
+
+#include "MatchSnapshot.h"
+#include "SpatialHashGrid.h"
+#include "MarkingAssignment.h"
+#include "OSFStats.h"
+#include "Sim/PitchControl.h"
+#include "Sim/FormationSet.h"
+#include "Sim/FormationZones.h"
+#include "Sim/PassEvaluator.h"
+#include "Sim/ShotEvaluator.h"
+
+void FMatchKernel::MakeDefaultFormation(float HalfLength, TArray<FVector>& Out)
+{
+    Out.Empty(11);
+
+    // GK (index 0)
+    Out.Add(FVector(-HalfLength + 500.f, 0.f, 0.f)); // 0
+
+    // DEF
+    const float DefX = -HalfLength * 0.5f;
+    Out.Add(FVector(DefX, -1400.f, 0.f)); // 1
+    Out.Add(FVector(DefX, -400.f, 0.f)); // 2
+    Out.Add(FVector(DefX, +400.f, 0.f)); // 3
+    Out.Add(FVector(DefX, +1400.f, 0.f)); // 4
+
+    // MID
+    const float MidX = 0.f;
+    Out.Add(FVector(MidX, -1600.f, 0.f)); // 5
+    Out.Add(FVector(MidX, -500.f, 0.f)); // 6
+    Out.Add(FVector(MidX, 500.f, 0.f)); // 7
+    Out.Add(FVector(MidX, +1600.f, 0.f)); // 8
+
+    // FWD
+    const float FwdX = HalfLength * 0.35f;
+    Out.Add(FVector(FwdX, -800.f, 0.f)); // 9
+    Out.Add(FVector(FwdX, +800.f, 0.f)); // 10
+}
+
+// ---------------- Geometry ----------------
+FVector FMatchKernel::FormationSlot(TConstArrayView<FVector> Local, int32 SlotIdx)
+{
+    if (Local.IsValidIndex(SlotIdx)) return Local[SlotIdx];
+
+    // Oversized squads: reuse outfield slots, fanned out sideways per extra layer
+    const int32 NumOutfield = Local.Num() - 1;
+    if (SlotIdx <= 0 || NumOutfield <= 0) return FVector::ZeroVector;
+
+    const int32 Layer = (SlotIdx - 1) / NumOutfield;
+    FVector Out = Local[1 + (SlotIdx - 1) % NumOutfield];
+    Out.Y += ((Layer & 1) ? 1.f : -1.f) * 350.f * ((Layer + 1) / 2);
+    return Out;
+}
+
+FVector FMatchKernel::HomeWorld(int32 TeamID, int32 SlotIdx) const
+{
+    FVector L = FormationLocal(SlotIdx);
+    if (TeamID == 1) L = FVector(-L.X, -L.Y, L.Z);
+    return Tactics.FieldCentre + L;
+}
+
+FVector FMatchKernel::Home(int32 TeamID, int32 SlotIdx, EFormationShape Shape) const
+{
+    if (Formations && Formations->HasSlot(SlotIdx)) return Formations->Home(TeamID, SlotIdx, Shape);
+
+    FVector P = HomeWorld(TeamID, SlotIdx);
+    const float Dir = (TeamID == 0) ? +1.f : -1.f;
+    if (Shape == EFormationShape::Attack) P.X += Tactics.AdvanceWithBall * 0.5f * Dir;
+    if (Shape == EFormationShape::Defend) P.X -= Tactics.RetreatWithBall * 0.5f * Dir;
+    return Ground(ClampToField(P));
+}
+
+FVector FMatchKernel::ClampToField(const FVector& P) const
+{
+    FVector Out = P;
+    Out.X = FMath::Clamp(Out.X, Tactics.FieldCentre.X - Tactics.HalfLength, Tactics.FieldCentre.X + Tactics.HalfLength);
+    Out.Y = FMath::Clamp(Out.Y, Tactics.FieldCentre.Y - Tactics.HalfWidth, Tactics.FieldCentre.Y + Tactics.HalfWidth);
+    return Out;
+}
+
+FVector FMatchKernel::OwnGoalLocation(int32 TeamID) const
+{
+    const FVector& C = Tactics.FieldCentre;
+    const float X = C.X + ((TeamID == 0) ? -Tactics.HalfLength : +Tactics.HalfLength);
+    return FVector(X, C.Y, C.Z);
+}
+
+FVector FMatchKernel::SeekArriveDirection(const FVector& From, const FVector& To) const
+{
+    const FVector ToT = (To - From);
+    const float Dist = ToT.Size2D();
+    if (Dist < KINDA_SMALL_NUMBER) return FVector::ZeroVector;
+
+    const float Strength = (Dist > Tactics.ArriveRadius) ? 1.f : (Dist / Tactics.ArriveRadius);
+    return ToT.GetSafeNormal2D() * Strength;
+}
+
+FVector FMatchKernel::FindSpace(int32 TeamID, const FVector& P) const
+{
+    if (!Control || !Control->IsConfigured() || Tactics.SpaceSearch <= 0.f) return P;
+
+    constexpr float InvSqrt2 = 0.70710678f;
+    static const FVector2D Ring[8] =
+    {
+        { 1.f, 0.f }, { InvSqrt2, InvSqrt2 }, { 0.f, 1.f }, { -InvSqrt2, InvSqrt2 },
+        { -1.f, 0.f }, { -InvSqrt2, -InvSqrt2 }, { 0.f, -1.f }, { InvSqrt2, -InvSqrt2 },
+    };
+
+    // P keeps near-ties, so a run does not wander after small changes in the grid
+    FVector Best = P;
+    float BestScore = Control->Control(TeamID, P.X, P.Y) + 0.1f;
+    for (const FVector2D& Step : Ring)
+    {
+        const FVector Q = ClampToField(P + FVector(Step.X, Step.Y, 0.f) * Tactics.SpaceSearch);
+        const float Score = Control->Control(TeamID, Q.X, Q.Y);
+        if (Score > BestScore)
+        {
+            Best = Q;
+            BestScore = Score;
+        }
+    }
+    return Best;
+}
+
+FVector FMatchKernel::SeparationVector(const FMatchSnapshot& Snap, const FSpatialHashGrid& Grid, int32 SelfIdx, int32 TeamID) const
+{
+    if (!Snap.IsValidEntry(SelfIdx)) return FVector::ZeroVector;
+    const FVector MyPos = Snap.GetPos(SelfIdx);
+    const float R2 = Tactics.SeparationRadius * Tactics.SeparationRadius;
+    FVector Accum = FVector::ZeroVector;
+
+    TArray<int32, TInlineAllocator<32>> Near;
+    Grid.QueryRadius(TeamID, MyPos, Tactics.SeparationRadius, SelfIdx, Near);
+
+    for (int32 i : Near)
+    {
+        const FVector Delta = MyPos - Snap.GetPos(i);
+        const float D2 = FMath::Max(Delta.SizeSquared2D(), 1.f);
+        if (D2 < R2)
+        {
+            Accum += Delta.GetSafeNormal2D() * (R2 / D2);
+        }
+    }
+    return Accum;
+}
+
+void FMatchKernel::ComputeKeeperTarget(
+    int32 TeamID, const FVector& BallLoc,
+    FVector& OutGoal, FVector& OutKeeperHome, FVector& OutBoxMin, FVector& OutBoxMax) const
+{
+    OutGoal = OwnGoalLocation(TeamID);
+
+    const float Dir = (TeamID == 0) ? +1.f : -1.f;
+    const float BoxX0 = OutGoal.X + Dir * Tactics.PenBoxDepth;
+    OutBoxMin = FVector(FMath::Min(OutGoal.X, BoxX0), Tactics.FieldCentre.Y - Tactics.PenBoxHalfWidth, OutGoal.Z);
+    OutBoxMax = FVector(FMath::Max(OutGoal.X, BoxX0), Tactics.FieldCentre.Y + Tactics.PenBoxHalfWidth, OutGoal.Z);
+
+    const FVector ToBall = (BallLoc - OutGoal).GetSafeNormal2D();
+    FVector Candidate = OutGoal + ToBall * Tactics.KeeperDepth;
+    Candidate.X = FMath::Clamp(Candidate.X, OutBoxMin.X, OutBoxMax.X);
+    Candidate.Y = FMath::Clamp(Candidate.Y, OutBoxMin.Y, OutBoxMax.Y);
+
+    OutKeeperHome = Ground(ClampToField(Candidate));
+}
+
+// ---------------- Decisions ----------------
+int32 FMatchKernel::PickAttackingTeam(const FSpatialHashGrid& Grid, const FVector& BallLoc, int32 PossessingTeamID) const
+{
+    if (PossessingTeamID >= 0) return PossessingTeamID;
+
+    float D0 = TNumericLimits<float>::Max();
+    float D1 = TNumericLimits<float>::Max();
+    Grid.Nearest(0, BallLoc, nullptr, &D0);
+    Grid.Nearest(1, BallLoc, nullptr, &D1);
+    return (D0 <= D1) ? 0 : 1;
+}
+
+void FMatchKernel::PlanTeam(const FMatchSnapshot& Snap, const FSpatialHashGrid& Grid, int32 TeamID, bool bAttacking,
+                            FMarkingAssignment& Marking, FTeamPlan& Plan) const
+{
+    OSF_SCOPE(PlanTeam);
+    const FVector BallLoc = Snap.BallPos;
+    const int32 TeamBegin = Snap.TeamBegin[TeamID];
+    const int32 TeamCount = Snap.TeamEnd[TeamID] - TeamBegin;
+
+    Plan.bAttacking = bAttacking;
+
+    // Two first to the ball, else the two closest to where it is going
+    const int32 PrevFirst = Plan.Chasers[0];
+    Plan.Chasers[0] = Plan.Chasers[1] = INDEX_NONE;
+    if (Snap.bHasIntercepts)
+    {
+        Plan.Chasers[0] = Snap.Interceptor(TeamID, 0);
+        Plan.Chasers[1] = Snap.Interceptor(TeamID, 1);
+
+        // Keep the current first chaser on near-ties so a rolling ball does not flip them every plan
+        if (Snap.IsValidEntry(PrevFirst) && Snap.Team[PrevFirst] == TeamID && PrevFirst != Plan.Chasers[0] &&
+            Plan.Chasers[0] != INDEX_NONE &&
+            Snap.InterceptT[PrevFirst] <= Snap.InterceptT[Plan.Chasers[0]] + Tactics.ChaserHysteresis)
+        {
+            Plan.Chasers[1] = Plan.Chasers[0];
+            Plan.Chasers[0] = PrevFirst;
+        }
+    }
+    else
+    {
+        Grid.KNearest(TeamID, Snap.BallAhead, 2, Plan.Chasers);
+    }
+
+    FVector Goal;
+    ComputeKeeperTarget(TeamID, BallLoc, Goal, Plan.KeeperHome, Plan.KeeperBoxMin, Plan.KeeperBoxMax);
+
+    Plan.MarkTarget.Init(INDEX_NONE, TeamCount);
+    if (bAttacking) return;
+
+    // Markers: outfield, not chasing, AI-controlled
+    TArray<int32, TInlineAllocator<32>> MarkerSlots;
+    for (int32 SlotIdx = 1; SlotIdx < TeamCount; ++SlotIdx)
+    {
+        const int32 Idx = TeamBegin + SlotIdx;
+        if (!Snap.Valid[Idx] || Snap.Human[Idx]) continue;
+        if (Idx == Plan.Chasers[0] || Idx == Plan.Chasers[1]) continue;
+        MarkerSlots.Add(SlotIdx);
+    }
+
+    // Min-cost marking with a switch penalty; stable across Thinks
+    Marking.SwitchPenalty = Tactics.MarkSwitchPenalty;
+    TArray<int32, TInlineAllocator<32>> MarkTargets;
+    Marking.Solve(Snap, TeamID, MarkerSlots, MarkTargets);
+
+    for (int32 k = 0; k < MarkerSlots.Num(); ++k)
+    {
+        Plan.MarkTarget[MarkerSlots[k]] = MarkTargets[k];
+    }
+}
+
+void FMatchKernel::DecidePlayer(const FMatchSnapshot& Snap, const FSpatialHashGrid& Grid, int32 Idx,
+                                const FTeamPlan& Plan, FPlayerIntent& Intent) const
+{
+    OSF_SCOPE(DecidePlayer);
+    Intent = FPlayerIntent();
+    if (!Snap.IsValidEntry(Idx)) return;
+
+    const int32 TeamID = Snap.Team[Idx];
+    const int32 SlotIdx = Snap.Slot[Idx];
+    const FVector BallLoc = Snap.BallPos;
+    const float Dir = (TeamID == 0) ? +1.f : -1.f;
+    const FVector OwnGoal = OwnGoalLocation(TeamID);
+
+    // Steer to Target; bSeekSpace moves it into the team's space
+    auto Steer = [&](const FVector& Target, ESimRole PlayIntent, bool bSeekSpace)
+        {
+            const FVector MyPos = Snap.GetPos(Idx);
+            Intent.Target = bSeekSpace ? Ground(FindSpace(TeamID, Target)) : Target;
+            Intent.Desired = SeekArriveDirection(MyPos, Intent.Target)
+                + SeparationVector(Snap, Grid, Idx, TeamID) * Tactics.SeparationStrength;
+            Intent.Sprint = (Intent.Target - MyPos).Size() > 700.f ? 1.f : 0.f;
+            Intent.Role = PlayIntent;
+            Intent.bSteer = true;
+            Intent.bActive = true;
+        };
+
+    // Blend tactical with home slot and steer
+    auto SetTarget = [&](const FVector& Tactical, ESimRole PlayIntent, bool bSeekSpace = false)
+        {
+            Steer(FMath::Lerp(Home(TeamID, SlotIdx, EFormationShape::Base), Tactical, 1.f - Tactics.HomeWeight), PlayIntent, bSeekSpace);
+        };
+
+    // --- Chasers (may include the keeper or a human; they still get the intent) ---
+    const bool bFirst = (Idx == Plan.Chasers[0]);
+    const bool bSecond = (Idx == Plan.Chasers[1]);
+    if (bFirst || bSecond)
+    {
+        const float Side = bFirst ? +1.f : -1.f;
+        if (Plan.bAttacking)
+        {
+            SetTarget(Ground(ClampToField(BallLoc + FVector(Tactics.SupportAhead * Dir, Side * Tactics.SupportWide, 0.f))), ESimRole::Support, true);
+        }
+        else
+        {
+            // Contain goal-side of where this player meets the ball
+            const FVector Meet = Snap.bHasIntercepts ? FVector(Snap.InterceptX[Idx], Snap.InterceptY[Idx], Snap.BallAhead.Z) : Snap.BallAhead;
+            const FVector ToGoal = (OwnGoal - Meet).GetSafeNormal2D();
+            const FVector Right = FVector::CrossProduct(ToGoal, FVector::UpVector);
+            const FVector Contain = Meet + ToGoal * 900.f + Right * Side * 260.f;
+            SetTarget(Ground(ClampToField(Contain)), ESimRole::Press);
+        }
+        if (bFirst) DecideKick(Snap, Idx, Intent);
+        return;
+    }
+
+    // --- Keeper ---
+    if (SlotIdx == 0)
+    {
+        const float DistToBall = FVector::Dist2D(Snap.GetPos(Idx), BallLoc);
+        FVector GKTarget = Plan.KeeperHome;
+
+        // Inside box and close enough → step out toward ball
+        if (BallLoc.X >= FMath::Min(Plan.KeeperBoxMin.X, Plan.KeeperBoxMax.X) && BallLoc.X <= FMath::Max(Plan.KeeperBoxMin.X, Plan.KeeperBoxMax.X) &&
+            BallLoc.Y >= Plan.KeeperBoxMin.Y && BallLoc.Y <= Plan.KeeperBoxMax.Y &&
+            DistToBall <= Tactics.KeeperChaseRadius)
+        {
+            GKTarget = Ground(ClampToField(Snap.BallAhead));
+        }
+
+        Intent.Target = FMath::Lerp(Plan.KeeperHome, GKTarget, 0.5f);
+        Intent.bKeeper = true;
+        Intent.bActive = true;
+        DecideKick(Snap, Idx, Intent);
+        return;
+    }
+
+    // --- Field players ---
+    if (Snap.Human[Idx]) return;
+
+    // Held shape from the ball-zone table when the team's formation has one: the blend is baked in
+    const FFormationZones* Zones = Formations ? Formations->GetZones(TeamID) : nullptr;
+    if (Zones && !Zones->HasSlot(SlotIdx)) Zones = nullptr;
+
+    if (Plan.bAttacking)
+    {
+        if (Zones) Steer(Ground(Zones->Sample(Tactics, true, TeamID, SlotIdx, BallLoc)), ESimRole::HoldLine, true);
+        else SetTarget(Home(TeamID, SlotIdx, EFormationShape::Attack), ESimRole::HoldLine, true);
+    }
+    else
+    {
+        const int32 Att = Plan.MarkTarget.IsValidIndex(SlotIdx) ? Plan.MarkTarget[SlotIdx] : INDEX_NONE;
+
+        if (Att != INDEX_NONE)
+        {
+            const FVector Apos = Snap.GetPos(Att);
+            const FVector AG = (OwnGoal - Apos).GetSafeNormal2D();
+            FVector MarkPos = Apos + AG * 350.f; // goal-side
+            MarkPos.X -= Tactics.RetreatWithBall * 0.5f * Dir;
+            SetTarget(Ground(ClampToField(MarkPos)), ESimRole::Mark);
+        }
+        else if (Zones)
+        {
+            Steer(Ground(Zones->Sample(Tactics, false, TeamID, SlotIdx, BallLoc)), ESimRole::Mark, false);
+        }
+        else
+        {
+            SetTarget(Home(TeamID, SlotIdx, EFormationShape::Defend), ESimRole::Mark);
+        }
+    }
+}
+
+bool FMatchKernel::DecideKick(const FMatchSnapshot& Snap, int32 Idx, FPlayerIntent& Intent) const
+{
+    if (!Snap.IsValidEntry(Idx) || Snap.Human[Idx]) return false;
+
+    // Only with the ball at the player's feet and under control
+    const FVector Pos = Snap.GetPos(Idx);
+    const FVector BallLoc = Snap.BallPos;
+    if (FVector::DistSquared2D(Pos, BallLoc) > FMath::Square(Tactics.KickReach)) return false;
+    if ((Snap.BallVel - Snap.GetVel(Idx)).SizeSquared2D() > FMath::Square(Tactics.KickMaxBallSpeed)) return false;
+
+    const int32 TeamID = Snap.Team[Idx];
+    const int32 Goal = (TeamID == 0) ? 1 : 0;
+    if (Shots[Goal] && FVector::Dist2D(BallLoc, OwnGoalLocation(1 - TeamID)) <= Tactics.ShotRange)
+    {
+        FShotChoice Shot;
+        if (Shots[Goal]->Evaluate(Snap, Idx, BallLoc, FVector::ZeroVector, Shot) && Shot.Chance >= Tactics.ShotMinChance)
+        {
+            Intent.Kick = ESimKick::Shot;
+            Intent.KickVelocity = Shot.Velocity;
+            Intent.KickSpin = Shot.Spin;
+            return true;
+        }
+    }
+
+    if (!Passes) return false;
+
+    FPassChoice Pass;
+    if (!Passes->Evaluate(Snap, Tactics, Idx, BallLoc, FVector::ZeroVector, Pass)) return false;
+
+    float OppDistSq = 0.f;
+    const int32 Opp = Snap.Nearest(Snap.TeamBegin[1 - TeamID], Snap.TeamEnd[1 - TeamID], BallLoc, nullptr, &OppDistSq);
+    const bool bPressed = (Opp != INDEX_NONE) && OppDistSq <= FMath::Square(Tactics.PressureRadius);
+    if (!bPressed && Pass.Score < Tactics.PassMinScore) return false;
+
+    Intent.Kick = ESimKick::Pass;
+    Intent.KickVelocity = Pass.Velocity;
+    Intent.KickSpin = Pass.Spin;
+    return true;
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMatchSnapshot;
+struct FSpatialHashGrid;
+struct FMarkingAssignment;
+class FPitchControl;
+class FFormationSet;
+class FPassEvaluator;
+class FShotEvaluator;
+
+/** Same values as EPlayRole; the kernel stays free of reflected types. */
+enum class ESimRole : uint8
+{
+    HoldLine,
+    Press,
+    Support,
+    Mark
+};
+
+/** Formation points per phase: as set up, pushed up with the ball (AdvanceWithBall / 2), dropped off without it (RetreatWithBall / 2). */
+enum class EFormationShape : uint8
+{
+    Base,
+    Attack,
+    Defend
+};
+
+/** A kick the intent asks for: none, or the evaluators' best pass or shot. */
+enum class ESimKick : uint8
+{
+    None,
+    Pass,
+    Shot
+};
+
+/** Tactic and pitch parameters the kernel reads. Defaults match ADefaultGameMode. */
+struct FTacticParams
+{
+    FVector FieldCentre = FVector::ZeroVector;
+    float HalfLength = 9000.f;
+    float HalfWidth = 6000.f;
+
+    float HomeWeight = 0.65f;
+    float AdvanceWithBall = 1400.f;
+    float RetreatWithBall = 1200.f;
+    float SupportAhead = 750.f;
+    float SupportWide = 900.f;
+    float SpaceSearch = 450.f; // cm around support and attacking targets searched for the team's space (0 = fixed targets)
+
+    float ArriveRadius = 260.f;
+    float SeparationRadius = 420.f;
+    float SeparationStrength = 0.7f;
+
+    float KeeperDepth = 900.f;
+    float KeeperChaseRadius = 1200.f;
+    float PenBoxDepth = 2200.f;
+    float PenBoxHalfWidth = 2200.f;
+
+    float MarkSwitchPenalty = 400.f;
+
+    float BallLeadTime = 0.4f; // chasers and keeper go where the ball will be this far ahead (s)
+    float ChaserHysteresis = 0.15f; // s a new first chaser must beat the current one by
+
+    // AI carrier: with the ball within KickReach (XY, cm) and moving under KickMaxBallSpeed relative to it
+    float KickReach = 150.f;
+    float KickMaxBallSpeed = 700.f;
+    float ShotRange = 2800.f;     // cm from the goal attacked; shoots from inside it at ShotMinChance or better
+    float ShotMinChance = 0.12f;
+    float PassMinScore = 1.f;     // plays a pass this good even when not pressed
+    float PressureRadius = 300.f; // an opponent this close to the ball: plays the best pass there is
+};
+
+/** Team-level decisions for one Think, shared by every player of that team. */
+struct FTeamPlan
+{
+    bool  bAttacking = false;
+    int32 Chasers[2] = { INDEX_NONE, INDEX_NONE }; // snapshot indices, first to the ball first
+
+    FVector KeeperHome = FVector::ZeroVector;
+    FVector KeeperBoxMin = FVector::ZeroVector;
+    FVector KeeperBoxMax = FVector::ZeroVector;
+
+    // By slot: snapshot index of the attacker to mark, or INDEX_NONE
+    TArray<int32, TInlineAllocator<32>> MarkTarget;
+};
+
+/** What one player should do this Think. Produced off the game thread, applied on it. */
+struct FPlayerIntent
+{
+    FVector  Target = FVector::ZeroVector;
+    FVector  Desired = FVector::ZeroVector; // steering direction
+    float    Sprint = 0.f;
+    ESimRole Role = ESimRole::HoldLine;
+    bool     bActive = false;  // false = leave the player alone this Think
+    bool     bSteer = false;   // write Desired/Sprint (field players)
+    bool     bKeeper = false;
+
+    ESimKick Kick = ESimKick::None; // kick the ball now (AI carrier)
+    FVector  KickVelocity = FVector::ZeroVector;
+    FVector  KickSpin = FVector::ZeroVector;
+};
+
+/**
+ * The team AI as plain geometry over an FMatchSnapshot: formation homes,
+ * chasers, keeper box, marking, support offsets and steering. No actors or
+ * world; ADefaultGameMode and the point-mass simulator both drive it, so a
+ * tactic tuned offline behaves the same in the game.
+ *
+ * Const methods are safe to call from several threads at once as long as
+ * ProjectToGround is.
+ */
+struct OSF_API FMatchKernel
+{
+    FTacticParams Tactics;
+
+    /** Local formation points (X forward, Y right, origin at field centre), slot order. */
+    TArray<FVector> Formation;
+
+    /** Optional XY -> ground projection; a flat pitch at FieldCentre.Z when unset. */
+    TFunction<FVector(const FVector&)> ProjectToGround;
+
+    /** Optional; when set and configured, support and attacking runs move toward the team's space in it. */
+    const FPitchControl* Control = nullptr;
+
+    /**
+     * Optional; when set and compiled, homes come precomputed from it (per-team formation and blend),
+     * and a formation with a ball-zone table gives the held shape (hold line, unassigned markers) directly.
+     */
+    const FFormationSet* Formations = nullptr;
+
+    /** Optional; when set, an AI chaser or keeper with the ball at its feet passes or shoots through them. Shots by goal (0 at -X). */
+    const FPassEvaluator* Passes = nullptr;
+    const FShotEvaluator* Shots[2] = { nullptr, nullptr };
+
+    /** The built-in 4-4-2 for a pitch of the given half length. */
+    static void MakeDefaultFormation(float HalfLength, TArray<FVector>& Out);
+
+    // ---------- Geometry ----------
+    /** Slot of a local formation; oversized squads reuse outfield slots, fanned out sideways per extra layer. */
+    static FVector FormationSlot(TConstArrayView<FVector> Local, int32 SlotIdx);
+
+    FVector FormationLocal(int32 SlotIdx) const { return FormationSlot(Formation, SlotIdx); }
+    FVector HomeWorld(int32 TeamID, int32 SlotIdx) const; // mirrored for team 1, not clamped
+
+    /** Grounded, clamped home in Shape: from Formations when compiled for the slot, else computed from Formation. */
+    FVector Home(int32 TeamID, int32 SlotIdx, EFormationShape Shape) const;
+    FVector ClampToField(const FVector& P) const;
+    FVector Ground(const FVector& P) const { return ProjectToGround ? ProjectToGround(P) : FVector(P.X, P.Y, Tactics.FieldCentre.Z); }
+    FVector OwnGoalLocation(int32 TeamID) const;
+
+    FVector SeekArriveDirection(const FVector& From, const FVector& To) const;
+
+    /** Of P and eight points SpaceSearch around it (clamped to the field), the one TeamID controls most; P without pitch control. */
+    FVector FindSpace(int32 TeamID, const FVector& P) const;
+    FVector SeparationVector(const FMatchSnapshot& Snap, const FSpatialHashGrid& Grid, int32 SelfIdx, int32 TeamID) const;
+
+    void ComputeKeeperTarget(
+        int32 TeamID, const FVector& BallLoc,
+        FVector& OutGoal, FVector& OutKeeperHome,
+        FVector& OutBoxMin, FVector& OutBoxMax) const;
+
+    // ---------- Decisions ----------
+
+    /** Team in possession, else the team with the player closest to the ball. */
+    int32 PickAttackingTeam(const FSpatialHashGrid& Grid, const FVector& BallLoc, int32 PossessingTeamID) const;
+
+    /**
+     * Chasers, keeper box and (when defending) the marking assignment, warm-started from Marking.
+     * Chasers are the two earliest interceptors when the snapshot has intercepts (keeping the
+     * previous first chaser unless beaten by ChaserHysteresis), else the two closest to BallAhead.
+     */
+    void PlanTeam(const FMatchSnapshot& Snap, const FSpatialHashGrid& Grid, int32 TeamID, bool bAttacking,
+                  FMarkingAssignment& Marking, FTeamPlan& Plan) const;
+
+    void DecidePlayer(const FMatchSnapshot& Snap, const FSpatialHashGrid& Grid, int32 Idx,
+                      const FTeamPlan& Plan, FPlayerIntent& Intent) const;
+
+    /** Sets Intent.Kick when AI player Idx has the ball under control and a shot or pass is worth playing. */
+    bool DecideKick(const FMatchSnapshot& Snap, int32 Idx, FPlayerIntent& Intent) const;
+};
@@ -0,0 +1,595 @@
+#include "Sim/MatchReplay.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+#include "MatchSnapshot.h"
+#include "OSFStats.h"
+
+namespace
+{
+    constexpr uint32 MakeMagic(char A, char B, char C, char D)
+    {
+        return uint32(uint8(A)) | (uint32(uint8(B)) << 8) | (uint32(uint8(C)) << 16) | (uint32(uint8(D)) << 24);
+    }
+
+    constexpr uint32 FileMagic = MakeMagic('O', 'S', 'F', 'R');
+    constexpr uint32 ChunkMagic = MakeMagic('C', 'H', 'N', 'K');
+    constexpr uint32 IndexMagic = MakeMagic('I', 'N', 'D', 'X');
+    constexpr uint32 EndMagic = MakeMagic('O', 'S', 'F', 'E');
+    constexpr uint16 FileVersion = 1;
+
+    constexpr int32 HeaderBytes = 16;      // magic, version, flags, keyframe interval, reserved
+    constexpr int32 ChunkHeaderBytes = 20; // magic, payload bytes, start us, frames
+    constexpr int32 IndexEntryBytes = 20;  // start us, offset, frames
+    constexpr int32 TrailerBytes = 12;     // index offset, magic
+
+    constexpr float EventScale = 100.f;
+    constexpr int32 YawIndex = 6;
+
+    struct FByteWriter
+    {
+        TArray<uint8>& Out;
+
+        void U8(uint8 V) { Out.Add(V); }
+        void U16(uint16 V) { U8(uint8(V)); U8(uint8(V >> 8)); }
+        void U32(uint32 V) { U16(uint16(V)); U16(uint16(V >> 16)); }
+        void I64(int64 V) { U32(uint32(uint64(V))); U32(uint32(uint64(V) >> 32)); }
+
+        void VarU(uint64 V)
+        {
+            while (V >= 0x80) { Out.Add(uint8(V) | 0x80); V >>= 7; }
+            Out.Add(uint8(V));
+        }
+
+        // Zigzag: small magnitudes of either sign stay short
+        void VarS(int64 V) { VarU((uint64(V) << 1) ^ uint64(V >> 63)); }
+    };
+
+    /** Bounds-checked: a damaged or truncated file clears bOk instead of reading past the end. */
+    struct FByteReader
+    {
+        const uint8* P;
+        const uint8* End;
+        bool bOk = true;
+
+        uint8 U8()
+        {
+            if (P >= End) { bOk = false; return 0; }
+            return *P++;
+        }
+        uint16 U16() { const uint16 Lo = U8(); return Lo | uint16(U8() << 8); }
+        uint32 U32() { const uint32 Lo = U16(); return Lo | (uint32(U16()) << 16); }
+        int64 I64() { const uint64 Lo = U32(); return int64(Lo | (uint64(U32()) << 32)); }
+
+        uint64 VarU()
+        {
+            uint64 V = 0;
+            for (int32 Shift = 0; Shift < 64 && bOk; Shift += 7)
+            {
+                const uint8 B = U8();
+                V |= uint64(B & 0x7f) << Shift;
+                if ((B & 0x80) == 0) return V;
+            }
+            bOk = false;
+            return 0;
+        }
+        int64 VarS() { const uint64 U = VarU(); return int64(U >> 1) ^ -int64(U & 1); }
+    };
+
+    FORCEINLINE int32 Quantise(double V)
+    {
+        return static_cast<int32>(FMath::Clamp<double>(FMath::RoundToDouble(V), MIN_int32, MAX_int32));
+    }
+
+    enum : uint8 { FlagValid = 1, FlagHuman = 2 };
+
+    /** Layout (keyframes only), then time, ball, possession, players and events as deltas from Prev (zeros for a keyframe). */
+    void WriteFrame(FByteWriter& W, const FReplayState* Prev, const FReplayState& Cur, int64 ChunkStartUs)
+    {
+        if (!Prev)
+        {
+            W.VarU(Cur.NumPlayers());
+            W.VarU(Cur.NumTeam0);
+            for (uint8 F : Cur.Flags) W.U8(F);
+        }
+
+        W.VarU(uint64(Cur.TimeUs - (Prev ? Prev->TimeUs : ChunkStartUs)));
+        for (int32 k = 0; k < 6; ++k) W.VarS(int64(Cur.Ball[k]) - (Prev ? Prev->Ball[k] : 0));
+        W.U8(uint8(Cur.PossessionTeam + 1));
+        W.VarU(uint64(Cur.PossessionPlayer + 1));
+
+        const int32* PrevValues = Prev ? Prev->Values.GetData() : nullptr;
+        for (int32 i = 0; i < Cur.Values.Num(); ++i)
+        {
+            int64 D = int64(Cur.Values[i]) - (PrevValues ? PrevValues[i] : 0);
+            if (i % FReplayState::ValuesPerPlayer == YawIndex) D = int16(uint16(D)); // the short way round
+            W.VarS(D);
+        }
+
+        W.VarU(Cur.Events.Num());
+        for (const FReplayEvent& E : Cur.Events)
+        {
+            W.U8(uint8(E.Type));
+            W.VarU(uint64(E.Player + 1));
+            W.U8(uint8(E.Team + 1));
+            W.VarS(Quantise(E.Value.X * EventScale));
+            W.VarS(Quantise(E.Value.Y * EventScale));
+            W.VarS(Quantise(E.Value.Z * EventScale));
+        }
+    }
+
+    /** WriteFrame's inverse, applied to State in place; State.TimeUs is the chunk start before a keyframe. */
+    void ReadFrame(FByteReader& R, FReplayState& State, bool bKey)
+    {
+        if (bKey)
+        {
+            const int32 Num = static_cast<int32>(FMath::Min<uint64>(R.VarU(), 4096));
+            State.NumTeam0 = static_cast<int32>(FMath::Min<uint64>(R.VarU(), Num));
+            State.Flags.SetNumUninitialized(Num);
+            for (uint8& F : State.Flags) F = R.U8();
+            State.Values.SetNumZeroed(Num * FReplayState::ValuesPerPlayer);
+            FMemory::Memzero(State.Ball, sizeof(State.Ball));
+        }
+
+        State.TimeUs += int64(R.VarU());
+        for (int32 k = 0; k < 6; ++k) State.Ball[k] += int32(R.VarS());
+        State.PossessionTeam = int32(R.U8()) - 1;
+        State.PossessionPlayer = int32(R.VarU()) - 1;
+
+        for (int32 i = 0; i < State.Values.Num(); ++i)
+        {
+            State.Values[i] += int32(R.VarS());
+            if (i % FReplayState::ValuesPerPlayer == YawIndex) State.Values[i] = uint16(State.Values[i]);
+        }
+
+        State.Events.SetNum(static_cast<int32>(FMath::Min<uint64>(R.VarU(), 1024)));
+        for (FReplayEvent& E : State.Events)
+        {
+            E.Type = static_cast<EReplayEvent>(R.U8());
+            E.Player = int32(R.VarU()) - 1;
+            E.Team = int32(R.U8()) - 1;
+            E.Value.X = R.VarS() / EventScale;
+            E.Value.Y = R.VarS() / EventScale;
+            E.Value.Z = R.VarS() / EventScale;
+        }
+    }
+}
+
+// ---------------- Recorder ----------------
+FReplayRecorder::FReplayRecorder()
+    : Writer(TEXT("OSF.ReplayWrite"))
+{
+}
+
+FReplayRecorder::~FReplayRecorder()
+{
+    Stop();
+}
+
+bool FReplayRecorder::Start(const FString& InFilename)
+{
+    Stop();
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(InFilename), true);
+    File.Reset(IFileManager::Get().CreateFileWriter(*InFilename));
+    if (!File) return false;
+    Filename = InFilename;
+
+    StartTime = 0.0;
+    LastFrameUs = 0;
+    Prev = FReplayState();
+    Pending.Reset();
+    Index.Reset();
+    Chunk.Reset(64 * 1024);
+    ChunkFrames = 0;
+    FramesRecorded = 0;
+
+    TArray<uint8> Header;
+    FByteWriter W{ Header };
+    W.U32(FileMagic);
+    W.U16(FileVersion);
+    W.U16(0);
+    W.U32(uint32(Quantise(Params.KeyframeInterval * 1000.f))); // ms
+    W.U32(0);
+    check(Header.Num() == HeaderBytes);
+
+    FileOffset = BytesRecorded = Header.Num();
+    Writer.Launch(TEXT("OSF.ReplayWrite"), [Ar = File.Get(), Bytes = MoveTemp(Header)]() mutable
+        {
+            Ar->Serialize(Bytes.GetData(), Bytes.Num());
+        });
+    return true;
+}
+
+void FReplayRecorder::Stop()
+{
+    if (!File) return;
+    FlushChunk();
+
+    // Index and trailer; a file without them still plays (the reader walks the chunks)
+    TArray<uint8> Tail;
+    FByteWriter W{ Tail };
+    W.U32(IndexMagic);
+    W.U32(Index.Num());
+    for (const FIndexEntry& E : Index)
+    {
+        W.I64(E.StartUs);
+        W.I64(E.Offset);
+        W.U32(E.Frames);
+    }
+    W.I64(FileOffset);
+    W.U32(EndMagic);
+    BytesRecorded += Tail.Num();
+
+    Writer.Launch(TEXT("OSF.ReplayWrite"), [Ar = File.Get(), Bytes = MoveTemp(Tail)]() mutable
+        {
+            Ar->Serialize(Bytes.GetData(), Bytes.Num());
+            Ar->Close();
+        });
+    Writer.WaitUntilEmpty();
+    File.Reset();
+}
+
+void FReplayRecorder::FlushChunk()
+{
+    if (ChunkFrames == 0) return;
+
+    // Header in the space left at the front of the chunk
+    TArray<uint8> Header;
+    FByteWriter W{ Header };
+    W.U32(ChunkMagic);
+    W.U32(Chunk.Num() - ChunkHeaderBytes);
+    W.I64(ChunkStartUs);
+    W.U32(ChunkFrames);
+    FMemory::Memcpy(Chunk.GetData(), Header.GetData(), ChunkHeaderBytes);
+
+    Index.Add({ ChunkStartUs, FileOffset, ChunkFrames });
+    FileOffset += Chunk.Num();
+    BytesRecorded += Chunk.Num();
+    const int32 Capacity = Chunk.Max();
+
+    Writer.Launch(TEXT("OSF.ReplayWrite"), [Ar = File.Get(), Bytes = MoveTemp(Chunk)]() mutable
+        {
+            Ar->Serialize(Bytes.GetData(), Bytes.Num());
+            Ar->Flush();
+        });
+
+    Chunk.Reset(Capacity);
+    ChunkFrames = 0;
+}
+
+void FReplayRecorder::Capture(const FMatchSnapshot& Snap, double Time, int32 PossessionPlayer, int32 PossessionTeam)
+{
+    if (!IsRecording()) return;
+    OSF_SCOPE(ReplayRecord);
+    const uint32 StartCycles = FPlatformTime::Cycles();
+
+    if (FramesRecorded == 0) StartTime = Time;
+    const int64 TimeUs = FMath::Max<int64>(static_cast<int64>(FMath::RoundToDouble((Time - StartTime) * 1.0e6)), LastFrameUs);
+    if (FramesRecorded > 0 && TimeUs - LastFrameUs < static_cast<int64>(Params.FrameInterval * 1.0e6f)) return;
+
+    // Quantise
+    Cur.TimeUs = TimeUs;
+    Cur.Ball[0] = Quantise(Snap.BallPos.X);
+    Cur.Ball[1] = Quantise(Snap.BallPos.Y);
+    Cur.Ball[2] = Quantise(Snap.BallPos.Z);
+    Cur.Ball[3] = Quantise(Snap.BallVel.X);
+    Cur.Ball[4] = Quantise(Snap.BallVel.Y);
+    Cur.Ball[5] = Quantise(Snap.BallVel.Z);
+    Cur.PossessionPlayer = PossessionPlayer;
+    Cur.PossessionTeam = PossessionTeam;
+    Cur.NumTeam0 = Snap.TeamEnd[0] - Snap.TeamBegin[0];
+    Cur.Flags.SetNumUninitialized(Snap.Num);
+    Cur.Values.SetNumUninitialized(Snap.Num * FReplayState::ValuesPerPlayer);
+
+    for (int32 i = 0; i < Snap.Num; ++i)
+    {
+        int32* V = Cur.Values.GetData() + i * FReplayState::ValuesPerPlayer;
+        const bool bValid = Snap.Valid[i] != 0;
+        Cur.Flags[i] = (bValid ? FlagValid : 0) | (Snap.Human[i] ? FlagHuman : 0);
+        if (!bValid)
+        {
+            // Off the pitch at the sentinel; zeros cost a byte each
+            FMemory::Memzero(V, FReplayState::ValuesPerPlayer * sizeof(int32));
+            continue;
+        }
+        V[0] = Quantise(Snap.PosX[i]);
+        V[1] = Quantise(Snap.PosY[i]);
+        V[2] = Quantise(Snap.PosZ[i]);
+        V[3] = Quantise(Snap.VelX[i]);
+        V[4] = Quantise(Snap.VelY[i]);
+        V[5] = Quantise(Snap.VelZ[i]);
+        V[YawIndex] = uint16(FMath::RoundToInt(FMath::Atan2(Snap.FaceY[i], Snap.FaceX[i]) * (32768.f / PI)));
+    }
+    Swap(Cur.Events, Pending);
+    Pending.Reset();
+
+    // A keyframe starts each chunk: on the interval, and when the layout or who is human changes
+    const bool bLayoutChanged = Cur.NumTeam0 != Prev.NumTeam0 || Cur.Flags != Prev.Flags;
+    const bool bKey = ChunkFrames == 0 || bLayoutChanged
+        || TimeUs - ChunkStartUs >= static_cast<int64>(Params.KeyframeInterval * 1.0e6f);
+
+    if (bKey)
+    {
+        FlushChunk();
+        Chunk.AddZeroed(ChunkHeaderBytes);
+        ChunkStartUs = TimeUs;
+    }
+    FByteWriter W{ Chunk };
+    WriteFrame(W, bKey ? nullptr : &Prev, Cur, ChunkStartUs);
+
+    ChunkFrames++;
+    FramesRecorded++;
+    LastFrameUs = TimeUs;
+    Swap(Prev, Cur);
+
+    LastCaptureMicros = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles) * 1000.f;
+}
+
+// ---------------- Reader ----------------
+FReplayReader::FReplayReader() = default;
+
+FReplayReader::~FReplayReader()
+{
+    Close();
+}
+
+bool FReplayReader::Open(const FString& Filename)
+{
+    Close();
+
+    // Map the file; read it whole where mapping is unavailable
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    MappedFile.Reset(PlatformFile.OpenMapped(*Filename));
+    if (MappedFile && MappedFile->GetFileSize() > 0)
+    {
+        MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+    }
+    if (MappedRegion)
+    {
+        Data = MappedRegion->GetMappedPtr();
+        Size = MappedRegion->GetMappedSize();
+    }
+    else
+    {
+        MappedFile.Reset();
+        if (!FFileHelper::LoadFileToArray(Loaded, *Filename)) return false;
+        Data = Loaded.GetData();
+        Size = Loaded.Num();
+    }
+
+    FByteReader Header{ Data, Data + Size };
+    if (Header.U32() != FileMagic || Header.U16() != FileVersion || !Header.bOk)
+    {
+        Close();
+        return false;
+    }
+
+    // Index from the trailer
+    bool bIndexed = false;
+    if (Size >= HeaderBytes + TrailerBytes)
+    {
+        FByteReader Trailer{ Data + Size - TrailerBytes, Data + Size };
+        const int64 IndexOffset = Trailer.I64();
+        if (Trailer.U32() == EndMagic && IndexOffset >= HeaderBytes && IndexOffset < Size - TrailerBytes)
+        {
+            FByteReader R{ Data + IndexOffset, Data + Size - TrailerBytes };
+            const uint32 Count = (R.U32() == IndexMagic) ? R.U32() : 0;
+            bIndexed = R.bOk && int64(Count) * IndexEntryBytes <= R.End - R.P;
+            Index.Reserve(bIndexed ? Count : 0);
+            for (uint32 k = 0; k < Count && bIndexed; ++k)
+            {
+                FIndexEntry E;
+                E.StartUs = R.I64();
+                E.Offset = R.I64();
+                E.Frames = static_cast<int32>(R.U32());
+                Index.Add(E);
+            }
+        }
+    }
+
+    // Cut short: walk the chunk headers up to the last complete chunk
+    if (!bIndexed)
+    {
+        Index.Reset();
+        int64 Offset = HeaderBytes;
+        while (Offset + ChunkHeaderBytes <= Size)
+        {
+            FByteReader R{ Data + Offset, Data + Size };
+            if (R.U32() != ChunkMagic) break;
+            const int64 Payload = R.U32();
+            FIndexEntry E;
+            E.StartUs = R.I64();
+            E.Frames = static_cast<int32>(R.U32());
+            E.Offset = Offset;
+            if (Offset + ChunkHeaderBytes + Payload > Size) break;
+            Index.Add(E);
+            Offset += ChunkHeaderBytes + Payload;
+        }
+    }
+
+    NumFrames = 0;
+    for (const FIndexEntry& E : Index) NumFrames += E.Frames;
+    // Duration from decoding the last chunk: one keyframe interval at most
+    const FReplayFrame* Last = (NumFrames > 0) ? Seek(TNumericLimits<double>::Max()) : nullptr;
+    Duration = Last ? Last->Time : 0.0;
+    if (!Last || !Seek(0.0))
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void FReplayReader::Close()
+{
+    MappedRegion.Reset();
+    MappedFile.Reset();
+    Loaded.Empty();
+    Data = nullptr;
+    Size = 0;
+    Index.Reset();
+    NumFrames = 0;
+    Duration = 0.0;
+    ChunkIdx = INDEX_NONE;
+    State = FReplayState();
+    Frame = FReplayFrame();
+}
+
+bool FReplayReader::EnterChunk(int32 InChunkIdx)
+{
+    const FIndexEntry& E = Index[InChunkIdx];
+    FByteReader R{ Data + E.Offset, Data + Size };
+    if (R.U32() != ChunkMagic) return false;
+    const int64 Payload = R.U32();
+    if (!R.bOk || E.Offset + ChunkHeaderBytes + Payload > Size) return false;
+
+    ChunkIdx = InChunkIdx;
+    FrameInChunk = 0;
+    Cursor = E.Offset + ChunkHeaderBytes;
+    ChunkEnd = Cursor + Payload;
+    State.TimeUs = E.StartUs;
+    return DecodeNext();
+}
+
+bool FReplayReader::DecodeNext()
+{
+    if (FrameInChunk >= Index[ChunkIdx].Frames) return false;
+
+    FByteReader R{ Data + Cursor, Data + ChunkEnd };
+    ReadFrame(R, State, FrameInChunk == 0);
+    if (!R.bOk) return false;
+
+    Cursor = R.P - Data;
+    FrameInChunk++;
+    return true;
+}
+
+bool FReplayReader::PeekNextTime(int64& OutUs) const
+{
+    if (FrameInChunk >= Index[ChunkIdx].Frames) return false;
+
+    // A delta frame starts with its time step
+    FByteReader R{ Data + Cursor, Data + ChunkEnd };
+    OutUs = State.TimeUs + int64(R.VarU());
+    return R.bOk;
+}
+
+const FReplayFrame* FReplayReader::Seek(double Time)
+{
+    if (!IsOpen() || Index.Num() == 0) return nullptr;
+
+    const int64 TargetUs = FMath::Max<int64>(static_cast<int64>(FMath::RoundToDouble(FMath::Min(Time, 1.0e12) * 1.0e6)), 0);
+    const int32 Target = FMath::Max(Algo::UpperBoundBy(Index, TargetUs, &FIndexEntry::StartUs) - 1, 0);
+
+    // Forward within the chunk from where we are, else from its keyframe
+    if (Target != ChunkIdx || State.TimeUs > TargetUs || FrameInChunk == 0)
+    {
+        if (!EnterChunk(Target)) return nullptr;
+    }
+
+    int64 NextUs = 0;
+    while (PeekNextTime(NextUs) && NextUs <= TargetUs)
+    {
+        if (!DecodeNext()) return nullptr;
+    }
+
+    BuildFrame();
+    return &Frame;
+}
+
+const FReplayFrame* FReplayReader::Step()
+{
+    if (!IsOpen() || ChunkIdx == INDEX_NONE) return nullptr;
+
+    if (FrameInChunk < Index[ChunkIdx].Frames)
+    {
+        if (!DecodeNext()) return nullptr;
+    }
+    else if (ChunkIdx + 1 >= Index.Num() || !EnterChunk(ChunkIdx + 1))
+    {
+        return nullptr;
+    }
+
+    BuildFrame();
+    return &Frame;
+}
+
+void FReplayReader::BuildFrame()
+{
+    Frame.Time = State.TimeUs * 1.0e-6;
+    Frame.BallPos = FVector(State.Ball[0], State.Ball[1], State.Ball[2]);
+    Frame.BallVel = FVector(State.Ball[3], State.Ball[4], State.Ball[5]);
+    Frame.PossessionPlayer = State.PossessionPlayer;
+    Frame.PossessionTeam = State.PossessionTeam;
+    Frame.Events = State.Events;
+
+    Frame.Players.SetNum(State.NumPlayers());
+    for (int32 i = 0; i < State.NumPlayers(); ++i)
+    {
+        const int32* V = State.Values.GetData() + i * FReplayState::ValuesPerPlayer;
+        FReplayPlayer& P = Frame.Players[i];
+        P.Pos = FVector(V[0], V[1], V[2]);
+        P.Vel = FVector(V[3], V[4], V[5]);
+        P.Yaw = FRotator::NormalizeAxis(V[YawIndex] * (360.f / 65536.f));
+        P.Team = (i < State.NumTeam0) ? 0 : 1;
+        P.Slot = (i < State.NumTeam0) ? i : i - State.NumTeam0;
+        P.bValid = (State.Flags[i] & FlagValid) != 0;
+        P.bHuman = (State.Flags[i] & FlagHuman) != 0;
+    }
+}
+
+// ---------------- Console ----------------
+namespace
+{
+    void DumpReplayCommand(const TArray<FString>& Args)
+    {
+        if (Args.Num() < 1)
+        {
+            UE_LOG(LogTemp, Display, TEXT("osf.Replay.Dump File [Seconds=0]"));
+            return;
+        }
+
+        FReplayReader Reader;
+        if (!Reader.Open(Args[0]))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Replay: cannot read %s"), *Args[0]);
+            return;
+        }
+
+        const double Duration = Reader.GetDuration();
+        UE_LOG(LogTemp, Display, TEXT("Replay %s: %.1f s, %d frames in %d chunks, %lld bytes (%.0f KB per minute)"),
+            *Args[0], Duration, Reader.GetNumFrames(), Reader.GetNumChunks(), Reader.GetFileSize(),
+            Duration > 0.0 ? Reader.GetFileSize() / 1024.0 / (Duration / 60.0) : 0.0);
+
+        const FReplayFrame* F = Reader.Seek(Args.Num() > 1 ? FCString::Atod(*Args[1]) : 0.0);
+        if (!F) return;
+
+        UE_LOG(LogTemp, Display, TEXT("t=%.3f ball %s vel %s, possession team %d player %d"),
+            F->Time, *F->BallPos.ToCompactString(), *F->BallVel.ToCompactString(), F->PossessionTeam, F->PossessionPlayer);
+        for (int32 i = 0; i < F->Players.Num(); ++i)
+        {
+            const FReplayPlayer& P = F->Players[i];
+            if (!P.bValid) continue;
+            UE_LOG(LogTemp, Display, TEXT("  [%d] team %d slot %d%s  pos %s  vel %s  yaw %.0f"),
+                i, P.Team, P.Slot, P.bHuman ? TEXT(" (human)") : TEXT(""), *P.Pos.ToCompactString(), *P.Vel.ToCompactString(), P.Yaw);
+        }
+        for (const FReplayEvent& E : F->Events)
+        {
+            UE_LOG(LogTemp, Display, TEXT("  event %d player %d team %d value %s"),
+                static_cast<int32>(E.Type), E.Player, E.Team, *E.Value.ToCompactString());
+        }
+    }
+
+    FAutoConsoleCommand GReplayDumpCommand(
+        TEXT("osf.Replay.Dump"),
+        TEXT("Log a recorded match at a time, no world needed: osf.Replay.Dump File [Seconds=0]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&DumpReplayCommand));
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Pipe.h"
+
+struct FMatchSnapshot;
+class FArchive;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** What happened in a frame besides movement. */
+enum class EReplayEvent : uint8
+{
+    Kick,       // Value: ball velocity (cm/s)
+    PassInput,  // human pass pressed; Value: aim
+    ShootInput, // human shot pressed; Value: aim
+    Sprint,     // Value.X: strength
+    Switch,     // human control moved to Player
+    Restart,    // Team restarts; Value: spot
+    Goal        // Team scored
+};
+
+struct FReplayEvent
+{
+    EReplayEvent Type = EReplayEvent::Kick;
+    int32   Player = INDEX_NONE; // snapshot index
+    int32   Team = INDEX_NONE;
+    FVector Value = FVector::ZeroVector; // stored to 0.01
+};
+
+struct FReplayPlayer
+{
+    FVector Pos = FVector::ZeroVector;  // cm, stored to 1
+    FVector Vel = FVector::ZeroVector;  // cm/s, stored to 1
+    float   Yaw = 0.f;                  // degrees, stored to 1/65536 of a turn
+    uint8   Team = 0;
+    int32   Slot = 0;
+    bool    bValid = false;
+    bool    bHuman = false;
+};
+
+/** One recorded frame, decoded. */
+struct FReplayFrame
+{
+    double  Time = 0.0; // s since recording started
+    FVector BallPos = FVector::ZeroVector;
+    FVector BallVel = FVector::ZeroVector;
+    int32   PossessionPlayer = INDEX_NONE; // snapshot index
+    int32   PossessionTeam = INDEX_NONE;
+    TArray<FReplayPlayer> Players;  // snapshot order: team 0 by slot, then team 1
+    TArray<FReplayEvent> Events;    // since the previous recorded frame
+};
+
+/** Frames as integers: what the encoder writes deltas of. */
+struct FReplayState
+{
+    int64 TimeUs = 0;
+    int32 Ball[6] = { 0, 0, 0, 0, 0, 0 };   // pos, vel
+    int32 PossessionPlayer = INDEX_NONE;
+    int32 PossessionTeam = INDEX_NONE;
+    int32 NumTeam0 = 0;
+    TArray<uint8> Flags;    // per player: valid, human
+    TArray<int32> Values;   // per player: pos xyz, vel xyz, yaw
+    TArray<FReplayEvent> Events;
+
+    static constexpr int32 ValuesPerPlayer = 7;
+    int32 NumPlayers() const { return Flags.Num(); }
+};
+
+struct FReplayRecorderParams
+{
+    float KeyframeInterval = 1.f; // s; a seek decodes at most this much
+    float FrameInterval = 0.f;    // s between recorded frames; 0 = every capture
+};
+
+/**
+ * Records a match as a compact binary stream: ball, every footballer's position,
+ * velocity and heading, possession and events, once per captured frame.
+ *
+ * Values are quantised to integers and each frame stores zigzag varint deltas
+ * from the previous one, so a player who moved a few centimetres costs a byte
+ * per axis. Every KeyframeInterval (and whenever the squad layout or who is
+ * human changes) a chunk starts with a keyframe of absolute values. Finished
+ * chunks go to a background pipe that appends them to the file and flushes,
+ * so a crash loses at most the chunk being recorded; Stop appends the keyframe
+ * index. Capture only encodes into memory.
+ *
+ * File: header, chunks ("CHNK", payload size, start time, frame count, frames),
+ * then the index ("INDX", entries of start time, offset, frame count) and a
+ * trailer (index offset, "OSFE"). Little-endian.
+ */
+class OSF_API FReplayRecorder
+{
+public:
+    FReplayRecorderParams Params;
+
+    FReplayRecorder();
+    ~FReplayRecorder();
+
+    /** Opens Filename (creating its directory) and records from the next Capture. False if the file cannot be written. */
+    bool Start(const FString& Filename);
+
+    /** Writes the last chunk and the index and closes the file; waits for the writer. */
+    void Stop();
+
+    bool IsRecording() const { return File != nullptr; }
+    const FString& GetFilename() const { return Filename; }
+
+    /** Goes with the next captured frame. */
+    void AddEvent(const FReplayEvent& Event) { if (IsRecording()) Pending.Add(Event); }
+
+    /** Records the snapshot's players and ball at Time (any clock; the first capture is time 0). */
+    void Capture(const FMatchSnapshot& Snap, double Time, int32 PossessionPlayer, int32 PossessionTeam);
+
+    // Totals since Start
+    int64 BytesRecorded = 0;
+    int32 FramesRecorded = 0;
+    float LastCaptureMicros = 0.f;
+
+private:
+    void FlushChunk();
+
+    TUniquePtr<FArchive> File;
+    FString Filename;
+    UE::Tasks::FPipe Writer;
+
+    double StartTime = 0.0;
+    int64 LastFrameUs = 0;
+    FReplayState Prev;
+    FReplayState Cur;
+    TArray<FReplayEvent> Pending;
+
+    TArray<uint8> Chunk;    // frames of the open chunk
+    int64 ChunkStartUs = 0;
+    int32 ChunkFrames = 0;
+    int64 FileOffset = 0;   // where the open chunk will go
+
+    struct FIndexEntry { int64 StartUs; int64 Offset; int32 Frames; };
+    TArray<FIndexEntry> Index;
+};
+
+/**
+ * Plays a recording back from a memory-mapped file (or a loaded copy where
+ * mapping is unavailable). No world needed, so it runs in a headless build.
+ *
+ * Seek finds the chunk with a binary search on the keyframe index and decodes
+ * forward from its keyframe, or from the current frame when the target is
+ * ahead of it in the same chunk: O(log chunks) plus at most one keyframe
+ * interval of frames. A recording cut short has no index; Open rebuilds it by
+ * walking the chunk headers.
+ */
+class OSF_API FReplayReader
+{
+public:
+    FReplayReader();
+    ~FReplayReader();
+
+    bool Open(const FString& Filename);
+    void Close();
+    bool IsOpen() const { return Data != nullptr; }
+
+    double GetDuration() const { return Duration; }
+    int32 GetNumChunks() const { return Index.Num(); }
+    int32 GetNumFrames() const { return NumFrames; }
+    int64 GetFileSize() const { return Size; }
+
+    /** Frame at or before Time, clamped to the recording; null if nothing is open or the data is damaged. */
+    const FReplayFrame* Seek(double Time);
+
+    /** The frame after the current one; null at the end. */
+    const FReplayFrame* Step();
+
+    const FReplayFrame& GetFrame() const { return Frame; }
+
+private:
+    bool EnterChunk(int32 ChunkIdx);
+    bool DecodeNext();
+    bool PeekNextTime(int64& OutUs) const;
+    void BuildFrame();
+
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    TArray<uint8> Loaded;
+    const uint8* Data = nullptr;
+    int64 Size = 0;
+
+    struct FIndexEntry { int64 StartUs; int64 Offset; int32 Frames; };
+    TArray<FIndexEntry> Index;
+    int32 NumFrames = 0;
+    double Duration = 0.0; // time of the last frame
+
+    // Decoder position
+    int32 ChunkIdx = INDEX_NONE;
+    int32 FrameInChunk = 0;
+    int64 Cursor = 0;
+    int64 ChunkEnd = 0;
+    FReplayState State;
+    FReplayFrame Frame;
+};
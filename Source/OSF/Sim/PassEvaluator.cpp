@@ -0,0 +1,275 @@
+#include "Sim/PassEvaluator.h"
+
+#include "Math/VectorRegister.h"
+
+#include "MatchSnapshot.h"
+#include "OSFStats.h"
+#include "Sim/BallFlight.h"
+#include "Sim/KickSolver.h"
+#include "Sim/MatchKernel.h"
+#include "Sim/PitchControl.h"
+
+// ---------------- Ball model ----------------
+// With v = v0 - k s, t = -ln(1 - k s / v0) / k. The mean of the two end speeds is
+// a third short on a 40 m pass, which hides how late the receiver is.
+float FPassEvaluator::BallTime(float Length, float V0) const
+{
+    const float X = (V0 > 0.f) ? Params.BallDrag * Length / V0 : 1.f;
+    if (X >= 1.f) return TNumericLimits<float>::Max();
+    return (X < 1.e-4f) ? Length / V0 : -FMath::Loge(1.f - X) / Params.BallDrag;
+}
+
+float FPassEvaluator::KickSpeed(float Length) const
+{
+    const float V0 = FMath::Clamp(Params.ArrivalSpeed + Params.BallDrag * Length, Params.MinSpeed, Params.MaxSpeed);
+    return (V0 - Params.BallDrag * Length > 0.f) ? V0 : 0.f;
+}
+
+float FPassEvaluator::FitBallDrag(const FBallParams& Ball, float ArrivalSpeed, float MinLength, float MaxLength)
+{
+    // Rolling: dv/dt = -(c + q v^2), so v^2 + c/q falls as exp(-2 q s) with distance
+    const float C = Ball.RollingResistance * Ball.Gravity;
+    const float R = Ball.Radius * 0.01f;
+    const float Q = 0.5f * Ball.AirDensity * Ball.DragCoeff * PI * R * R / Ball.Mass * 0.01f;
+
+    constexpr int32 NumSamples = 8;
+    double Num = 0.0, Den = 0.0;
+    for (int32 i = 0; i < NumSamples; ++i)
+    {
+        const double L = FMath::Lerp<double>(MinLength, MaxLength, double(i) / (NumSamples - 1));
+        const double VaSq = double(ArrivalSpeed) * ArrivalSpeed;
+        const double V0 = (Q > 0.f)
+            ? FMath::Sqrt((VaSq + C / Q) * FMath::Exp(2.0 * Q * L) - C / Q)
+            : FMath::Sqrt(VaSq + 2.0 * C * L);
+        Num += L * (V0 - ArrivalSpeed);
+        Den += L * L;
+    }
+    return Den > 0.0 ? static_cast<float>(Num / Den) : 0.f;
+}
+
+// ---------------- Lanes ----------------
+float FPassEvaluator::LaneRisk(const float* OppX, const float* OppY, const float* OppSpeed, int32 NumLanes,
+                               const FVector& From, const FVector& Dir, float Length, float V0, float Drag) const
+{
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = VectorOneFloat();
+    const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+    const VectorRegister4Float Bx = VectorSetFloat1(static_cast<float>(From.X));
+    const VectorRegister4Float By = VectorSetFloat1(static_cast<float>(From.Y));
+    const VectorRegister4Float Ux = VectorSetFloat1(static_cast<float>(Dir.X));
+    const VectorRegister4Float Uy = VectorSetFloat1(static_cast<float>(Dir.Y));
+    const VectorRegister4Float L = VectorSetFloat1(Length);
+    // Ball time to S: -ln(1 - k S / v0) / k, floored so a ball that stops short is never there first
+    const float K = FMath::Max(Drag, 1.e-3f);
+    const VectorRegister4Float KOverV0 = VectorSetFloat1(K / FMath::Max(V0, 1.f));
+    const VectorRegister4Float InvK = VectorSetFloat1(1.f / K);
+    const VectorRegister4Float MinRemain = VectorSetFloat1(1.e-6f);
+    const VectorRegister4Float Radius = VectorSetFloat1(Params.ControlRadius);
+    const VectorRegister4Float Reaction = VectorSetFloat1(Params.ReactionTime);
+    const VectorRegister4Float InvSoft = VectorSetFloat1(0.5f / FMath::Max(Params.RiskSoftness, KINDA_SMALL_NUMBER));
+
+    VectorRegister4Float Safe = One;
+    for (int32 i = 0; i < NumLanes; i += 4)
+    {
+        const VectorRegister4Float Ox = VectorLoad(OppX + i);
+        const VectorRegister4Float Oy = VectorLoad(OppY + i);
+        const VectorRegister4Float InvSpeed = VectorDivide(One, VectorLoad(OppSpeed + i));
+
+        // Chance this opponent beats the ball to the point S along the lane
+        auto Beat = [&](const VectorRegister4Float& S)
+            {
+                const VectorRegister4Float Dx = VectorSubtract(Ox, VectorMultiplyAdd(Ux, S, Bx));
+                const VectorRegister4Float Dy = VectorSubtract(Oy, VectorMultiplyAdd(Uy, S, By));
+                const VectorRegister4Float Reach = VectorMax(VectorSubtract(VectorSqrt(VectorMultiplyAdd(Dx, Dx, VectorMultiply(Dy, Dy))), Radius), Zero);
+                const VectorRegister4Float TOpp = VectorMultiplyAdd(Reach, InvSpeed, Reaction);
+                const VectorRegister4Float Remain = VectorMax(VectorSubtract(One, VectorMultiply(KOverV0, S)), MinRemain);
+                const VectorRegister4Float TBall = VectorMultiply(VectorNegate(VectorLog(Remain)), InvK);
+                const VectorRegister4Float P = VectorMultiplyAdd(VectorSubtract(TBall, TOpp), InvSoft, Half);
+                return VectorMin(VectorMax(P, Zero), One);
+            };
+
+        const VectorRegister4Float Along = VectorAdd(VectorMultiply(VectorSubtract(Ox, Bx), Ux), VectorMultiply(VectorSubtract(Oy, By), Uy));
+        const VectorRegister4Float S0 = VectorMin(VectorMax(Along, Zero), L);
+        const VectorRegister4Float S1 = VectorMultiply(VectorAdd(S0, L), Half);
+        const VectorRegister4Float P = VectorMax(VectorMax(Beat(S0), Beat(S1)), Beat(L));
+        Safe = VectorMultiply(Safe, VectorSubtract(One, P));
+    }
+
+    alignas(16) float Lanes[4];
+    VectorStoreAligned(Safe, Lanes);
+    return 1.f - Lanes[0] * Lanes[1] * Lanes[2] * Lanes[3];
+}
+
+// ---------------- Evaluate ----------------
+bool FPassEvaluator::Evaluate(const FMatchSnapshot& Snap, const FTacticParams& Pitch, int32 PasserIdx,
+                              const FVector& BallPos, const FVector& Aim, FPassChoice& Out) const
+{
+    OSF_SCOPE(PassEval);
+    Out = FPassChoice();
+    if (!Snap.IsValidEntry(PasserIdx)) return false;
+
+    const int32 TeamID = Snap.Team[PasserIdx];
+    const int32 OppID = 1 - TeamID;
+    const float Dir = (TeamID == 0) ? +1.f : -1.f;
+
+    // Opponents packed from lane 0, padded with far-away players that never threaten
+    TArray<float, TInlineAllocator<64>> OppX, OppY, OppSpeed;
+    for (int32 i = Snap.TeamBegin[OppID]; i < Snap.TeamEnd[OppID]; ++i)
+    {
+        if (!Snap.Valid[i]) continue;
+        OppX.Add(Snap.PosX[i]);
+        OppY.Add(Snap.PosY[i]);
+        OppSpeed.Add(Snap.MaxSpeed[i]);
+    }
+    while (OppX.Num() % 4 != 0 || OppX.Num() == 0)
+    {
+        OppX.Add(FMatchSnapshot::FarSentinel);
+        OppY.Add(FMatchSnapshot::FarSentinel);
+        OppSpeed.Add(1.f);
+    }
+
+    const FVector AimDir = Aim.GetSafeNormal2D();
+    const float MaxX = Pitch.HalfLength - Params.LineMargin;
+    const float MaxY = Pitch.HalfWidth - Params.LineMargin;
+
+    // Candidates first, so their kicks can be solved in one batch
+    struct FCandidate
+    {
+        int32 Receiver;
+        FVector Target;
+        bool bThrough;
+    };
+    TArray<FCandidate, TInlineAllocator<MaxCandidates>> Candidates;
+    auto Consider = [&](int32 Receiver, const FVector& Target, bool bThrough)
+        {
+            if (Candidates.Num() >= MaxCandidates) return;
+            if (FMath::Abs(Target.X - Pitch.FieldCentre.X) > MaxX || FMath::Abs(Target.Y - Pitch.FieldCentre.Y) > MaxY) return;
+
+            const float Length = FVector::Dist2D(BallPos, Target);
+            if (Length < Params.MinLength || Length > Params.MaxLength) return;
+            Candidates.Add({ Receiver, Target, bThrough });
+        };
+
+    for (int32 j = Snap.TeamBegin[TeamID]; j < Snap.TeamEnd[TeamID]; ++j)
+    {
+        if (j == PasserIdx || !Snap.Valid[j]) continue;
+
+        // To feet, led by where they are running; then into space ahead of them
+        const FVector P = Snap.GetPos(j);
+        const float Direct = FVector::Dist2D(BallPos, P);
+        const float Lead = FMath::Min(BallTime(Direct, FMath::Max(KickSpeed(Direct), Params.MinSpeed)), 2.f);
+        Consider(j, P + Snap.GetVel(j) * Lead, false);
+        Consider(j, P + FVector(Dir * Params.ThroughNear, 0.f, 0.f), true);
+        Consider(j, P + FVector(Dir * Params.ThroughFar, 0.f, 0.f), true);
+    }
+
+    // Every candidate scored on the linear model: ground passes arriving at ArrivalSpeed, within the kick speed limits
+    const bool bSpace = Control && Control->IsConfigured();
+    auto Score = [&](const FCandidate& C, const FVector& U, float Length, float V0, float TBall, float Drag, float& OutRisk)
+        {
+            OutRisk = LaneRisk(OppX.GetData(), OppY.GetData(), OppSpeed.GetData(), OppX.Num(), BallPos, U, Length, V0, Drag);
+
+            const float ReceiverReach = FMath::Max(FVector::Dist2D(Snap.GetPos(C.Receiver), C.Target) - Params.ControlRadius, 0.f);
+            const float Late = FMath::Max(Params.ReactionTime + ReceiverReach / Snap.MaxSpeed[C.Receiver] - TBall, 0.f);
+            const float Gain = (C.Target.X - BallPos.X) * Dir * 0.01f;
+
+            float S = Params.ProgressWeight * Gain - Params.RiskWeight * OutRisk - Params.LateWeight * Late;
+            if (!AimDir.IsZero()) S += Params.AimWeight * FVector::DotProduct(U, AimDir);
+            if (bSpace) S += Params.SpaceWeight * Control->Control(TeamID, C.Target.X, C.Target.Y);
+            return S;
+        };
+
+    struct FScored
+    {
+        int32 Candidate;
+        float Score;
+        float Risk;
+        float V0;
+        float BallTime;
+    };
+    TArray<FScored, TInlineAllocator<MaxCandidates>> Scored;
+    for (int32 c = 0; c < Candidates.Num(); ++c)
+    {
+        const FCandidate& C = Candidates[c];
+        const FVector Lane = FVector(C.Target.X - BallPos.X, C.Target.Y - BallPos.Y, 0.f);
+        const float Length = Lane.Size();
+        const float V0 = KickSpeed(Length);
+        if (V0 <= 0.f) continue;
+
+        FScored& S = Scored.AddDefaulted_GetRef();
+        S.Candidate = c;
+        S.V0 = V0;
+        S.BallTime = BallTime(Length, V0);
+        S.Score = Score(C, Lane / Length, Length, V0, S.BallTime, Params.BallDrag, S.Risk);
+    }
+    if (Scored.Num() == 0) return false;
+
+    auto Choose = [&](const FCandidate& C, float Score, float Risk, float TBall, const FVector& Velocity, const FVector& Spin)
+        {
+            Out.Receiver = C.Receiver;
+            Out.Target = FVector(C.Target.X, C.Target.Y, BallPos.Z);
+            Out.Velocity = Velocity;
+            Out.Spin = Spin;
+            Out.Score = Score;
+            Out.Risk = Risk;
+            Out.BallTime = TBall;
+            Out.bThrough = C.bThrough;
+        };
+
+    if (!Kicks || !Kicks->IsConfigured())
+    {
+        const FScored* Best = &Scored[0];
+        for (const FScored& S : Scored) if (S.Score > Best->Score) Best = &S;
+
+        const FCandidate& C = Candidates[Best->Candidate];
+        const FVector U = FVector(C.Target.X - BallPos.X, C.Target.Y - BallPos.Y, 0.f).GetSafeNormal();
+        Choose(C, Best->Score, Best->Risk, Best->BallTime, U * Best->V0, FVector::ZeroVector);
+        return true;
+    }
+
+    // Solved: the best SolveTopK in one batch against the real ball, rescored with the
+    // linear model through the solved time so the lane points stay consistent with it
+    Scored.Sort([](const FScored& A, const FScored& B) { return A.Score > B.Score; });
+    if (Params.SolveTopK > 0 && Scored.Num() > Params.SolveTopK)
+    {
+        Scored.SetNum(Params.SolveTopK, EAllowShrinking::No);
+    }
+
+    TArray<FKickTarget, TInlineAllocator<MaxCandidates>> Targets;
+    for (const FScored& S : Scored)
+    {
+        FKickTarget& T = Targets.AddDefaulted_GetRef();
+        T.From = BallPos;
+        T.To = Candidates[S.Candidate].Target;
+        T.Value = Params.ArrivalSpeed;
+    }
+    FKickQuery Query;
+    Query.Goal = EKickGoal::ArrivalSpeed;
+    Query.bGround = true;
+    Query.MinSpeed = Params.MinSpeed;
+    Query.MaxSpeed = Params.MaxSpeed;
+    TArray<FKickSolution, TInlineAllocator<MaxCandidates>> Solutions;
+    Solutions.SetNum(Targets.Num());
+    Kicks->Solve(Query, Targets, Solutions);
+
+    bool bFound = false;
+    for (int32 k = 0; k < Scored.Num(); ++k)
+    {
+        const FKickSolution& Kick = Solutions[k];
+        if (!Kick.bReached) continue;
+
+        const FCandidate& C = Candidates[Scored[k].Candidate];
+        const FVector Lane = FVector(C.Target.X - BallPos.X, C.Target.Y - BallPos.Y, 0.f);
+        const float Length = Lane.Size();
+        const float Drag = FMath::Max((Kick.Speed - Kick.ArrivalSpeed) / Length, 0.f); // linear through the two end speeds
+
+        float Risk;
+        const float S = Score(C, Lane / Length, Length, Kick.Speed, Kick.Time, Drag, Risk);
+        if (!bFound || S > Out.Score)
+        {
+            bFound = true;
+            Choose(C, S, Risk, Kick.Time, Kick.Velocity, Kick.Spin);
+        }
+    }
+    return bFound;
+}
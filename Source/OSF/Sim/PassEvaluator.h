@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMatchSnapshot;
+struct FTacticParams;
+struct FBallParams;
+class FKickSolver;
+class FPitchControl;
+
+/** Ground-pass model and scoring weights. */
+struct FPassParams
+{
+    // Ball: speed falls linearly with distance, v = v0 - BallDrag * s (exponential drag in time);
+    // 0.21 is FitBallDrag for FBallParams' defaults
+    float BallDrag = 0.21f;       // 1/s
+    float ArrivalSpeed = 500.f;   // cm/s at the target
+    float MinSpeed = 600.f;
+    float MaxSpeed = 2600.f;
+
+    // Who can get there
+    float ReactionTime = 0.2f;    // s before anyone moves for the ball
+    float ControlRadius = 70.f;   // cm
+    float RiskSoftness = 0.25f;   // s of margin over which a lane goes from safe to lost
+
+    // Candidates
+    float MinLength = 300.f;
+    float MaxLength = 4000.f;
+    float ThroughNear = 500.f;    // through balls: this far and ThroughFar ahead of each teammate
+    float ThroughFar = 1000.f;
+    float LineMargin = 150.f;     // targets closer than this to a line are skipped
+    int32 SolveTopK = 8;          // with a kick solver, only the best this many on the linear model are solved (0 = all)
+
+    // Score = ProgressWeight * metres gained - RiskWeight * risk - LateWeight * receiver late (s) + AimWeight * cos(aim)
+    //       + SpaceWeight * the passing team's control of the target (0..1, with pitch control)
+    float ProgressWeight = 0.1f;
+    float RiskWeight = 2.f;
+    float LateWeight = 1.f;
+    float AimWeight = 0.f;
+    float SpaceWeight = 0.5f;
+};
+
+struct FPassChoice
+{
+    int32   Receiver = INDEX_NONE; // snapshot index
+    FVector Target = FVector::ZeroVector;
+    FVector Velocity = FVector::ZeroVector; // kick velocity, ground pass
+    FVector Spin = FVector::ZeroVector;     // rad/s; rolling spin when the kick solver chose the pass
+    float   Score = 0.f;
+    float   Risk = 0.f;       // 0..1, chance an opponent gets there first
+    float   BallTime = 0.f;   // s to the target
+    bool    bThrough = false;
+};
+
+/**
+ * Picks a pass for the player on the ball: every teammate to feet (led by
+ * their velocity) and two through-ball points ahead of each, scored on the
+ * same snapshot the team AI reads.
+ *
+ * Each candidate lane is tested against every opponent analytically: the
+ * opponent's run (reaction plus distance at max speed) to the closest point
+ * of the lane, its midpoint beyond that and the target, against the ball's
+ * time to the same points. Opponents go four per SIMD register and the
+ * per-opponent risks combine as independent events. No traces, no
+ * allocation below 64 opponents, and a bounded candidate count.
+ *
+ * With a kick solver, the best Params.SolveTopK candidates on the linear
+ * model are solved in one batch against the real ball (rolling resistance
+ * and drag) and rescored, their lane times from the linear model refitted to
+ * the solved time per candidate; the pick is among those.
+ * With pitch control, targets in the team's space score higher: the receiver
+ * has room after the ball arrives, which the lane test does not look at.
+ */
+class OSF_API FPassEvaluator
+{
+public:
+    FPassParams Params;
+
+    /** Optional; when set and configured, kick speeds and ball times come from it instead of the linear model. */
+    const FKickSolver* Kicks = nullptr;
+
+    /** Optional; when set and configured, adds Params.SpaceWeight times the team's control of each target. */
+    const FPitchControl* Control = nullptr;
+
+    static constexpr int32 MaxCandidates = 96;
+
+    /**
+     * Best pass from PasserIdx with the ball at BallPos. Aim (XY, may be zero) biases
+     * candidates by Params.AimWeight for assisted human passes. False if no candidate.
+     */
+    bool Evaluate(const FMatchSnapshot& Snap, const FTacticParams& Pitch, int32 PasserIdx,
+                  const FVector& BallPos, const FVector& Aim, FPassChoice& Out) const;
+
+    /** Ball time over Length for a kick at V0 (the model above). */
+    float BallTime(float Length, float V0) const;
+
+    /** Kick speed that arrives at ArrivalSpeed over Length, clamped; 0 if it cannot get there. */
+    float KickSpeed(float Length) const;
+
+    /**
+     * BallDrag that best matches a ball rolling under Ball's rolling resistance and quadratic drag,
+     * for passes arriving at ArrivalSpeed over [MinLength, MaxLength] (least squares on the kick speed).
+     */
+    static float FitBallDrag(const FBallParams& Ball, float ArrivalSpeed, float MinLength, float MaxLength);
+
+private:
+    /** Chance some opponent in the packed lanes reaches the lane Dir * [0, Length] first. */
+    float LaneRisk(const float* OppX, const float* OppY, const float* OppSpeed, int32 NumLanes,
+                   const FVector& From, const FVector& Dir, float Length, float V0, float Drag) const;
+};
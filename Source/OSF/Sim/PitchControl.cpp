@@ -0,0 +1,161 @@
+#include "Sim/PitchControl.h"
+
+#include "Math/VectorRegister.h"
+
+#include "MatchSnapshot.h"
+#include "OSFStats.h"
+#include "Sim/ReachModel.h"
+
+// ---------------- Grid ----------------
+void FPitchControl::Configure(const FVector& Centre, float HalfLength, float HalfWidth)
+{
+    CellSize = FMath::Max(Params.CellSize, 50.f);
+    InvCellSize = 1.f / CellSize;
+    NumX = Align(FMath::Max(FMath::CeilToInt(2.f * HalfLength * InvCellSize), 1), 4);
+    NumY = FMath::Max(FMath::CeilToInt(2.f * HalfWidth * InvCellSize), 2);
+    Origin = FVector2f(Centre.X - HalfLength + 0.5f * CellSize, Centre.Y - HalfWidth + 0.5f * CellSize);
+
+    for (TArray<float>& Field : Arrival) Field.Init(Params.Horizon, NumX * NumY);
+    Dirty.Init(1, NumX * NumY / 4);
+    Invalidate();
+}
+
+void FPitchControl::MarkAround(float X, float Y, float Radius)
+{
+    const float R2 = Radius * Radius;
+    const int32 IY0 = FMath::Max(FMath::CeilToInt((Y - Radius - Origin.Y) * InvCellSize), 0);
+    const int32 IY1 = FMath::Min(FMath::FloorToInt((Y + Radius - Origin.Y) * InvCellSize), NumY - 1);
+    for (int32 IY = IY0; IY <= IY1; ++IY)
+    {
+        // Cells of this row whose centre is within Radius
+        const float DY = Origin.Y + IY * CellSize - Y;
+        const float HalfSpan = FMath::Sqrt(FMath::Max(R2 - DY * DY, 0.f));
+        const int32 IX0 = FMath::Max(FMath::CeilToInt((X - HalfSpan - Origin.X) * InvCellSize), 0);
+        const int32 IX1 = FMath::Min(FMath::FloorToInt((X + HalfSpan - Origin.X) * InvCellSize), NumX - 1);
+        if (IX0 > IX1) continue;
+
+        uint8* Row = Dirty.GetData() + IY * (NumX / 4);
+        FMemory::Memset(Row + IX0 / 4, 1, IX1 / 4 - IX0 / 4 + 1);
+    }
+}
+
+// ---------------- Update ----------------
+int32 FPitchControl::Update(const FMatchSnapshot& Snap)
+{
+    OSF_SCOPE(PitchControl);
+    LastCellsUpdated = 0;
+    if (!IsConfigured()) return 0;
+
+    const uint32 StartCycles = FPlatformTime::Cycles();
+    const float RunTime = FMath::Max(Params.Horizon - Params.ReactionTime, 0.f);
+    const float Threshold2 = FMath::Square(Params.MoveThreshold);
+
+    // A new layout (or the first update): every cell, and everyone's state becomes the reference
+    const bool bFull = RefNum != Snap.Num;
+    if (bFull)
+    {
+        RefNum = Snap.Num;
+        RefX.SetNumUninitialized(Snap.Num);
+        RefY.SetNumUninitialized(Snap.Num);
+        RefVX.SetNumUninitialized(Snap.Num);
+        RefVY.SetNumUninitialized(Snap.Num);
+        RefReach.SetNumUninitialized(Snap.Num);
+        RefValid.SetNumZeroed(Snap.Num);
+        FMemory::Memset(Dirty.GetData(), 1, Dirty.Num());
+    }
+
+    for (int32 i = 0; i < Snap.Num; ++i)
+    {
+        const bool bValid = Snap.Valid[i] != 0;
+        if (!bFull)
+        {
+            if (!bValid && !RefValid[i]) continue;
+            if (bValid && RefValid[i])
+            {
+                const float DX = Snap.PosX[i] - RefX[i];
+                const float DY = Snap.PosY[i] - RefY[i];
+                const float DVX = (Snap.VelX[i] - RefVX[i]) * Params.VelocityLead;
+                const float DVY = (Snap.VelY[i] - RefVY[i]) * Params.VelocityLead;
+                if (DX * DX + DY * DY <= Threshold2 && DVX * DVX + DVY * DVY <= Threshold2) continue;
+            }
+
+            // Their old cells lose them, their new cells gain them
+            if (RefValid[i]) MarkAround(RefX[i], RefY[i], RefReach[i]);
+        }
+
+        RefX[i] = Snap.PosX[i];
+        RefY[i] = Snap.PosY[i];
+        RefVX[i] = Snap.VelX[i];
+        RefVY[i] = Snap.VelY[i];
+        RefReach[i] = Params.ControlRadius + Snap.MaxSpeed[i] * RunTime;
+        RefValid[i] = bValid ? 1 : 0;
+        if (!bFull && bValid) MarkAround(RefX[i], RefY[i], RefReach[i]);
+    }
+
+    // Every player as it is now, splatted across the four cells of a block
+    TArray<FReachLanes, TInlineAllocator<32>> Players[2];
+    for (int32 i = 0; i < Snap.Num; ++i)
+    {
+        if (!Snap.Valid[i]) continue;
+        Players[Snap.Team[i]].Add(FReachLanes::Splat(Snap, i, Params.ControlRadius, Params.ReactionTime));
+    }
+
+    const VectorRegister4Float Horizon = VectorSetFloat1(Params.Horizon);
+    const VectorRegister4Float LaneX = MakeVectorRegisterFloat(0.f, CellSize, 2.f * CellSize, 3.f * CellSize);
+
+    // NumX is a multiple of 4, so block b holds cells [4b, 4b + 4) of one row
+    int32 Cells = 0;
+    for (int32 Block = 0; Block < Dirty.Num(); ++Block)
+    {
+        if (!Dirty[Block]) continue;
+        Dirty[Block] = 0;
+
+        const int32 First = Block * 4;
+        const VectorRegister4Float Bx = VectorAdd(VectorSetFloat1(Origin.X + (First % NumX) * CellSize), LaneX);
+        const VectorRegister4Float By = VectorSetFloat1(Origin.Y + (First / NumX) * CellSize);
+        for (int32 TeamID = 0; TeamID < 2; ++TeamID)
+        {
+            VectorRegister4Float Best = Horizon;
+            for (const FReachLanes& P : Players[TeamID])
+            {
+                Best = VectorMin(Best, P.TimeTo(Bx, By));
+            }
+            VectorStore(Best, Arrival[TeamID].GetData() + First);
+        }
+        Cells += 4;
+    }
+
+    LastCellsUpdated = Cells;
+    LastUpdateMicros = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles) * 1000.f;
+    return Cells;
+}
+
+// ---------------- Queries ----------------
+float FPitchControl::Sample(const TArray<float>& Field, float X, float Y) const
+{
+    const float FX = FMath::Clamp((X - Origin.X) * InvCellSize, 0.f, float(NumX - 1));
+    const float FY = FMath::Clamp((Y - Origin.Y) * InvCellSize, 0.f, float(NumY - 1));
+    const int32 IX = FMath::Min(FMath::FloorToInt(FX), NumX - 2);
+    const int32 IY = FMath::Min(FMath::FloorToInt(FY), NumY - 2);
+    const float TX = FX - IX;
+    const float TY = FY - IY;
+
+    const float* Row0 = Field.GetData() + IY * NumX + IX;
+    const float* Row1 = Row0 + NumX;
+    return FMath::Lerp(FMath::Lerp(Row0[0], Row0[1], TX), FMath::Lerp(Row1[0], Row1[1], TX), TY);
+}
+
+float FPitchControl::ArrivalTime(int32 TeamID, float X, float Y) const
+{
+    return IsConfigured() ? Sample(Arrival[TeamID], X, Y) : Params.Horizon;
+}
+
+float FPitchControl::Margin(int32 TeamID, float X, float Y) const
+{
+    return IsConfigured() ? Sample(Arrival[1 - TeamID], X, Y) - Sample(Arrival[TeamID], X, Y) : 0.f;
+}
+
+float FPitchControl::Control(int32 TeamID, float X, float Y) const
+{
+    return FMath::Clamp(0.5f + Margin(TeamID, X, Y) * 0.5f / FMath::Max(Params.Softness, KINDA_SMALL_NUMBER), 0.f, 1.f);
+}
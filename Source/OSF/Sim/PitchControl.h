@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMatchSnapshot;
+
+struct FPitchControlParams
+{
+    float CellSize = 300.f;       // cm; read by Configure
+    float Horizon = 3.f;          // s; arrival times are capped here, which bounds how far a player's run reaches on the grid
+    float ReactionTime = 0.2f;
+    float ControlRadius = 70.f;
+    float Softness = 0.5f;        // s of margin over which a point goes from contested to owned
+
+    // A player's cells are recomputed once their position, or their velocity times VelocityLead, drifts this far
+    float MoveThreshold = 100.f;  // cm
+    float VelocityLead = 0.5f;    // s
+};
+
+/**
+ * Which team gets to each part of the pitch first, and by how much: a coarse
+ * grid holding, per cell and team, the earliest arrival of any of its players
+ * (FReachLanes' run model, the intercept solver's).
+ *
+ * Cells are computed four at a time along a row against one player per
+ * register. An update only recomputes the cells within reach of players who
+ * drifted past MoveThreshold since their cells were last computed, around
+ * both where they were and where they are; everything else keeps its value.
+ * Arrival times are capped at Horizon, so a player beyond
+ * ControlRadius + MaxSpeed * (Horizon - ReactionTime) of a cell cannot change
+ * it. Queries are bilinear, read-only and safe from several threads.
+ */
+class OSF_API FPitchControl
+{
+public:
+    FPitchControlParams Params;
+
+    /** Grid over Centre +- (HalfLength, HalfWidth); the next Update recomputes every cell. */
+    void Configure(const FVector& Centre, float HalfLength, float HalfWidth);
+    bool IsConfigured() const { return NumX > 0; }
+
+    /** Next Update recomputes every cell (e.g. after changing Params). */
+    void Invalidate() { RefNum = INDEX_NONE; }
+
+    /**
+     * Recomputes the cells near players who drifted, or every cell on the first call and
+     * whenever the snapshot's layout changed. Returns the number of cells recomputed.
+     */
+    int32 Update(const FMatchSnapshot& Snap);
+
+    /** Earliest arrival of TeamID at (X, Y), s, capped at Horizon. */
+    float ArrivalTime(int32 TeamID, float X, float Y) const;
+
+    /** The other team's arrival minus TeamID's at (X, Y), s; positive where TeamID gets there first. */
+    float Margin(int32 TeamID, float X, float Y) const;
+
+    /** TeamID's share of (X, Y), 0..1: 0.5 contested, 1 when TeamID is there Softness or more before the other team. */
+    float Control(int32 TeamID, float X, float Y) const;
+
+    int32 GetNumCells() const { return NumX * NumY; }
+
+    // Last Update
+    int32 LastCellsUpdated = 0;
+    float LastUpdateMicros = 0.f;
+
+private:
+    void MarkAround(float X, float Y, float Radius);
+    float Sample(const TArray<float>& Field, float X, float Y) const;
+
+    FVector2f Origin = FVector2f::ZeroVector; // centre of cell (0, 0)
+    float CellSize = 0.f;
+    float InvCellSize = 0.f;
+    int32 NumX = 0;        // cells per row, a multiple of 4 (the last block may run past the line)
+    int32 NumY = 0;
+
+    TArray<float> Arrival[2];   // by team, row-major, Y rows of NumX
+    TArray<uint8> Dirty;        // by block of 4 cells along a row
+
+    // Per snapshot index: what the cells were last computed with, and how far that player reached
+    TArray<float> RefX, RefY, RefVX, RefVY, RefReach;
+    TArray<uint8> RefValid;
+    int32 RefNum = INDEX_NONE;
+};
@@ -0,0 +1,92 @@
+#include "Sim/PitchRules.h"
+
+bool FPitchRules::IsInPlay(const FVector& P) const
+{
+    const FPitchGeometry& G = Geometry;
+    return FMath::Abs(P.X - G.Centre.X) <= G.HalfLength + G.BallRadius
+        && FMath::Abs(P.Y - G.Centre.Y) <= G.HalfWidth + G.BallRadius;
+}
+
+bool FPitchRules::Sweep(const FVector& Prev, const FVector& Curr, int32 LastTouchTeam, FPitchEventInfo& Out) const
+{
+    // Balls already out (dead ball, teleports back in) never fire
+    if (!IsInPlay(Prev) || IsInPlay(Curr)) return false;
+
+    const FPitchGeometry& G = Geometry;
+    const FVector P0 = Prev - G.Centre;
+    const FVector D = Curr - Prev;
+    const float Lx = G.HalfLength + G.BallRadius;
+    const float Ly = G.HalfWidth + G.BallRadius;
+
+    // Entry parameter of each slab exit; P0 is inside, so a non-zero D component is guaranteed where it exits
+    auto Exit = [](float P, float Dir, float L, bool& bPositive)
+        {
+            if (P + Dir > L)  { bPositive = true;  return (L - P) / Dir; }
+            if (P + Dir < -L) { bPositive = false; return (-L - P) / Dir; }
+            return 2.f;
+        };
+
+    bool bPosX = false, bPosY = false;
+    const float Tx = Exit(P0.X, D.X, Lx, bPosX);
+    const float Ty = Exit(P0.Y, D.Y, Ly, bPosY);
+
+    Out = FPitchEventInfo();
+    if (Tx <= Ty)
+    {
+        Out.Alpha = FMath::Clamp(Tx, 0.f, 1.f);
+        Out.Crossing = Prev + D * Out.Alpha;
+        Out.bPositiveEnd = bPosX;
+
+        const int32 Defender = DefendingTeam(bPosX);
+        const FVector L = Out.Crossing - G.Centre;
+        const FPitchGoal& Goal = G.Goals[bPosX ? 1 : 0];
+        if (FMath::Abs(L.Y - Goal.CentreY) < Goal.HalfWidth - G.BallRadius && L.Z < Goal.CrossbarHeight - G.BallRadius)
+        {
+            Out.Type = EPitchEvent::Goal;
+            Out.Team = 1 - Defender;
+        }
+        else if (LastTouchTeam == Defender)
+        {
+            Out.Type = EPitchEvent::Corner;
+            Out.Team = 1 - Defender;
+        }
+        else
+        {
+            Out.Type = EPitchEvent::GoalKick;
+            Out.Team = Defender;
+        }
+    }
+    else
+    {
+        Out.Alpha = FMath::Clamp(Ty, 0.f, 1.f);
+        Out.Crossing = Prev + D * Out.Alpha;
+        Out.bPositiveEnd = bPosY;
+        Out.Type = EPitchEvent::ThrowIn;
+        Out.Team = (LastTouchTeam == 0 || LastTouchTeam == 1) ? 1 - LastTouchTeam : INDEX_NONE;
+    }
+    return true;
+}
+
+FVector FPitchRules::RestartLocation(const FPitchEventInfo& Event) const
+{
+    const FPitchGeometry& G = Geometry;
+    const FVector L = Event.Crossing - G.Centre;
+    const float EndX = Event.bPositiveEnd ? G.HalfLength : -G.HalfLength;
+
+    FVector Spot = FVector::ZeroVector;
+    switch (Event.Type)
+    {
+    case EPitchEvent::ThrowIn:
+        Spot = FVector(FMath::Clamp(L.X, -G.HalfLength, G.HalfLength), Event.bPositiveEnd ? G.HalfWidth : -G.HalfWidth, 0.f);
+        break;
+    case EPitchEvent::Corner:
+        Spot = FVector(EndX, (L.Y >= 0.f) ? G.HalfWidth : -G.HalfWidth, 0.f);
+        break;
+    case EPitchEvent::GoalKick:
+        Spot = FVector(EndX - FMath::Sign(EndX) * G.GoalAreaDepth, 0.f, 0.f);
+        break;
+    default:
+        break;
+    }
+    return G.Centre + Spot;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** What the ball did when it left play. */
+enum class EPitchEvent : uint8
+{
+    None,
+    Goal,
+    ThrowIn,
+    Corner,
+    GoalKick
+};
+
+struct FPitchEventInfo
+{
+    EPitchEvent Type = EPitchEvent::None;
+    int32 Team = INDEX_NONE;      // Goal: scoring team; restarts: team awarded the ball
+    bool  bPositiveEnd = false;   // crossed at +X (team 1's goal) or, for throw-ins, at +Y
+    FVector Crossing = FVector::ZeroVector; // ball centre where it became wholly over the line
+    float Alpha = 0.f;            // 0..1 along the swept segment
+};
+
+/** One goal mouth: inside of the posts and underside of the bar. */
+struct FPitchGoal
+{
+    float CentreY = 0.f;           // across, from FPitchGeometry::Centre
+    float HalfWidth = 366.f;       // centre to the inner face of either post
+    float CrossbarHeight = 244.f;  // above Centre.Z
+};
+
+/** Lines and goal mouths, centred on Centre with goals on the X axis. Team 0 defends -X. */
+struct FPitchGeometry
+{
+    FVector Centre = FVector::ZeroVector;
+    float HalfLength = 9000.f;     // goal line (by-line) distance from Centre
+    float HalfWidth = 6000.f;      // touchline distance from Centre
+    FPitchGoal Goals[2];           // by end: 0 at -X, 1 at +X
+    float BallRadius = 11.f;
+    float GoalAreaDepth = 550.f;   // goal kicks are taken this far in from the line
+};
+
+/**
+ * Laws of the game for the ball leaving the pitch, as a swept test.
+ *
+ * Sweep takes the ball centre at the previous and current physics step and
+ * finds where, if anywhere, the segment first leaves the pitch: the ball is out
+ * once it is wholly over a line, so the lines are pushed out by BallRadius.
+ * A by-line crossing with the whole ball inside the posts and under the bar
+ * (the mouth shrunk by BallRadius) is a goal, otherwise
+ * a corner or goal kick by who touched it last; a touchline crossing is a
+ * throw-in. The test is analytic, so a shot that covers the whole goal mouth
+ * in one step is still seen; the path between steps is taken as straight.
+ */
+struct OSF_API FPitchRules
+{
+    FPitchGeometry Geometry;
+
+    /** True and fills Out if the ball went out between Prev and Curr. Only a segment starting in play can fire. */
+    bool Sweep(const FVector& Prev, const FVector& Curr, int32 LastTouchTeam, FPitchEventInfo& Out) const;
+
+    /** Where play restarts after Event (on the Centre.Z plane); the centre spot for goals. */
+    FVector RestartLocation(const FPitchEventInfo& Event) const;
+
+    bool IsInPlay(const FVector& P) const;
+
+    /** Goal line crossed at +X belongs to team 1. */
+    static int32 DefendingTeam(bool bPositiveEnd) { return bPositiveEnd ? 1 : 0; }
+};
@@ -0,0 +1,356 @@
+#include "Sim/PointMassMatch.h"
+
+FPointMassMatch::FPointMassMatch(const FPointMassConfig& InConfig)
+    : Config(InConfig)
+{
+    Config.PlayersPerTeam = FMath::Max(Config.PlayersPerTeam, 1);
+
+    for (int32 TeamID = 0; TeamID < 2; ++TeamID)
+    {
+        Kernel[TeamID].Tactics = Config.Tactics[TeamID];
+        Kernel[TeamID].Tactics.FieldCentre = Config.Tactics[0].FieldCentre;
+        Kernel[TeamID].Tactics.HalfLength = Config.Tactics[0].HalfLength;
+        Kernel[TeamID].Tactics.HalfWidth = Config.Tactics[0].HalfWidth;
+
+        if (Config.Formation.Num() > 0) Kernel[TeamID].Formation = Config.Formation;
+        else FMatchKernel::MakeDefaultFormation(Config.Tactics[0].HalfLength, Kernel[TeamID].Formation);
+
+        // Homes compiled once for the whole run, with this team's shifts
+        Formations[TeamID].Add(TEXT("Default"), Kernel[TeamID].Formation);
+        Formations[TeamID].SetZones(0, Config.Zones[TeamID]);
+        Formations[TeamID].Compile(Kernel[TeamID], Config.PlayersPerTeam);
+        Kernel[TeamID].Formations = &Formations[TeamID];
+    }
+
+    // Point-mass ball: out as soon as its centre crosses, as the lines are drawn
+    Rules.Geometry.Centre = Config.Tactics[0].FieldCentre;
+    Rules.Geometry.HalfLength = Config.Tactics[0].HalfLength;
+    Rules.Geometry.HalfWidth = Config.Tactics[0].HalfWidth;
+    for (FPitchGoal& Goal : Rules.Geometry.Goals) Goal.HalfWidth = Config.GoalHalfWidth;
+    Rules.Geometry.BallRadius = 0.f;
+
+    Intercepts.Params.ControlRadius = Config.ControlRadius;
+
+    // Pitch control over the same pitch, with the same reach as the intercepts
+    Control.Params.ControlRadius = Config.ControlRadius;
+    Control.Params.ReactionTime = Intercepts.Params.ReactionTime;
+    Control.Configure(Config.Tactics[0].FieldCentre, Config.Tactics[0].HalfLength, Config.Tactics[0].HalfWidth);
+    Kernel[0].Control = &Control;
+    Kernel[1].Control = &Control;
+
+    // Same ball as StepBall: exponential drag is exactly v = v0 - drag * s
+    Passes.Params.BallDrag = Config.BallDrag;
+    Passes.Params.ControlRadius = Config.ControlRadius;
+    Passes.Params.MinSpeed = 0.5f * Config.PassSpeed;
+    Passes.Params.MaxSpeed = 1.6f * Config.PassSpeed;
+    Passes.Control = &Control;
+
+    const FVector& Centre = Config.Tactics[0].FieldCentre;
+    for (int32 End = 0; End < 2; ++End)
+    {
+        Shots[End].Params.Speed = Config.ShotSpeed;
+        Shots[End].Configure(FGoalMouth::FromLine(Centre + FVector((End == 1 ? 1.f : -1.f) * Rules.Geometry.HalfLength, 0.f, 0.f),
+            Config.GoalHalfWidth, Rules.Geometry.Goals[End].CrossbarHeight, Centre));
+    }
+
+    const int32 N = 2 * Config.PlayersPerTeam;
+    Pos.SetNumZeroed(N);
+    Vel.SetNumZeroed(N);
+    Intents.SetNum(N);
+}
+
+void FPointMassMatch::Run(int32 Seed, FPointMassResult& Out)
+{
+    Rng.Initialize(Seed);
+    Result = FPointMassResult();
+    for (FMarkingAssignment& M : Marking) M.Reset();
+    Control.Invalidate();
+
+    Kickoff(Rng.RandRange(0, 1));
+
+    const float Dt = FMath::Clamp(Config.Dt, 1.f / 240.f, 0.1f);
+    const int32 NumSteps = FMath::CeilToInt(Config.Duration / Dt);
+    const int32 DecideEvery = FMath::Max(1, FMath::RoundToInt(Config.DecisionInterval / Dt));
+
+    for (int32 Step = 0; Step < NumSteps; ++Step)
+    {
+        if (Step % DecideEvery == 0) Decide();
+
+        StepPlayers(Dt);
+        StepBall(Dt);
+
+        Cooldown = FMath::Max(0.f, Cooldown - Dt);
+        const int32 PossTeam = (Owner != INDEX_NONE) ? TeamOf(Owner) : INDEX_NONE;
+        Result.PossessionSeconds[PossTeam + 1] += Dt;
+    }
+
+    Result.Steps = NumSteps;
+    Out = Result;
+}
+
+// ---------------- Setup ----------------
+void FPointMassMatch::Kickoff(int32 KickingTeam)
+{
+    const FMatchKernel& K = Kernel[0];
+    for (int32 TeamID = 0; TeamID < 2; ++TeamID)
+    {
+        for (int32 SlotIdx = 0; SlotIdx < Config.PlayersPerTeam; ++SlotIdx)
+        {
+            const int32 i = TeamID * Config.PlayersPerTeam + SlotIdx;
+            FVector Home = K.ClampToField(Kernel[TeamID].HomeWorld(TeamID, SlotIdx));
+
+            // Everyone starts in their own half
+            const float Dir = (TeamID == 0) ? +1.f : -1.f;
+            const float OwnHalfX = K.Tactics.FieldCentre.X - Dir * 200.f;
+            Home.X = (TeamID == 0) ? FMath::Min(Home.X, OwnHalfX) : FMath::Max(Home.X, OwnHalfX);
+
+            Pos[i] = K.Ground(Home);
+            Vel[i] = FVector::ZeroVector;
+        }
+    }
+
+    BallPos = K.Ground(K.Tactics.FieldCentre);
+    BallVel = FVector::ZeroVector;
+    Owner = INDEX_NONE;
+    Cooldown = 0.f;
+
+    // Kicking team's nearest player takes the ball on the spot
+    GiveBall(ClosestTo(BallPos, KickingTeam));
+    Pos[Owner] = BallPos;
+}
+
+// ---------------- Decisions ----------------
+void FPointMassMatch::Decide()
+{
+    const FTacticParams& T = Kernel[0].Tactics;
+
+    Snap.InitPoints(Config.PlayersPerTeam, Config.PlayersPerTeam);
+    FillSnapshot();
+    Snap.BallPos = BallPos;
+    Snap.BallVel = BallVel;
+
+    // Same exponential drag as StepBall, in closed form; a carried ball just moves with its carrier
+    const float Lead = T.BallLeadTime;
+    const float DragReach = (Owner == INDEX_NONE && Config.BallDrag > 0.f)
+        ? (1.f - FMath::Exp(-Config.BallDrag * Lead)) / Config.BallDrag : Lead;
+    Snap.BallAhead = Kernel[0].ClampToField(BallPos + BallVel * DragReach);
+
+    // Intercepts over the same drag path, 2 s at 15 Hz
+    const float PathDt = 1.f / 15.f;
+    Intercepts.ResetPath(PathDt, T.FieldCentre.Z);
+    for (int32 k = 0; k <= 30; ++k)
+    {
+        const float t = k * PathDt;
+        const float Reach = (Owner == INDEX_NONE && Config.BallDrag > 0.f) ? (1.f - FMath::Exp(-Config.BallDrag * t)) / Config.BallDrag : t;
+        Intercepts.AddPathPoint(Kernel[0].ClampToField(BallPos + BallVel * Reach));
+    }
+    Intercepts.Solve(Snap);
+    Control.Update(Snap);
+
+    Grid.Build(Snap, T.FieldCentre,
+        FVector2D(T.HalfLength + T.SeparationRadius, T.HalfWidth + T.SeparationRadius), T.SeparationRadius);
+
+    const int32 PossTeam = (Owner != INDEX_NONE) ? TeamOf(Owner) : INDEX_NONE;
+    const int32 AttackingTeam = Kernel[0].PickAttackingTeam(Grid, BallPos, PossTeam);
+
+    for (int32 TeamID = 0; TeamID < 2; ++TeamID)
+    {
+        Kernel[TeamID].PlanTeam(Snap, Grid, TeamID, AttackingTeam == TeamID, Marking[TeamID], Plans[TeamID]);
+    }
+    for (int32 i = 0; i < Snap.Num; ++i)
+    {
+        const int32 TeamID = Snap.Team[i];
+        Kernel[TeamID].DecidePlayer(Snap, Grid, i, Plans[TeamID], Intents[i]);
+    }
+}
+
+void FPointMassMatch::FillSnapshot()
+{
+    for (int32 i = 0; i < Pos.Num(); ++i)
+    {
+        Snap.PosX[i] = Pos[i].X; Snap.PosY[i] = Pos[i].Y; Snap.PosZ[i] = Pos[i].Z;
+        Snap.VelX[i] = Vel[i].X; Snap.VelY[i] = Vel[i].Y; Snap.VelZ[i] = Vel[i].Z;
+
+        const FVector Face = Vel[i].GetSafeNormal2D();
+        if (!Face.IsNearlyZero()) { Snap.FaceX[i] = Face.X; Snap.FaceY[i] = Face.Y; }
+        Snap.MaxSpeed[i] = Config.SprintSpeed;
+        Snap.MaxAccel[i] = Config.Accel;
+    }
+}
+
+// ---------------- Motion ----------------
+void FPointMassMatch::StepPlayers(float Dt)
+{
+    const FMatchKernel& K = Kernel[0];
+    const float MaxDV = Config.Accel * Dt;
+
+    // A loose ball is chased by the closest player of each team
+    int32 BallChaser[2] = { INDEX_NONE, INDEX_NONE };
+    if (Owner == INDEX_NONE)
+    {
+        BallChaser[0] = ClosestTo(BallPos, 0);
+        BallChaser[1] = ClosestTo(BallPos, 1);
+    }
+
+    for (int32 i = 0; i < Pos.Num(); ++i)
+    {
+        const int32 TeamID = TeamOf(i);
+        const FPlayerIntent& Intent = Intents[i];
+
+        FVector DesiredVel = FVector::ZeroVector;
+        if (i == Owner)
+        {
+            const FVector OppGoal = K.OwnGoalLocation(1 - TeamID);
+            DesiredVel = (OppGoal - Pos[i]).GetSafeNormal2D() * Config.RunSpeed * 0.85f;
+        }
+        else if (i == BallChaser[TeamID])
+        {
+            DesiredVel = (BallPos - Pos[i]).GetSafeNormal2D() * Config.SprintSpeed;
+        }
+        else if (Intent.bActive)
+        {
+            const FVector Dir = Intent.bSteer ? Intent.Desired.GetClampedToMaxSize2D(1.f)
+                                              : Kernel[TeamID].SeekArriveDirection(Pos[i], Intent.Target);
+            DesiredVel = FVector(Dir.X, Dir.Y, 0.f) * (Intent.Sprint > 0.f ? Config.SprintSpeed : Config.RunSpeed);
+        }
+
+        Vel[i] += (DesiredVel - Vel[i]).GetClampedToMaxSize2D(MaxDV);
+        Vel[i].Z = 0.f;
+        Pos[i] = K.ClampToField(Pos[i] + Vel[i] * Dt);
+    }
+}
+
+void FPointMassMatch::StepBall(float Dt)
+{
+    const FMatchKernel& K = Kernel[0];
+
+    if (Owner != INDEX_NONE)
+    {
+        const int32 TeamID = TeamOf(Owner);
+        const FVector OppGoal = K.OwnGoalLocation(1 - TeamID);
+
+        BallVel = Vel[Owner];
+        BallPos = Pos[Owner] + Vel[Owner].GetSafeNormal2D() * 40.f;
+
+        // Tackles
+        if (Cooldown <= 0.f)
+        {
+            float Dist;
+            const int32 Tackler = ClosestTo(BallPos, 1 - TeamID, &Dist);
+            if (Tackler != INDEX_NONE && Dist <= Config.ControlRadius && Rng.FRand() < Config.TackleRate * Dt)
+            {
+                GiveBall(Tackler);
+                return;
+            }
+        }
+
+        // Carrier: shoot in range when the engine likes it (or now and then anyway), pass under pressure or now and then
+        if (FVector::Dist2D(BallPos, OppGoal) <= Config.ShotRange)
+        {
+            FShotChoice Shot;
+            FillSnapshot();
+            const FShotEvaluator& Eval = Shots[TeamID == 0 ? 1 : 0];
+            const bool bHasShot = Eval.Evaluate(Snap, Owner, BallPos, FVector::ZeroVector, Shot);
+            if (bHasShot && (Shot.Chance >= Config.ShotMinChance || Rng.FRand() < Config.ShotRate * Dt))
+            {
+                // Uniform scatter with the engine's aim error as its spread
+                const float Spread = FMath::Tan(FMath::DegreesToRadians(Eval.Params.AimErrorDeg)) * FVector::Dist2D(BallPos, Shot.Aim) * 1.732f;
+                Kick(Shot.Aim + Eval.GetMouth().Across * Rng.FRandRange(-Spread, Spread), Config.ShotSpeed);
+                Result.Shots[TeamID]++;
+                return;
+            }
+        }
+
+        float PressDist;
+        ClosestTo(BallPos, 1 - TeamID, &PressDist);
+        const bool bPressed = PressDist <= Config.PressureRadius;
+        if (bPressed || Rng.FRand() < Config.PassRate * Dt)
+        {
+            FPassChoice Pass;
+            if (PickPass(Owner, Pass))
+            {
+                Kick(Pass.Target, Pass.Velocity.Size());
+                Result.Passes[TeamID]++;
+            }
+        }
+        return;
+    }
+
+    // Loose ball
+    // Dribbles and kicks can leave the ball a hair past a line; sweep from in play
+    const FVector PrevBallPos = K.ClampToField(BallPos);
+    BallPos += BallVel * Dt;
+    BallVel *= FMath::Exp(-Config.BallDrag * Dt);
+
+    FPitchEventInfo Event;
+    if (Rules.Sweep(PrevBallPos, BallPos, LastTouchTeam, Event))
+    {
+        if (Event.Type == EPitchEvent::Goal)
+        {
+            Result.Goals[Event.Team]++;
+            Kickoff(1 - Event.Team);
+            return;
+        }
+
+        // Out of play: restart from the spot the laws give, for the awarded side
+        BallPos = K.ClampToField(Rules.RestartLocation(Event));
+        BallVel = FVector::ZeroVector;
+        const int32 Taker = ClosestTo(BallPos, (Event.Team != INDEX_NONE) ? Event.Team : 1 - LastTouchTeam);
+        Pos[Taker] = BallPos;
+        GiveBall(Taker);
+        return;
+    }
+
+    if (Cooldown <= 0.f)
+    {
+        float Dist;
+        const int32 A = ClosestTo(BallPos, 0, &Dist);
+        float DistB;
+        const int32 B = ClosestTo(BallPos, 1, &DistB);
+        const int32 Taker = (Dist <= DistB) ? A : B;
+        if (FMath::Min(Dist, DistB) <= Config.ControlRadius) GiveBall(Taker);
+    }
+}
+
+// ---------------- Ball helpers ----------------
+void FPointMassMatch::GiveBall(int32 Idx)
+{
+    if (Idx == INDEX_NONE) return;
+
+    const int32 TeamID = TeamOf(Idx);
+    if (LastPossessionTeam != INDEX_NONE && LastPossessionTeam != TeamID) Result.PossessionChanges++;
+
+    Owner = Idx;
+    LastTouchTeam = TeamID;
+    LastPossessionTeam = TeamID;
+    Cooldown = Config.KickCooldown;
+}
+
+void FPointMassMatch::Kick(const FVector& Target, float Speed)
+{
+    LastTouchTeam = TeamOf(Owner);
+    BallVel = (Target - BallPos).GetSafeNormal2D() * Speed;
+    BallPos += BallVel.GetSafeNormal2D() * (Config.ControlRadius + 1.f);
+    Owner = INDEX_NONE;
+    Cooldown = Config.KickCooldown;
+}
+
+int32 FPointMassMatch::ClosestTo(const FVector& P, int32 TeamID, float* OutDist) const
+{
+    const int32 Begin = TeamID * Config.PlayersPerTeam;
+    int32 Best = INDEX_NONE; float BestD2 = TNumericLimits<float>::Max();
+    for (int32 i = Begin; i < Begin + Config.PlayersPerTeam; ++i)
+    {
+        const float D2 = FVector::DistSquared2D(P, Pos[i]);
+        if (D2 < BestD2) { BestD2 = D2; Best = i; }
+    }
+    if (OutDist) *OutDist = FMath::Sqrt(BestD2);
+    return Best;
+}
+
+bool FPointMassMatch::PickPass(int32 From, FPassChoice& Out)
+{
+    // Players have moved since the last decision; the pass engine reads the snapshot
+    FillSnapshot();
+    return Passes.Evaluate(Snap, Kernel[TeamOf(From)].Tactics, From, BallPos, FVector::ZeroVector, Out);
+}
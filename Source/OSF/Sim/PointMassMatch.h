@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "MatchSnapshot.h"
+#include "SpatialHashGrid.h"
+#include "MarkingAssignment.h"
+#include "Sim/MatchKernel.h"
+#include "Sim/PitchRules.h"
+#include "Sim/InterceptSolver.h"
+#include "Sim/PitchControl.h"
+#include "Sim/FormationSet.h"
+#include "Sim/FormationZones.h"
+#include "Sim/PassEvaluator.h"
+#include "Sim/ShotEvaluator.h"
+
+/** Everything one offline match needs. Team 0 plays Tactics[0], team 1 Tactics[1]; pitch comes from Tactics[0]. */
+struct FPointMassConfig
+{
+    FTacticParams Tactics[2];
+    TArray<FVector> Formation;   // local, slot order; empty = FMatchKernel default
+    const FFormationZones* Zones[2] = { nullptr, nullptr }; // optional held shape by team; read-only, shared by every match
+    int32 PlayersPerTeam = 11;
+
+    float Duration = 90.f * 60.f;
+    float Dt = 1.f / 30.f;
+    float DecisionInterval = 0.1f; // same rate as the game's team plan
+
+    // Players (cm, s)
+    float RunSpeed = 450.f;
+    float SprintSpeed = 700.f;
+    float Accel = 1200.f;
+
+    // Ball
+    float ControlRadius = 80.f;
+    float KickCooldown = 0.4f;  // nobody can control the ball this long after a kick
+    float BallDrag = 0.8f;      // 1/s, exponential
+    float GoalHalfWidth = 366.f;
+
+    // Ball carrier model (rates per second)
+    float ShotRange = 2200.f;
+    float ShotRate = 2.f;       // speculative shots when the engine sees no chance
+    float ShotMinChance = 0.2f; // shoot at once when the engine rates it this likely
+    float ShotSpeed = 2600.f;
+    float PassRate = 0.5f;
+    float PassSpeed = 1500.f;
+    float PressureRadius = 250.f;
+    float TackleRate = 3.f;
+};
+
+struct FPointMassResult
+{
+    int32 Goals[2] = { 0, 0 };
+    int32 Shots[2] = { 0, 0 };
+    int32 Passes[2] = { 0, 0 };
+    float PossessionSeconds[3] = { 0.f, 0.f, 0.f }; // loose ball, team 0, team 1
+    int32 PossessionChanges = 0;
+    int32 Steps = 0;
+};
+
+/**
+ * One match with point-mass players and ball, driven by FMatchKernel.
+ *
+ * Players accelerate toward their kernel intent, the ball rolls with drag, and
+ * a small stochastic carrier model (dribble, pass, shoot, tackle) stands in for
+ * the footballer input. No actors or world, and all randomness comes from the
+ * seed, so a match replays exactly and any number can run side by side.
+ */
+class OSF_API FPointMassMatch
+{
+public:
+    explicit FPointMassMatch(const FPointMassConfig& InConfig);
+
+    void Run(int32 Seed, FPointMassResult& Out);
+
+private:
+    void Kickoff(int32 KickingTeam);
+    void Decide();
+    void FillSnapshot();
+    void StepPlayers(float Dt);
+    void StepBall(float Dt);
+
+    void GiveBall(int32 Idx);
+    void Kick(const FVector& Target, float Speed);
+    int32 ClosestTo(const FVector& P, int32 TeamID, float* OutDist = nullptr) const;
+    bool PickPass(int32 From, FPassChoice& Out);
+
+    FORCEINLINE int32 TeamOf(int32 Idx) const { return Idx < Config.PlayersPerTeam ? 0 : 1; }
+
+    FPointMassConfig Config;
+
+    FMatchKernel Kernel[2];
+    FFormationSet Formations[2]; // by team: each compiled with its own kernel's shifts
+    FPitchRules Rules;
+    FMatchSnapshot Snap;
+    FSpatialHashGrid Grid;
+    FMarkingAssignment Marking[2];
+    FInterceptSolver Intercepts;
+    FPitchControl Control;   // read by both kernels and Passes
+    FPassEvaluator Passes;
+    FShotEvaluator Shots[2]; // by goal: 0 at -X, 1 at +X
+    FTeamPlan Plans[2];
+    TArray<FPlayerIntent> Intents;
+
+    TArray<FVector> Pos;
+    TArray<FVector> Vel;
+    FVector BallPos = FVector::ZeroVector;
+    FVector BallVel = FVector::ZeroVector;
+
+    int32 Owner = INDEX_NONE;
+    int32 LastTouchTeam = 0;
+    int32 LastPossessionTeam = INDEX_NONE;
+    float Cooldown = 0.f;
+
+    FRandomStream Rng;
+    FPointMassResult Result;
+};
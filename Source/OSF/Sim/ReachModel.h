@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+#include "MatchSnapshot.h"
+
+/**
+ * How long a player needs to get within Radius of a point: reaction, a turn
+ * towards it at their turn rate, then an accelerate-then-cruise run from the
+ * speed already going that way, capped at their max speed.
+ *
+ * Four lanes of players against four lanes of points; the intercept solver
+ * loads four players against one path point, pitch control one player
+ * against four cells.
+ */
+struct FReachLanes
+{
+    VectorRegister4Float Px, Py, Vx, Vy, Fx, Fy;
+    VectorRegister4Float VMax, Accel, InvAccel, InvVMax, TurnScale;
+    VectorRegister4Float Radius, Reaction;
+
+    /** Snapshot entries [Begin, Begin + 4), one per lane. */
+    static FORCEINLINE FReachLanes Load(const FMatchSnapshot& Snap, int32 Begin, float InRadius, float InReaction)
+    {
+        FReachLanes L;
+        L.Px = VectorLoad(Snap.PosX.GetData() + Begin);
+        L.Py = VectorLoad(Snap.PosY.GetData() + Begin);
+        L.Vx = VectorLoad(Snap.VelX.GetData() + Begin);
+        L.Vy = VectorLoad(Snap.VelY.GetData() + Begin);
+        L.Fx = VectorLoad(Snap.FaceX.GetData() + Begin);
+        L.Fy = VectorLoad(Snap.FaceY.GetData() + Begin);
+        L.VMax = VectorLoad(Snap.MaxSpeed.GetData() + Begin);
+        L.Accel = VectorLoad(Snap.MaxAccel.GetData() + Begin);
+        L.Finish(VectorLoad(Snap.TurnRate.GetData() + Begin), InRadius, InReaction);
+        return L;
+    }
+
+    /** Snapshot entry Idx in every lane. */
+    static FORCEINLINE FReachLanes Splat(const FMatchSnapshot& Snap, int32 Idx, float InRadius, float InReaction)
+    {
+        FReachLanes L;
+        L.Px = VectorSetFloat1(Snap.PosX[Idx]);
+        L.Py = VectorSetFloat1(Snap.PosY[Idx]);
+        L.Vx = VectorSetFloat1(Snap.VelX[Idx]);
+        L.Vy = VectorSetFloat1(Snap.VelY[Idx]);
+        L.Fx = VectorSetFloat1(Snap.FaceX[Idx]);
+        L.Fy = VectorSetFloat1(Snap.FaceY[Idx]);
+        L.VMax = VectorSetFloat1(Snap.MaxSpeed[Idx]);
+        L.Accel = VectorSetFloat1(Snap.MaxAccel[Idx]);
+        L.Finish(VectorSetFloat1(Snap.TurnRate[Idx]), InRadius, InReaction);
+        return L;
+    }
+
+    /** Time for each lane's player to reach the lane's (Bx, By); zero when already within Radius. */
+    FORCEINLINE VectorRegister4Float TimeTo(const VectorRegister4Float& Bx, const VectorRegister4Float& By) const
+    {
+        const VectorRegister4Float One = VectorOneFloat();
+        const VectorRegister4Float Zero = VectorZeroFloat();
+
+        const VectorRegister4Float Dx = VectorSubtract(Bx, Px);
+        const VectorRegister4Float Dy = VectorSubtract(By, Py);
+        const VectorRegister4Float D = VectorSqrt(VectorMultiplyAdd(Dx, Dx, VectorMultiply(Dy, Dy)));
+        const VectorRegister4Float InvD = VectorDivide(One, VectorMax(D, One));
+
+        const VectorRegister4Float Cos = VectorMultiply(VectorMultiplyAdd(Dx, Fx, VectorMultiply(Dy, Fy)), InvD);
+        const VectorRegister4Float TurnT = VectorMultiply(VectorMax(VectorSubtract(One, Cos), Zero), TurnScale);
+
+        // Run: accelerate from the speed already going that way, then cruise
+        const VectorRegister4Float V0 = VectorMin(VectorMax(VectorMultiply(VectorMultiplyAdd(Dx, Vx, VectorMultiply(Dy, Vy)), InvD), Zero), VMax);
+        const VectorRegister4Float Reach = VectorMax(VectorSubtract(D, Radius), Zero);
+        const VectorRegister4Float TAcc = VectorMultiply(VectorSubtract(VMax, V0), InvAccel);
+        const VectorRegister4Float DAcc = VectorMultiply(VectorMultiply(VectorAdd(V0, VMax), VectorSetFloat1(0.5f)), TAcc);
+        const VectorRegister4Float TShort = VectorMultiply(
+            VectorSubtract(VectorSqrt(VectorMultiplyAdd(V0, V0, VectorMultiply(VectorMultiply(VectorSetFloat1(2.f), Accel), Reach))), V0), InvAccel);
+        const VectorRegister4Float TLong = VectorMultiplyAdd(VectorSubtract(Reach, DAcc), InvVMax, TAcc);
+        const VectorRegister4Float TMove = VectorSelect(VectorCompareLE(Reach, DAcc), TShort, TLong);
+
+        // Already in reach: no reaction or turn
+        const VectorRegister4Float T = VectorAdd(VectorAdd(Reaction, TurnT), TMove);
+        return VectorSelect(VectorCompareGT(Reach, Zero), T, Zero);
+    }
+
+private:
+    FORCEINLINE void Finish(const VectorRegister4Float& TurnRate, float InRadius, float InReaction)
+    {
+        const VectorRegister4Float One = VectorOneFloat();
+        InvAccel = VectorDivide(One, Accel);
+        InvVMax = VectorDivide(One, VMax);
+        // Turn angle ~ pi/2 * (1 - cos), exact at 0, 90 and 180 degrees
+        TurnScale = VectorDivide(VectorSetFloat1(HALF_PI), TurnRate);
+        Radius = VectorSetFloat1(InRadius);
+        Reaction = VectorSetFloat1(InReaction);
+    }
+};
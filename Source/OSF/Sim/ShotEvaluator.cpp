@@ -0,0 +1,344 @@
+#include "Sim/ShotEvaluator.h"
+
+#include "Math/VectorRegister.h"
+
+#include "MatchSnapshot.h"
+#include "OSFStats.h"
+#include "Sim/KickSolver.h"
+
+namespace
+{
+    /** Standard normal CDF (Abramowitz & Stegun 7.1.26 erf, |error| < 1.5e-7). */
+    float NormalCdf(float X)
+    {
+        const float Z = FMath::Abs(X) * 0.70710678f; // x / sqrt(2)
+        const float T = 1.f / (1.f + 0.3275911f * Z);
+        const float Poly = T * (0.254829592f + T * (-0.284496736f + T * (1.421413741f + T * (-1.453152027f + T * 1.061405429f))));
+        const float Erf = 1.f - Poly * FMath::Exp(-Z * Z);
+        return 0.5f * (1.f + (X >= 0.f ? Erf : -Erf));
+    }
+
+    FVector OutTowards(const FVector& Across, const FVector& From, const FVector& PitchCentre)
+    {
+        const FVector Out(-Across.Y, Across.X, 0.f);
+        return FVector::DotProduct(PitchCentre - From, Out) >= 0.f ? Out : -Out;
+    }
+}
+
+// ---------------- Mouth ----------------
+FGoalMouth FGoalMouth::FromFrame(const FBoxSphereBounds& LeftPost, const FBoxSphereBounds& RightPost,
+                                 const FBoxSphereBounds& Crossbar, float GroundZ, const FVector& PitchCentre)
+{
+    FGoalMouth M;
+    const FVector L(LeftPost.Origin.X, LeftPost.Origin.Y, GroundZ);
+    const FVector R(RightPost.Origin.X, RightPost.Origin.Y, GroundZ);
+    const float PostRadius = FMath::Min(LeftPost.BoxExtent.X, LeftPost.BoxExtent.Y);
+    const float BarRadius = FMath::Min(Crossbar.BoxExtent.Y, Crossbar.BoxExtent.Z);
+
+    M.Centre = 0.5f * (L + R);
+    M.Across = (R - L).GetSafeNormal2D();
+    M.Out = OutTowards(M.Across, M.Centre, PitchCentre);
+    M.HalfWidth = FMath::Max(0.5f * FVector::Dist2D(L, R) - PostRadius, 1.f);
+    M.Height = FMath::Max(Crossbar.Origin.Z - BarRadius - GroundZ, 1.f);
+    return M;
+}
+
+FGoalMouth FGoalMouth::FromLine(const FVector& Centre, float HalfWidth, float Height, const FVector& PitchCentre)
+{
+    FGoalMouth M;
+    M.Centre = Centre;
+    M.Across = FVector(0.f, 1.f, 0.f);
+    M.Out = OutTowards(M.Across, Centre, PitchCentre);
+    M.HalfWidth = HalfWidth;
+    M.Height = Height;
+    return M;
+}
+
+// ---------------- Table ----------------
+float FShotEvaluator::OnTargetAt(float X, float Y, float AimY, float AimZ) const
+{
+    // X out from the line, Y across; the ball sits on the pitch
+    const float R = Params.BallRadius;
+    const float SigmaH = FMath::DegreesToRadians(FMath::Max(Params.AimErrorDeg, 0.01f));
+    const float SigmaV = FMath::DegreesToRadians(FMath::Max(Params.LiftErrorDeg, 0.01f));
+
+    // Across: between the posts, less the ball
+    const float Aim = FMath::Atan2(AimY - Y, X);
+    const float Left = FMath::Atan2(-Mouth.HalfWidth + R - Y, X);
+    const float Right = FMath::Atan2(Mouth.HalfWidth - R - Y, X);
+    const float PH = NormalCdf((Right - Aim) / SigmaH) - NormalCdf((Left - Aim) / SigmaH);
+
+    // Up: under the bar (low shots bounce in)
+    const float Flat = FMath::Sqrt(X * X + (AimY - Y) * (AimY - Y));
+    const float Lift = FMath::Atan2(AimZ - R, Flat);
+    const float Bar = FMath::Atan2(Mouth.Height - R, Flat);
+    const float PV = NormalCdf((Bar - Lift) / SigmaV);
+
+    return FMath::Clamp(PH * PV, 0.f, 1.f);
+}
+
+void FShotEvaluator::Configure(const FGoalMouth& InMouth)
+{
+    Mouth = InMouth;
+
+    // Aim points inset by the ball and a hand's width from the frame
+    const float Inset = Params.BallRadius + 15.f;
+    const float SpanY = FMath::Max(Mouth.HalfWidth - Inset, 0.f);
+    for (int32 i = 0; i < NumAcross; ++i)
+    {
+        SampleY[i] = FMath::Lerp(-SpanY, SpanY, float(i) / float(NumAcross - 1));
+    }
+    const float Low = Params.BallRadius + 10.f;
+    const float High = FMath::Max(Mouth.Height - Inset, Low);
+    for (int32 j = 0; j < NumUp; ++j)
+    {
+        SampleZ[j] = FMath::Lerp(Low, High, float(j) / float(NumUp - 1));
+    }
+
+    // Ball on the right half (Y >= 0) at bin centres; the left half reads it mirrored
+    OnTargetTable.SetNumUninitialized(NumDistBins * NumAngleBins * NumSamples);
+    const float DistStep = Params.MaxDistance / NumDistBins;
+    const float AngleStep = HALF_PI / NumAngleBins;
+    float* Row = OnTargetTable.GetData();
+    for (int32 d = 0; d < NumDistBins; ++d)
+    {
+        for (int32 a = 0; a < NumAngleBins; ++a, Row += NumSamples)
+        {
+            const float Dist = (d + 0.5f) * DistStep;
+            const float Angle = (a + 0.5f) * AngleStep;
+            const float X = Dist * FMath::Cos(Angle);
+            const float Y = Dist * FMath::Sin(Angle);
+            for (int32 i = 0; i < NumAcross; ++i)
+            {
+                for (int32 j = 0; j < NumUp; ++j)
+                {
+                    Row[i * NumUp + j] = OnTargetAt(X, Y, SampleY[i], SampleZ[j]);
+                }
+            }
+        }
+    }
+}
+
+// ---------------- Kick ----------------
+FVector FShotEvaluator::KickVelocity(const FVector& From, const FVector& To) const
+{
+    const FVector Flat(To.X - From.X, To.Y - From.Y, 0.f);
+    const float H = Flat.Size();
+    if (H < KINDA_SMALL_NUMBER) return FVector(0.f, 0.f, Params.Speed);
+
+    // Rise to To.Z over the flight time, against gravity; one refinement for the slower horizontal speed
+    const float Dz = To.Z - From.Z;
+    float VH = Params.Speed;
+    float VZ = 0.f;
+    for (int32 Iter = 0; Iter < 2; ++Iter)
+    {
+        const float T = H / VH;
+        VZ = Dz / T + 0.5f * Params.Gravity * T;
+        VH = FMath::Sqrt(FMath::Max(Params.Speed * Params.Speed - VZ * VZ, 0.25f * Params.Speed * Params.Speed));
+    }
+    return Flat / H * VH + FVector(0.f, 0.f, VZ);
+}
+
+// ---------------- Evaluate ----------------
+bool FShotEvaluator::Evaluate(const FMatchSnapshot& Snap, int32 ShooterIdx, const FVector& BallPos, const FVector& Aim, FShotChoice& Out) const
+{
+    OSF_SCOPE(ShotEval);
+    Out = FShotChoice();
+    if (!IsConfigured() || !Snap.IsValidEntry(ShooterIdx)) return false;
+
+    // Ball in the goal frame
+    const FVector Rel = BallPos - Mouth.Centre;
+    const float X = FVector::DotProduct(Rel, Mouth.Out);
+    const float Y = FVector::DotProduct(Rel, Mouth.Across);
+    const float Dist = FMath::Sqrt(X * X + Y * Y);
+    if (X <= 0.f || Dist >= Params.MaxDistance) return false;
+
+    const int32 DistBin = FMath::Min(FMath::FloorToInt(Dist / Params.MaxDistance * NumDistBins), NumDistBins - 1);
+    const int32 AngleBin = FMath::Min(FMath::FloorToInt(FMath::Atan2(FMath::Abs(Y), X) / HALF_PI * NumAngleBins), NumAngleBins - 1);
+    const float* Row = OnTargetTable.GetData() + (DistBin * NumAngleBins + AngleBin) * NumSamples;
+    const bool bMirror = Y < 0.f;
+
+    // Defenders: keeper (slot 0) alone, the rest packed four to a register
+    const int32 DefTeam = 1 - Snap.Team[ShooterIdx];
+    const int32 KeeperIdx = Snap.IndexOf(DefTeam, 0);
+    const bool bKeeper = Snap.IsValidEntry(KeeperIdx);
+    // Keeper's reach measured from hip height, whatever the snapshot's Z convention
+    const FVector Keeper = bKeeper ? FVector(Snap.PosX[KeeperIdx], Snap.PosY[KeeperIdx], Mouth.Centre.Z + 90.f) : FVector::ZeroVector;
+
+    TArray<float, TInlineAllocator<64>> BlockX, BlockY, BlockSpeed;
+    for (int32 i = Snap.TeamBegin[DefTeam]; i < Snap.TeamEnd[DefTeam]; ++i)
+    {
+        if (i == KeeperIdx || !Snap.Valid[i]) continue;
+        BlockX.Add(Snap.PosX[i]);
+        BlockY.Add(Snap.PosY[i]);
+        BlockSpeed.Add(Snap.MaxSpeed[i]);
+    }
+    while (BlockX.Num() % 4 != 0 || BlockX.Num() == 0)
+    {
+        BlockX.Add(FMatchSnapshot::FarSentinel);
+        BlockY.Add(FMatchSnapshot::FarSentinel);
+        BlockSpeed.Add(1.f);
+    }
+
+    const float InvSpeed = 1.f / FMath::Max(Params.Speed, 1.f);
+    const float InvSoft = 0.5f / FMath::Max(Params.RiskSoftness, KINDA_SMALL_NUMBER);
+    const float AimSide = FVector::DotProduct(Aim.GetSafeNormal2D(), Mouth.Across);
+
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = VectorOneFloat();
+    const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+    const VectorRegister4Float Bx = VectorSetFloat1(static_cast<float>(BallPos.X));
+    const VectorRegister4Float By = VectorSetFloat1(static_cast<float>(BallPos.Y));
+    const VectorRegister4Float Reach = VectorSetFloat1(Params.BlockReach);
+    const VectorRegister4Float Reaction = VectorSetFloat1(Params.BlockReaction);
+    const VectorRegister4Float VInvSoft = VectorSetFloat1(InvSoft);
+
+    // Chance for aim point (i, j) with the ball taking InvBall s per cm of flight
+    auto ChanceAt = [&](int32 i, int32 j, float OnTarget, float InvBall, float& OutSave, float& OutBlock)
+        {
+            const FVector Target = Mouth.Centre + Mouth.Across * SampleY[i] + FVector(0.f, 0.f, SampleZ[j]);
+            const FVector Path = Target - BallPos;
+            const float Length = Path.Size();
+            const FVector U = Path / FMath::Max(Length, 1.f);
+
+            // Keeper: to the nearest point of the flight, or across to the aim point
+            OutSave = 0.f;
+            if (bKeeper)
+            {
+                const float S = FMath::Clamp(FVector::DotProduct(Keeper - BallPos, U), 0.f, Length);
+                for (const float At : { S, Length })
+                {
+                    const FVector P = BallPos + U * At;
+                    const float TKeeper = Params.KeeperReaction + FMath::Max(FVector::Dist(Keeper, P) - Params.KeeperReach, 0.f) / Params.KeeperDiveSpeed;
+                    OutSave = FMath::Max(OutSave, FMath::Clamp(0.5f + (At * InvBall - TKeeper) * InvSoft, 0.f, 1.f));
+                }
+            }
+
+            // Blockers: at the closest point of the flight on the ground plane, while the ball is low enough
+            const float Length2D = FMath::Max(Path.Size2D(), 1.f);
+            const VectorRegister4Float Ux = VectorSetFloat1(Path.X / Length2D);
+            const VectorRegister4Float Uy = VectorSetFloat1(Path.Y / Length2D);
+            const VectorRegister4Float L2 = VectorSetFloat1(Length2D);
+            const VectorRegister4Float Rise = VectorSetFloat1(Path.Z / Length2D);
+            const VectorRegister4Float Headroom = VectorSetFloat1(Params.BlockHeight - (BallPos.Z - Mouth.Centre.Z));
+            const VectorRegister4Float Stretch = VectorSetFloat1(Length / Length2D);
+            const VectorRegister4Float VInvBall = VectorSetFloat1(InvBall);
+
+            VectorRegister4Float Clear = One;
+            for (int32 k = 0; k < BlockX.Num(); k += 4)
+            {
+                const VectorRegister4Float Ox = VectorLoad(BlockX.GetData() + k);
+                const VectorRegister4Float Oy = VectorLoad(BlockY.GetData() + k);
+                const VectorRegister4Float Dx = VectorSubtract(Ox, Bx);
+                const VectorRegister4Float Dy = VectorSubtract(Oy, By);
+                const VectorRegister4Float S = VectorMin(VectorMax(VectorMultiplyAdd(Dx, Ux, VectorMultiply(Dy, Uy)), Zero), L2);
+                const VectorRegister4Float Px = VectorSubtract(Dx, VectorMultiply(Ux, S));
+                const VectorRegister4Float Py = VectorSubtract(Dy, VectorMultiply(Uy, S));
+                const VectorRegister4Float Gap = VectorMax(VectorSubtract(VectorSqrt(VectorMultiplyAdd(Px, Px, VectorMultiply(Py, Py))), Reach), Zero);
+
+                const VectorRegister4Float TBlock = VectorMultiplyAdd(Gap, VectorDivide(One, VectorLoad(BlockSpeed.GetData() + k)), Reaction);
+                const VectorRegister4Float TBall = VectorMultiply(VectorMultiply(S, Stretch), VInvBall);
+                const VectorRegister4Float P = VectorMin(VectorMax(VectorMultiplyAdd(VectorSubtract(TBall, TBlock), VInvSoft, Half), Zero), One);
+                const VectorRegister4Float Low = VectorCompareLE(VectorMultiply(S, Rise), Headroom);
+                Clear = VectorMultiply(Clear, VectorSubtract(One, VectorSelect(Low, P, Zero)));
+            }
+            alignas(16) float Lanes[4];
+            VectorStoreAligned(Clear, Lanes);
+            OutBlock = 1.f - Lanes[0] * Lanes[1] * Lanes[2] * Lanes[3];
+
+            return OnTarget * (1.f - OutSave) * (1.f - OutBlock);
+        };
+
+    // Every aim point on the straight-line model at Params.Speed
+    struct FScored
+    {
+        int32 Sample;
+        float Score;
+        float Chance;
+        float OnTarget;
+        float Save;
+        float Block;
+    };
+    TArray<FScored, TInlineAllocator<NumSamples>> Scored;
+    for (int32 i = 0; i < NumAcross; ++i)
+    {
+        for (int32 j = 0; j < NumUp; ++j)
+        {
+            const float OnTarget = Row[(bMirror ? NumAcross - 1 - i : i) * NumUp + j];
+            if (OnTarget < 0.01f) continue;
+
+            FScored& S = Scored.AddDefaulted_GetRef();
+            S.Sample = i * NumUp + j;
+            S.OnTarget = OnTarget;
+            S.Chance = ChanceAt(i, j, OnTarget, InvSpeed, S.Save, S.Block);
+            S.Score = S.Chance + Params.AimWeight * AimSide * SampleY[i] / FMath::Max(Mouth.HalfWidth, 1.f);
+        }
+    }
+    if (Scored.Num() == 0) return false;
+
+    auto AimAt = [&](int32 Sample)
+        {
+            return Mouth.Centre + Mouth.Across * SampleY[Sample / NumUp] + FVector(0.f, 0.f, SampleZ[Sample % NumUp]);
+        };
+    auto Choose = [&](const FScored& S, const FVector& Velocity, const FVector& Spin)
+        {
+            Out.Aim = AimAt(S.Sample);
+            Out.Velocity = Velocity;
+            Out.Spin = Spin;
+            Out.Chance = S.Chance;
+            Out.OnTarget = S.OnTarget;
+            Out.SaveRisk = S.Save;
+            Out.BlockRisk = S.Block;
+        };
+
+    if (!Kicks || !Kicks->IsConfigured())
+    {
+        const FScored* Best = &Scored[0];
+        for (const FScored& S : Scored) if (S.Score > Best->Score) Best = &S;
+        Choose(*Best, KickVelocity(BallPos, AimAt(Best->Sample)), FVector::ZeroVector);
+        return true;
+    }
+
+    // Solved: the best SolveTopK kicks at Params.Speed in one batch, rescored with their flight times;
+    // unconverged points keep the straight-line model
+    Scored.Sort([](const FScored& A, const FScored& B) { return A.Score > B.Score; });
+    if (Params.SolveTopK > 0 && Scored.Num() > Params.SolveTopK)
+    {
+        Scored.SetNum(Params.SolveTopK, EAllowShrinking::No);
+    }
+
+    FKickTarget Targets[NumSamples];
+    FKickSolution Solved[NumSamples];
+    for (int32 k = 0; k < Scored.Num(); ++k)
+    {
+        FKickTarget& T = Targets[k];
+        T.From = BallPos;
+        T.To = AimAt(Scored[k].Sample);
+        T.Value = Params.Speed;
+    }
+    FKickQuery Query;
+    Query.Goal = EKickGoal::LaunchSpeed;
+    Kicks->Solve(Query, MakeArrayView(Targets, Scored.Num()), MakeArrayView(Solved, Scored.Num()));
+
+    const FScored* Best = nullptr;
+    for (int32 k = 0; k < Scored.Num(); ++k)
+    {
+        const FKickSolution& Kick = Solved[k];
+        if (!Kick.bReached) continue;
+
+        FScored& S = Scored[k];
+        if (Kick.bConverged)
+        {
+            const float Length = FMath::Max(FVector::Dist(BallPos, Targets[k].To), 1.f);
+            S.Chance = ChanceAt(S.Sample / NumUp, S.Sample % NumUp, S.OnTarget, Kick.Time / Length, S.Save, S.Block);
+            S.Score = S.Chance + Params.AimWeight * AimSide * SampleY[S.Sample / NumUp] / FMath::Max(Mouth.HalfWidth, 1.f);
+        }
+        if (!Best || S.Score > Best->Score) Best = &S;
+    }
+    if (!Best) return false;
+
+    const FKickSolution& Kick = Solved[Best - Scored.GetData()];
+    Choose(*Best, Kick.bConverged ? Kick.Velocity : KickVelocity(BallPos, AimAt(Best->Sample)),
+        Kick.bConverged ? Kick.Spin : FVector::ZeroVector);
+    return true;
+}
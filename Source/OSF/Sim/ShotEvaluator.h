@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMatchSnapshot;
+class FKickSolver;
+
+/** The opening between the posts and under the bar, in world space. */
+struct OSF_API FGoalMouth
+{
+    FVector Centre = FVector::ZeroVector;   // on the goal line, pitch height
+    FVector Across = FVector(0, 1, 0);      // unit, left post to right post
+    FVector Out = FVector(1, 0, 0);         // unit, from the line into the pitch
+    float HalfWidth = 366.f;                // inside of the posts
+    float Height = 244.f;                   // underside of the bar
+
+    /** From the bounds of the goal frame parts; Out points toward PitchCentre. */
+    static FGoalMouth FromFrame(const FBoxSphereBounds& LeftPost, const FBoxSphereBounds& RightPost,
+                                const FBoxSphereBounds& Crossbar, float GroundZ, const FVector& PitchCentre);
+
+    /** A goal on the X axis at Centre, facing PitchCentre. */
+    static FGoalMouth FromLine(const FVector& Centre, float HalfWidth, float Height, const FVector& PitchCentre);
+};
+
+struct FShotParams
+{
+    float Speed = 2600.f;          // cm/s off the boot
+    float BallRadius = 11.f;
+    float Gravity = 980.f;
+
+    // Shooter accuracy, 1 sigma
+    float AimErrorDeg = 3.5f;
+    float LiftErrorDeg = 2.5f;
+
+    // Keeper: reacts, then dives to within Reach of the ball
+    float KeeperReaction = 0.25f;
+    float KeeperReach = 200.f;
+    float KeeperDiveSpeed = 550.f;
+
+    // Outfield blockers: a lunge of BlockReach, nothing above BlockHeight
+    float BlockReaction = 0.15f;
+    float BlockReach = 70.f;
+    float BlockHeight = 190.f;
+
+    float RiskSoftness = 0.15f;    // s of margin over which a save/block goes from missed to made
+    float MaxDistance = 4000.f;    // beyond this there is no shot
+    float AimWeight = 0.f;         // human aim: bonus per unit of stick toward a side, at the post
+    int32 SolveTopK = 6;           // with a kick solver, only the best this many aim points are solved (0 = all)
+};
+
+struct FShotChoice
+{
+    FVector Aim = FVector::ZeroVector;
+    FVector Velocity = FVector::ZeroVector;
+    FVector Spin = FVector::ZeroVector;   // rad/s; from the kick solver, else none
+    float   Chance = 0.f;     // estimated probability of a goal
+    float   OnTarget = 0.f;
+    float   SaveRisk = 0.f;
+    float   BlockRisk = 0.f;
+};
+
+/**
+ * Picks where to shoot: a grid of aim points across the mouth, each scored by
+ * the chance it is on target given the shooter's aim error, times the chance
+ * the keeper does not get there and no blocker is in the way.
+ *
+ * The on-target part only depends on where the ball is relative to the goal,
+ * so Configure precomputes it per aim point over distance and angle; a shot
+ * reads one table row. Keeper and blockers are analytic reach-versus-ball-time
+ * tests, blockers four per SIMD register. No allocation below 64 opponents.
+ *
+ * With a kick solver, the best Params.SolveTopK aim points on the straight
+ * line are solved in one batch and rescored: the flight times under drag
+ * replace distance over speed in the keeper and blocker tests, and the chosen
+ * kick is the solved one.
+ */
+class OSF_API FShotEvaluator
+{
+public:
+    static constexpr int32 NumAcross = 7;
+    static constexpr int32 NumUp = 3;
+    static constexpr int32 NumSamples = NumAcross * NumUp;
+    static constexpr int32 NumDistBins = 32;
+    static constexpr int32 NumAngleBins = 16;
+
+    FShotParams Params;
+
+    /** Optional; when set and configured, kicks and flight times come from it. */
+    const FKickSolver* Kicks = nullptr;
+
+    /** Aim points and the on-target table for this mouth; call again after changing Params. */
+    void Configure(const FGoalMouth& InMouth);
+    bool IsConfigured() const { return OnTargetTable.Num() > 0; }
+    const FGoalMouth& GetMouth() const { return Mouth; }
+
+    /**
+     * Best shot for ShooterIdx at the mouth from BallPos; the defending team is the other one.
+     * Aim (may be zero) biases the side for assisted human shots. False if out of range or behind the line.
+     */
+    bool Evaluate(const FMatchSnapshot& Snap, int32 ShooterIdx, const FVector& BallPos, const FVector& Aim, FShotChoice& Out) const;
+
+    /** Kick velocity at Params.Speed from From that reaches To, lofted for gravity (no drag; used without a kick solver). */
+    FVector KickVelocity(const FVector& From, const FVector& To) const;
+
+private:
+    float OnTargetAt(float X, float Y, float SampleY, float SampleZ) const;
+
+    FGoalMouth Mouth;
+    float SampleY[NumAcross] = {};
+    float SampleZ[NumUp] = {};
+
+    // [Dist][Angle][Sample] for the ball on the right half (Across >= 0); the left half reads it mirrored
+    TArray<float> OnTargetTable;
+};
@@ -0,0 +1,103 @@
+#include "SpatialHashGrid.h"
+
+void FSpatialHashGrid::Build(const FMatchSnapshot& Snapshot, const FVector& Centre, const FVector2D& HalfExtent, float InCellSize)
+{
+    Snap = &Snapshot;
+
+    CellSize = FMath::Max(InCellSize, 50.f);
+    InvCellSize = 1.f / CellSize;
+    Origin = FVector2D(Centre.X - HalfExtent.X, Centre.Y - HalfExtent.Y);
+    NumX = FMath::Max(1, FMath::CeilToInt(2.f * HalfExtent.X * InvCellSize));
+    NumY = FMath::Max(1, FMath::CeilToInt(2.f * HalfExtent.Y * InvCellSize));
+    NumCells = NumX * NumY;
+
+    const int32 NumBuckets = 2 * NumCells;
+    CellStart.SetNumZeroed(NumBuckets + 1);
+
+    // Counting sort: histogram, prefix sum, scatter.
+    TArray<int32, TInlineAllocator<256>> BucketOf;
+    BucketOf.SetNumUninitialized(Snapshot.Num);
+
+    int32 NumItems = 0;
+    for (int32 i = 0; i < Snapshot.Num; ++i)
+    {
+        if (!Snapshot.Valid[i]) { BucketOf[i] = INDEX_NONE; continue; }
+        const int32 B = Bucket(Snapshot.Team[i], CellX(Snapshot.PosX[i]), CellY(Snapshot.PosY[i]));
+        BucketOf[i] = B;
+        ++CellStart[B + 1];
+        ++NumItems;
+    }
+    for (int32 B = 0; B < NumBuckets; ++B) CellStart[B + 1] += CellStart[B];
+
+    Items.SetNumUninitialized(NumItems);
+    for (int32 i = 0; i < Snapshot.Num; ++i)
+    {
+        const int32 B = BucketOf[i];
+        if (B == INDEX_NONE) continue;
+        // Fill each bucket from its end; afterwards CellStart[B + 1] holds the start of bucket B.
+        Items[--CellStart[B + 1]] = i;
+    }
+    for (int32 B = 0; B < NumBuckets; ++B) CellStart[B] = CellStart[B + 1];
+    CellStart[NumBuckets] = NumItems;
+}
+
+int32 FSpatialHashGrid::Nearest(int32 TeamID, const FVector& Pt, const uint8* Exclude, float* OutDistSq) const
+{
+    int32 Best = INDEX_NONE;
+    if (KNearest(TeamID, Pt, 1, &Best, Exclude) == 0)
+    {
+        if (OutDistSq) *OutDistSq = TNumericLimits<float>::Max();
+        return INDEX_NONE;
+    }
+    if (OutDistSq)
+    {
+        const float DX = Snap->PosX[Best] - Pt.X;
+        const float DY = Snap->PosY[Best] - Pt.Y;
+        *OutDistSq = DX * DX + DY * DY;
+    }
+    return Best;
+}
+
+int32 FSpatialHashGrid::KNearest(int32 TeamID, const FVector& Pt, int32 K, int32* OutIdx, const uint8* Exclude) const
+{
+    if (!IsBuilt() || K <= 0) return 0;
+
+    float BestD2[8];
+    check(K <= UE_ARRAY_COUNT(BestD2));
+
+    const int32 CX = CellX(Pt.X);
+    const int32 CY = CellY(Pt.Y);
+    const int32 MaxRing = FMath::Max(NumX, NumY);
+
+    int32 Count = 0;
+    for (int32 R = 0; R <= MaxRing; ++R)
+    {
+        ForEachInRing(TeamID, CX, CY, R, [&](int32 i)
+            {
+                if (Exclude && Exclude[i]) return;
+                const float DX = Snap->PosX[i] - Pt.X;
+                const float DY = Snap->PosY[i] - Pt.Y;
+                const float D = DX * DX + DY * DY;
+
+                int32 Pos = Count;
+                while (Pos > 0 && BestD2[Pos - 1] > D) --Pos;
+                if (Pos >= K) return;
+
+                for (int32 j = FMath::Min(Count, K - 1); j > Pos; --j)
+                {
+                    OutIdx[j] = OutIdx[j - 1];
+                    BestD2[j] = BestD2[j - 1];
+                }
+                OutIdx[Pos] = i; BestD2[Pos] = D;
+                Count = FMath::Min(Count + 1, K);
+            });
+
+        // Anything in ring R+1 is at least R cells away.
+        if (Count == K)
+        {
+            const float Reach = R * CellSize;
+            if (BestD2[K - 1] <= Reach * Reach) break;
+        }
+    }
+    return Count;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MatchSnapshot.h"
+
+/**
+ * Uniform grid over the pitch bucketing snapshot entries by (team, cell).
+ * Rebuilt each Think with a counting sort, so buckets are contiguous index runs
+ * and steady state does not allocate. Points outside the bounds clamp to the
+ * border cells, which keeps every query exact (just less pruned out there).
+ */
+struct OSF_API FSpatialHashGrid
+{
+    /** Rebuild from Snapshot. Bounds are Centre ± HalfExtent; CellSize is usually SeparationRadius. */
+    void Build(const FMatchSnapshot& Snapshot, const FVector& Centre, const FVector2D& HalfExtent, float InCellSize);
+
+    bool IsBuilt() const { return Snap != nullptr && NumCells > 0; }
+
+    /** Entries of TeamID strictly inside Radius (XY) of Pt, skipping SkipIdx. Returns count appended. */
+    template<typename AllocatorType>
+    int32 QueryRadius(int32 TeamID, const FVector& Pt, float Radius, int32 SkipIdx, TArray<int32, AllocatorType>& Out) const;
+
+    /** Nearest entry of TeamID not flagged in Exclude (indexed by snapshot index, may be null). */
+    int32 Nearest(int32 TeamID, const FVector& Pt, const uint8* Exclude = nullptr, float* OutDistSq = nullptr) const;
+
+    /** Up to K nearest entries of TeamID, closest first. Returns count written. */
+    int32 KNearest(int32 TeamID, const FVector& Pt, int32 K, int32* OutIdx, const uint8* Exclude = nullptr) const;
+
+private:
+    FORCEINLINE int32 CellX(float X) const { return FMath::Clamp(FMath::FloorToInt((X - Origin.X) * InvCellSize), 0, NumX - 1); }
+    FORCEINLINE int32 CellY(float Y) const { return FMath::Clamp(FMath::FloorToInt((Y - Origin.Y) * InvCellSize), 0, NumY - 1); }
+    FORCEINLINE int32 Bucket(int32 TeamID, int32 CX, int32 CY) const { return TeamID * NumCells + CY * NumX + CX; }
+
+    /** Visits every entry in the Chebyshev ring R around (CX, CY). */
+    template<typename FuncType>
+    void ForEachInRing(int32 TeamID, int32 CX, int32 CY, int32 R, FuncType&& Func) const;
+
+    const FMatchSnapshot* Snap = nullptr;
+
+    FVector2D Origin = FVector2D::ZeroVector;
+    float CellSize = 0.f;
+    float InvCellSize = 0.f;
+    int32 NumX = 0;
+    int32 NumY = 0;
+    int32 NumCells = 0;
+
+    TArray<int32> CellStart; // 2 * NumCells + 1 prefix offsets into Items
+    TArray<int32> Items;     // snapshot indices, grouped by bucket
+};
+
+template<typename FuncType>
+void FSpatialHashGrid::ForEachInRing(int32 TeamID, int32 CX, int32 CY, int32 R, FuncType&& Func) const
+{
+    const int32 Y0 = CY - R, Y1 = CY + R;
+    for (int32 Y = FMath::Max(Y0, 0); Y <= FMath::Min(Y1, NumY - 1); ++Y)
+    {
+        const bool bEdgeRow = (Y == Y0 || Y == Y1);
+        const int32 Step = bEdgeRow ? 1 : FMath::Max(2 * R, 1);
+        for (int32 X = CX - R; X <= CX + R; X += Step)
+        {
+            if (X < 0 || X >= NumX) continue;
+            const int32 B = Bucket(TeamID, X, Y);
+            for (int32 k = CellStart[B]; k < CellStart[B + 1]; ++k) Func(Items[k]);
+        }
+    }
+}
+
+template<typename AllocatorType>
+int32 FSpatialHashGrid::QueryRadius(int32 TeamID, const FVector& Pt, float Radius, int32 SkipIdx, TArray<int32, AllocatorType>& Out) const
+{
+    if (!IsBuilt()) return 0;
+
+    const int32 X0 = CellX(Pt.X - Radius), X1 = CellX(Pt.X + Radius);
+    const int32 Y0 = CellY(Pt.Y - Radius), Y1 = CellY(Pt.Y + Radius);
+    const float R2 = Radius * Radius;
+
+    int32 Added = 0;
+    for (int32 Y = Y0; Y <= Y1; ++Y)
+    {
+        for (int32 X = X0; X <= X1; ++X)
+        {
+            const int32 B = Bucket(TeamID, X, Y);
+            for (int32 k = CellStart[B]; k < CellStart[B + 1]; ++k)
+            {
+                const int32 i = Items[k];
+                if (i == SkipIdx) continue;
+                const float DX = Snap->PosX[i] - Pt.X;
+                const float DY = Snap->PosY[i] - Pt.Y;
+                if (DX * DX + DY * DY < R2) { Out.Add(i); ++Added; }
+            }
+        }
+    }
+    return Added;
+}
@@ -1,7 +1,9 @@
 #include "TeamGameState.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
 #include "Ballsack.h"
+#include "MatchRegistrySubsystem.h"
 
 ATeamGameState::ATeamGameState()
 {
@@ -13,24 +15,16 @@ void ATeamGameState::BeginPlay()
     Super::BeginPlay();
 }
 
-static ABallsack* FindBall(UWorld* W, TSubclassOf<AActor> BallClass)
+static ABallsack* FindBall(const UObject* WorldContext)
 {
-    if (!W) return nullptr;
-
-    // If BallClass isn't set in BP, try to auto-load your BP_Ball
-    if (!*BallClass)
-    {
-        BallClass = StaticLoadClass(AActor::StaticClass(), nullptr, TEXT("/Game/BP_Ball.BP_Ball_C"));
-    }
-
-    AActor* Found = UGameplayStatics::GetActorOfClass(W, BallClass);
-    return Cast<ABallsack>(Found);
+    const UMatchRegistrySubsystem* Registry = UMatchRegistrySubsystem::Get(WorldContext);
+    return Registry ? Registry->GetBall() : nullptr;
 }
 
 void ATeamGameState::ResetBallToCentre()
 {
     UWorld* W = GetWorld();
-    if (ABallsack* Ball = FindBall(W, BallClass))
+    if (ABallsack* Ball = FindBall(W))
     {
         const FVector Centre(0.f, 0.f, 105.f);
         Ball->SetActorLocation(Centre, false, nullptr, ETeleportType::TeleportPhysics);
@@ -38,17 +32,30 @@ void ATeamGameState::ResetBallToCentre()
     }
 }
 
+void ATeamGameState::HandleRestart(int32 AwardedTeamID, FVector Location)
+{
+    if (ABallsack* Ball = FindBall(GetWorld()))
+    {
+        Ball->SetActorLocation(Location, false, nullptr, ETeleportType::ResetPhysics);
+        if (UPrimitiveComponent* Body = Cast<UPrimitiveComponent>(Ball->GetRootComponent()))
+        {
+            Body->SetPhysicsLinearVelocity(FVector::ZeroVector);
+            Body->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+        }
+    }
+    PossessingTeamID = AwardedTeamID;
+}
+
 void ATeamGameState::HandleGoal(int32 ScoringTeamID, bool bRightGoal)
 {
-    // You can extend this with score tracking per team if you already have it.
+    if (ScoringTeamID == 0 || ScoringTeamID == 1) Score[ScoringTeamID]++;
     ResetBallToCentre();
     PossessingTeamID = -1;
 }
 
 FVector ATeamGameState::GetBallLocationSafe(const UObject* WorldContext)
 {
-    UWorld* W = WorldContext ? WorldContext->GetWorld() : nullptr;
-    if (ABallsack* Ball = FindBall(W, TSubclassOf<AActor>()))
+    if (ABallsack* Ball = FindBall(WorldContext))
     {
         return Ball->GetActorLocation();
     }
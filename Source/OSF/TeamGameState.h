@@ -15,14 +15,14 @@ class OSF_API ATeamGameState : public AGameStateBase
 public:
     ATeamGameState();
 
-    // Ball class (BP_Ball) – if not set, we’ll try to load /Game/BP_Ball.BP_Ball_C
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ball")
-    TSubclassOf<AActor> BallClass;
-
     // Which team currently has the ball; -1 = none
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Possession")
     int32 PossessingTeamID = -1;
 
+    // Goals per team (index = TeamID)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Goals")
+    int32 Score[2] = { 0, 0 };
+
     // Reset ball to centre spot and clear possession
     UFUNCTION(BlueprintCallable, Category = "Ball")
     void ResetBallToCentre();
@@ -31,6 +31,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Goals")
     void HandleGoal(int32 ScoringTeamID, bool bRightGoal);
 
+    // Throw-in, corner or goal kick: dead ball at Location, awarded to AwardedTeamID (-1 = nobody)
+    UFUNCTION(BlueprintCallable, Category = "Ball")
+    void HandleRestart(int32 AwardedTeamID, FVector Location);
+
     // Safe getter for ball location (usable from anywhere)
     UFUNCTION(BlueprintCallable, Category = "Ball")
     static FVector GetBallLocationSafe(const UObject* WorldContext);
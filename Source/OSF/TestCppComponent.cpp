@@ -4,7 +4,7 @@
 
 UTestCppComponent::UTestCppComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 void UTestCppComponent::BeginPlay()
@@ -12,11 +12,6 @@ void UTestCppComponent::BeginPlay()
 	Super::BeginPlay();
 }
 
-void UTestCppComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-}
-
 void UTestCppComponent::MoveAlongSpiralPath(ACharacter* Character, AActor* Target, FVector DesiredEndDirection, float DeltaTime)
 {
 	if (!Character || !Target) return;
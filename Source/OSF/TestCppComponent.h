@@ -18,8 +18,6 @@ public:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 	
-	// Called every frame
-	virtual void TickComponent( float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction ) override;
 
 	UFUNCTION(BlueprintCallable, Category = Custom)
     void MoveAlongSpiralPath(ACharacter *character, AActor *target, FVector desiredEndDirection, float deltaSeconds);